@@ -0,0 +1,219 @@
+#include "graph.hpp"
+#include "approx.hpp"
+#include "kruskal.hpp"
+#include <cmath>
+#include <queue>
+#include <random>
+#include <vector>
+#include <numeric>
+#include <functional>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * Estimates the weight of the minimum spanning forest, in the style of Chazelle, Rubinfeld and Trevisan
+ *
+ * With `c(t)` the number of components of the graph that only keeps the edges of weight at most `t`, and `a` a
+ * lower bound on the weights, the forest weighs `(n - k) a + ∫ (c(t) - k) dt` over `t >= a`, where `k` is the
+ * number of components of the whole graph. `c(t)` is the sum of `1 / |C_t(v)|` over the vertices, which is
+ * estimated from a sample of vertices.
+ *
+ * Instead of one BFS per threshold, each sampled vertex grows a Prim tree. Prim visits the vertices in order of
+ * their bottleneck distance, so the tree after `k` steps is exactly the component of every threshold between
+ * the largest key so far and the next key, and one search gives `|C_t(v)|` for every `t` at once. A search
+ * stops after `sizeCap` vertices, larger components count as 0, which is the truncation of the original.
+ *
+ * With `r` samples of cap `S`, the cost is O(r S d log(S d)) for average degree d, independent of the graph
+ * size. Every vertex is used when there are fewer than `r`, and then the result is exact if no component has
+ * more than `S` vertices.
+ *
+ * @param graph The graph to estimate
+ * @param epsilon The target relative error, the samples grow with 1 / epsilon^2 and the cap with 1 / epsilon
+ * @param seed The seed of the vertex sampling
+ * @return The estimate
+ */
+MSTEstimate estimate_mst_weight(const Graph &graph, double epsilon, unsigned seed)
+{
+    MSTEstimate estimate;
+    int n = graph.vertNumber();
+    if (n == 0)
+    {
+        return estimate;
+    }
+    epsilon = max(epsilon, 1e-3);
+    estimate.samples = static_cast<int>(min<double>(n, ceil(4 / (epsilon * epsilon))));
+    estimate.sizeCap = static_cast<int>(ceil(4 / epsilon));
+
+    vector<int> sample(estimate.samples);
+    if (estimate.samples == n)
+    {
+        iota(sample.begin(), sample.end(), 0);
+    }
+    else
+    {
+        mt19937 random(seed);
+        uniform_int_distribution<int> vertex(0, n - 1);
+        for (int &v : sample)
+        {
+            v = vertex(random);
+        }
+    }
+
+    // Each search changes its 1 / |C_t(v)| at a few thresholds, these are the changes of all of them
+    vector<pair<double, double>> changes;
+    vector<int> visited(n, -1);
+    using Entry = pair<int, int>;
+    for (int s = 0; s < estimate.samples; s++)
+    {
+        priority_queue<Entry, vector<Entry>, greater<Entry>> frontier;
+        int start = sample[s];
+        visited[start] = s;
+        int size = 1;
+        double largest = -INFINITY;
+        auto expand = [&](int u)
+        {
+            for (const auto &[dest, weight] : graph.adjList[u])
+            {
+                estimate.edgesScanned++;
+                if (visited[dest] != s)
+                {
+                    frontier.push({weight, dest});
+                }
+            }
+        };
+        expand(start);
+
+        while (true)
+        {
+            while (!frontier.empty() && visited[frontier.top().second] == s)
+            {
+                frontier.pop();
+            }
+            if (frontier.empty())
+            {
+                // The whole component is known, its size stays the same for every larger threshold
+                break;
+            }
+            auto [weight, v] = frontier.top();
+            if (size == estimate.sizeCap)
+            {
+                // Past the next key the component is bigger than the cap, so it counts as 0
+                changes.emplace_back(max<double>(largest, weight), -1.0 / size);
+                break;
+            }
+            frontier.pop();
+            visited[v] = s;
+            largest = max<double>(largest, weight);
+            changes.emplace_back(largest, 1.0 / (size + 1) - 1.0 / size);
+            size++;
+            expand(v);
+        }
+    }
+
+    if (changes.empty())
+    {
+        // No edges at all, every vertex is its own component
+        estimate.components = n;
+        return estimate;
+    }
+    sort(changes.begin(), changes.end());
+
+    // c(t) is n below the lightest edge, the scale turns the sum over the samples into a sum over every vertex
+    double scale = static_cast<double>(n) / estimate.samples;
+    double lowest = changes.front().first;
+    double sum = estimate.samples;
+    vector<pair<double, double>> steps;
+    for (size_t i = 0; i < changes.size();)
+    {
+        double t = changes[i].first;
+        while (i < changes.size() && changes[i].first == t)
+        {
+            sum += changes[i++].second;
+        }
+        steps.emplace_back(t, sum * scale);
+    }
+
+    // There is always at least one component, so the estimate never goes below that
+    double components = max(1.0, steps.back().second);
+    double weight = (n - components) * lowest;
+    for (size_t i = 0; i + 1 < steps.size(); i++)
+    {
+        weight += max(0.0, steps[i].second - components) * (steps[i + 1].first - steps[i].first);
+    }
+    estimate.components = components;
+    estimate.weight = weight;
+    return estimate;
+}
+
+/**
+ * Kruskal's Algorithm on weights rounded up to powers of `1 + epsilon`
+ *
+ * The rounded weights only take O(log(W) / epsilon) values, so the edges are sorted with a counting sort
+ * instead of a comparison sort. The tree is minimal for the rounded weights, which are at most `1 + epsilon`
+ * times the real ones, so it weighs at most `1 + epsilon` times the minimum spanning tree. Weights below 1 are
+ * sorted exactly, ahead of the buckets.
+ *
+ * @param graph The graph to perform the algorithm on
+ * @param epsilon The relative error allowed
+ * @return A `MST` object with a spanning tree within `1 + epsilon` of the minimum, with the real weights
+ */
+MST approx_mst_buckets(Graph &graph, double epsilon)
+{
+    MST mst;
+    EdgeList edges(graph);
+    UnionFind unionFind(graph.vertNumber());
+    double base = log1p(max(epsilon, 1e-6));
+
+    vector<Graph::Edge> small;
+    vector<int> bucketOf(edges.list.size(), -1);
+    int buckets = 0;
+    for (size_t i = 0; i < edges.list.size(); i++)
+    {
+        int weight = edges.list[i].weight;
+        if (weight < 1)
+        {
+            small.push_back(edges.list[i]);
+            continue;
+        }
+        // The bucket of w is the smallest j with w <= (1 + epsilon)^j
+        bucketOf[i] = static_cast<int>(ceil(log(weight) / base - 1e-9));
+        buckets = max(buckets, bucketOf[i] + 1);
+    }
+    sort(small.begin(), small.end(), [](const Graph::Edge &a, const Graph::Edge &b)
+         { return a.weight < b.weight; });
+
+    // Counting sort into the buckets
+    vector<int> start(buckets + 1, 0);
+    for (int b : bucketOf)
+    {
+        if (b != -1)
+        {
+            start[b + 1]++;
+        }
+    }
+    for (int b = 0; b < buckets; b++)
+    {
+        start[b + 1] += start[b];
+    }
+    vector<Graph::Edge> sorted(small);
+    sorted.resize(small.size() + start[buckets], Graph::Edge(0, 0, 0));
+    for (size_t i = 0; i < edges.list.size(); i++)
+    {
+        if (bucketOf[i] != -1)
+        {
+            sorted[small.size() + start[bucketOf[i]]++] = edges.list[i];
+        }
+    }
+
+    for (const auto &edge : sorted)
+    {
+        if (unionFind.find(edge.src) != unionFind.find(edge.dest))
+        {
+            unionFind.merge(edge.src, edge.dest);
+            mst.edges.push_back(edge);
+            mst.totalWeight += edge.weight;
+        }
+    }
+    return mst;
+}
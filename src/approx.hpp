@@ -0,0 +1,30 @@
+#ifndef APPROX_HPP
+#define APPROX_HPP
+
+#include "graph.hpp"
+
+/**
+ * @brief An estimate of the weight of the minimum spanning forest, and what it cost.
+ */
+struct MSTEstimate
+{
+    double weight = 0;          /**< The estimated total weight. */
+    double components = 0;      /**< The estimated number of connected components. */
+    int samples = 0;            /**< The number of vertices the search started from. */
+    int sizeCap = 0;            /**< The largest component a single search explores. */
+    long long edgesScanned = 0; /**< The number of adjacency entries looked at. */
+};
+
+/**
+ * Estimates the weight of the minimum spanning forest without computing it.
+ *
+ * @param graph The graph to estimate
+ * @param epsilon The target relative error, smaller is more accurate and slower
+ * @param seed The seed of the vertex sampling
+ * @return The estimate
+ */
+MSTEstimate estimate_mst_weight(const Graph &graph, double epsilon, unsigned seed = 1);
+
+MST approx_mst_buckets(Graph &graph, double epsilon);
+
+#endif
@@ -0,0 +1,84 @@
+#include "graph.hpp"
+#include "boruvka.hpp"
+#include "kruskal.hpp"
+#include <vector>
+
+using namespace std;
+
+/**
+ * Implementation of Borůvka's Algorithm
+ *
+ * Each round finds the lightest edge leaving every component, and merges the components along those edges with
+ * a `UnionFind`. The same scan compacts the edge array, dropping the edges that are already inside a component,
+ * so later rounds scan less data. Every round at least halves the number of components.
+ *
+ * @param graph The graph to perform the algorithm on
+ * @return A `MST` object with the minimum spanning tree of the graph
+ */
+MST boruvka_mst(Graph &graph)
+{
+    // Declare the MST
+    MST mst;
+    // Borůvka's algorithm only needs the edge list
+    EdgeList edges(graph);
+    UnionFind unionFind(graph.vertNumber());
+
+    // The index of the lightest edge leaving each component, stored at the component's root
+    vector<int> cheapest(graph.vertNumber(), -1);
+    vector<Graph::Edge> &list = edges.list;
+
+    // Ties are broken by position, the compaction keeps the order so every round agrees on it
+    auto lighter = [&](int a, int b)
+    {
+        return list[a].weight < list[b].weight || (list[a].weight == list[b].weight && a < b);
+    };
+
+    bool merged = true;
+    while (merged && !list.empty())
+    {
+        merged = false;
+        size_t kept = 0;
+        for (size_t i = 0; i < list.size(); i++)
+        {
+            int a = unionFind.find(list[i].src);
+            int b = unionFind.find(list[i].dest);
+            if (a == b)
+            {
+                // Already inside a component, it can never be used again
+                continue;
+            }
+            list[kept] = list[i];
+            int index = kept++;
+            if (cheapest[a] == -1 || lighter(index, cheapest[a]))
+            {
+                cheapest[a] = index;
+            }
+            if (cheapest[b] == -1 || lighter(index, cheapest[b]))
+            {
+                cheapest[b] = index;
+            }
+        }
+        list.erase(list.begin() + kept, list.end());
+
+        // Merge every component along its lightest edge
+        for (size_t v = 0; v < cheapest.size(); v++)
+        {
+            if (cheapest[v] == -1)
+            {
+                continue;
+            }
+            const Graph::Edge &edge = list[cheapest[v]];
+            cheapest[v] = -1;
+            if (unionFind.find(edge.src) != unionFind.find(edge.dest))
+            {
+                unionFind.merge(edge.src, edge.dest);
+                mst.edges.push_back(edge);
+                mst.totalWeight += edge.weight;
+                merged = true;
+            }
+        }
+    }
+
+    // Return our MST
+    return mst;
+}
@@ -0,0 +1,8 @@
+#ifndef BORUVKA_HPP
+#define BORUVKA_HPP
+
+#include "graph.hpp"
+
+MST boruvka_mst(Graph &graph);
+
+#endif
@@ -0,0 +1,106 @@
+#include "graph.hpp"
+#include "boruvka_tree.hpp"
+#include "kruskal.hpp"
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+using namespace std;
+
+BoruvkaTree::BoruvkaTree(int vertices, const vector<Graph::Edge> &forest)
+    : verts(vertices), parent(vertices, -1), weight(vertices, 0)
+{
+    // The edges between the current components, and the node of each component
+    vector<Graph::Edge> edges = forest;
+    vector<int> node(vertices);
+    iota(node.begin(), node.end(), 0);
+    int count = vertices;
+    vector<int> cheapest, label;
+    while (!edges.empty())
+    {
+        cheapest.assign(count, -1);
+        for (int i = 0; i < static_cast<int>(edges.size()); i++)
+        {
+            for (int end : {edges[i].src, edges[i].dest})
+            {
+                if (cheapest[end] == -1 || edges[i].weight < edges[cheapest[end]].weight)
+                {
+                    cheapest[end] = i;
+                }
+            }
+        }
+
+        // The picked edges of a forest can't close a cycle, whatever the ties
+        UnionFind components(count);
+        for (int c = 0; c < count; c++)
+        {
+            if (cheapest[c] != -1)
+            {
+                components.merge(edges[cheapest[c]].src, edges[cheapest[c]].dest);
+            }
+        }
+
+        // A component without edges is the root of a finished tree, and is not carried on
+        label.assign(count, -1);
+        vector<int> nextNode;
+        for (int c = 0; c < count; c++)
+        {
+            if (cheapest[c] == -1)
+            {
+                continue;
+            }
+            int top = components.find(c);
+            if (label[top] == -1)
+            {
+                label[top] = nextNode.size();
+                nextNode.push_back(parent.size());
+                parent.push_back(-1);
+                weight.push_back(0);
+            }
+            parent[node[c]] = nextNode[label[top]];
+            weight[node[c]] = edges[cheapest[c]].weight;
+        }
+
+        int kept = 0;
+        for (const auto &edge : edges)
+        {
+            int u = label[components.find(edge.src)];
+            int v = label[components.find(edge.dest)];
+            if (u != v)
+            {
+                edges[kept++] = Graph::Edge(u, v, edge.weight);
+            }
+        }
+        edges.erase(edges.begin() + kept, edges.end());
+        count = nextNode.size();
+        node.swap(nextNode);
+    }
+
+    // Parents come after their children, so walking down the numbers is walking down the tree
+    vector<int> top(parent.size());
+    for (int x = static_cast<int>(parent.size()) - 1; x >= 0; x--)
+    {
+        top[x] = parent[x] == -1 ? x : top[parent[x]];
+    }
+    root.assign(top.begin(), top.begin() + vertices);
+}
+
+int BoruvkaTree::pathMax(int u, int v) const
+{
+    if (u < 0 || v < 0 || u >= verts || v >= verts || root[u] != root[v])
+    {
+        return NO_PATH;
+    }
+    if (u == v)
+    {
+        return NO_EDGE;
+    }
+    int heaviest = NO_EDGE;
+    while (u != v)
+    {
+        heaviest = max(heaviest, max(weight[u], weight[v]));
+        u = parent[u];
+        v = parent[v];
+    }
+    return heaviest;
+}
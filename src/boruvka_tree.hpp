@@ -0,0 +1,59 @@
+#ifndef BORUVKA_TREE_HPP
+#define BORUVKA_TREE_HPP
+
+#include "graph.hpp"
+#include <vector>
+#include <climits>
+
+/**
+ * @brief The Borůvka tree of a forest, after King, for the heaviest edge on the path between two vertices.
+ *
+ * The leaves are the vertices of the forest, and every Borůvka phase adds one node per component it forms, as the
+ * parent of the components that went into it, through an edge as heavy as the edge the child picked. The heaviest
+ * edge between two leaves is then the heaviest edge on the forest path between the two vertices. Each phase at
+ * least halves the components, so the tree is at most log2(V) high, and the leaves of each of its trees are all at
+ * the same depth, so a query climbs from both ends together until they meet.
+ *
+ * Nodes are numbered in the order they are made, so the few nodes of the top levels sit together and stay in
+ * cache. That makes a query a handful of memory reads, even though it is O(log V) at worst.
+ */
+class BoruvkaTree
+{
+public:
+    // The answer for a vertex and itself, since the path has no edge
+    static constexpr int NO_EDGE = INT_MIN;
+    // The answer for two vertices in different trees, or out of range
+    static constexpr int NO_PATH = INT_MAX;
+
+private:
+    int verts;
+    // -1 at a root
+    std::vector<int> parent;
+    // The weight of the edge up to the parent
+    std::vector<int> weight;
+    // The root of the tree of every vertex
+    std::vector<int> root;
+
+public:
+    /**
+     * @param vertices The number of vertices
+     * @param forest The edges of a forest over the vertices, with no cycle
+     */
+    BoruvkaTree(int vertices, const std::vector<Graph::Edge> &forest);
+
+    /**
+     * @return The heaviest edge weight on the forest path between `u` and `v`, `NO_EDGE` if they are the same
+     * vertex, or `NO_PATH` if they are not connected.
+     */
+    int pathMax(int u, int v) const;
+
+    /**
+     * @return True if `u` and `v` are in the same tree of the forest.
+     */
+    bool connected(int u, int v) const
+    {
+        return root[u] == root[v];
+    }
+};
+
+#endif
@@ -0,0 +1,141 @@
+#include "graph.hpp"
+#include "bottleneck.hpp"
+#include "rooted_tree.hpp"
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+
+using namespace std;
+
+PathMaxIndex::PathMaxIndex(int vertices, const MST &tree, ThreadPool &pool)
+    : verts(vertices), position(vertices), places(vertices)
+{
+    RootedTree rooted = rootTree(vertices, tree, 0, false);
+
+    // The heavy child is the one with the largest subtree
+    vector<int> heavy(vertices, -1);
+    for (int x = 0; x < vertices; x++)
+    {
+        for (int k = rooted.childStart[x]; k < rooted.childStart[x + 1]; k++)
+        {
+            int y = rooted.children[k];
+            if (heavy[x] == -1 || rooted.subtreeSize[y] > rooted.subtreeSize[heavy[x]])
+            {
+                heavy[x] = y;
+            }
+        }
+    }
+
+    // Every chain is laid out from its head down, and the light children start chains of their own
+    vector<int> base(vertices);
+    vector<int> heads;
+    int next = 0;
+    for (int start : rooted.roots)
+    {
+        heads.assign(1, start);
+        while (!heads.empty())
+        {
+            int chain = heads.back();
+            heads.pop_back();
+            int top = next;
+            int above = rooted.parent[chain] == -1 ? -1 : position[rooted.parent[chain]];
+            for (int x = chain; x != -1; x = heavy[x])
+            {
+                position[x] = next;
+                places[next] = {top, above, rooted.depth[chain], rooted.treeRoot[x]};
+                base[next++] = rooted.parent[x] == -1 ? NO_EDGE : rooted.parentWeight[x];
+                for (int k = rooted.childStart[x]; k < rooted.childStart[x + 1]; k++)
+                {
+                    if (rooted.children[k] != heavy[x])
+                    {
+                        heads.push_back(rooted.children[k]);
+                    }
+                }
+            }
+        }
+    }
+
+    sparse.push_back(move(base));
+    for (int k = 1; (1 << k) <= vertices; k++)
+    {
+        const vector<int> &below = sparse[k - 1];
+        vector<int> level(vertices - (1 << k) + 1);
+        pool.parallelFor(0, level.size(), [&](int i)
+                         { level[i] = max(below[i], below[i + (1 << (k - 1))]); },
+                         4096);
+        sparse.push_back(move(level));
+    }
+}
+
+/**
+ * @return The heaviest parent edge of the places `first` to `last`, both included.
+ */
+int PathMaxIndex::rangeMax(int first, int last) const
+{
+    int k = 31 - __builtin_clz(last - first + 1);
+    return max(sparse[k][first], sparse[k][last - (1 << k) + 1]);
+}
+
+int PathMaxIndex::query(int u, int v) const
+{
+    if (u < 0 || v < 0 || u >= verts || v >= verts)
+    {
+        return NO_PATH;
+    }
+    int a = position[u], b = position[v];
+    if (places[a].tree != places[b].tree)
+    {
+        return NO_PATH;
+    }
+    int heaviest = NO_EDGE;
+    // Climb from the chain whose top is deeper until both are on one chain
+    while (places[a].top != places[b].top)
+    {
+        if (places[a].topDepth < places[b].topDepth)
+        {
+            swap(a, b);
+        }
+        heaviest = max(heaviest, rangeMax(places[a].top, a));
+        a = places[a].above;
+    }
+    if (a == b)
+    {
+        return heaviest;
+    }
+    // Down a chain the places grow, and the parent edge of the upper vertex is not on the path
+    return max(heaviest, rangeMax(min(a, b) + 1, max(a, b)));
+}
+
+vector<int> PathMaxIndex::queryBatch(const vector<pair<int, int>> &queries, ThreadPool &pool) const
+{
+    vector<int> answers(queries.size());
+    pool.parallelFor(0, queries.size(), [&](int i)
+                     { answers[i] = query(queries[i].first, queries[i].second); },
+                     4096);
+    return answers;
+}
+
+vector<pair<int, int>> loadQueries(const string &file)
+{
+    vector<pair<int, int>> queries;
+    ifstream inputFile(file);
+    if (!inputFile)
+    {
+        cerr << "Error loading query file.";
+        return queries;
+    }
+    string line;
+    while (getline(inputFile, line))
+    {
+        istringstream fields(line);
+        int u, v;
+        if (fields >> u >> v)
+        {
+            queries.emplace_back(u, v);
+        }
+    }
+    return queries;
+}
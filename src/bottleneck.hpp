@@ -0,0 +1,89 @@
+#ifndef BOTTLENECK_HPP
+#define BOTTLENECK_HPP
+
+#include "graph.hpp"
+#include "thread_pool.hpp"
+#include <string>
+#include <vector>
+#include <climits>
+#include <utility>
+
+/**
+ * @brief Answers the heaviest edge on the tree path between two vertices of a minimum spanning forest.
+ *
+ * That weight is the bottleneck, or minimax, distance of the two vertices in the graph: the smallest possible
+ * weight of the heaviest edge over every path between them. The index uses a heavy-light decomposition: every
+ * vertex continues the chain of its parent if it has the largest subtree among its siblings, the chains are laid
+ * out one after another, and a sparse table over the weights of the parent edges in that order gives the maximum
+ * of any part of a chain in O(1). A path crosses O(log V) chains, and usually only a few. Building takes
+ * O(V log V), and the index is read only, so queries can run on many threads at once.
+ */
+class PathMaxIndex
+{
+public:
+    // The answer for a vertex and itself, since the path has no edge
+    static constexpr int NO_EDGE = INT_MIN;
+    // The answer for two vertices in different trees, or out of range
+    static constexpr int NO_PATH = INT_MAX;
+
+private:
+    /**
+     * @brief What a query needs of a vertex, stored at its place in the chain order.
+     */
+    struct Place
+    {
+        int top;      // The place of the first vertex of the chain
+        int above;    // The place of the parent of that vertex, or -1 at a root
+        int topDepth; // The depth of that vertex
+        int tree;     // The root of the tree
+    };
+    int verts;
+    // The place of every vertex in the chain order, where every chain is contiguous and starts at the top
+    std::vector<int> position;
+    std::vector<Place> places;
+    // Level `k` holds the heaviest parent edge of the `2^k` places from every place
+    std::vector<std::vector<int>> sparse;
+
+    int rangeMax(int first, int last) const;
+
+public:
+    /**
+     * @param vertices The number of vertices
+     * @param tree A spanning forest of the vertices
+     * @param pool The pool the jump tables are filled on
+     */
+    PathMaxIndex(int vertices, const MST &tree, ThreadPool &pool = sharedPool());
+
+    /**
+     * @return The heaviest edge weight on the tree path between `u` and `v`, `NO_EDGE` if they are the same
+     * vertex, or `NO_PATH` if they are not connected.
+     */
+    int query(int u, int v) const;
+
+    /**
+     * Answers many queries on the pool.
+     *
+     * @param queries The pairs of vertices
+     * @param pool The pool to run on
+     * @return The answer of every query, in order
+     */
+    std::vector<int> queryBatch(const std::vector<std::pair<int, int>> &queries, ThreadPool &pool = sharedPool()) const;
+
+    /**
+     * @return The number of vertices.
+     */
+    int vertNumber() const
+    {
+        return verts;
+    }
+};
+
+/**
+ * Loads queries, one `u v` pair per line.
+ *
+ * @param file The path to the file
+ * @return The pairs in order, the lines that can not be read are skipped
+ */
+std::vector<std::pair<int, int>> loadQueries(const std::string &file);
+
+#endif
@@ -0,0 +1,217 @@
+#include "graph.hpp"
+#include "delta.hpp"
+#include "kruskal.hpp"
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <unordered_map>
+
+using namespace std;
+
+namespace
+{
+    bool lighter(const Graph::Edge &a, const Graph::Edge &b)
+    {
+        return a.weight < b.weight;
+    }
+
+    /**
+     * Kruskal's algorithm on edges already sorted by weight
+     */
+    MST sortedKruskal(int verts, const vector<Graph::Edge> &edges)
+    {
+        MST tree;
+        UnionFind unionFind(verts);
+        for (const auto &edge : edges)
+        {
+            if (unionFind.find(edge.src) != unionFind.find(edge.dest))
+            {
+                unionFind.merge(edge.src, edge.dest);
+                tree.edges.push_back(edge);
+                tree.totalWeight += edge.weight;
+            }
+        }
+        return tree;
+    }
+}
+
+/**
+ * Applies a change set to a graph, and brings its minimum spanning forest up to date without looking at most of
+ * the graph.
+ *
+ * The deletions go first. A tree edge that is deleted splits the old forest into pieces, and the old tree edges
+ * left are still in the forest of the graph without the deleted edges, so only the edges between two pieces need
+ * Kruskal's algorithm. Each of them has an end outside the largest piece, so only the neighbors of the other
+ * pieces are scanned. The insertions then only need that forest, since the minimum spanning forest of a tree
+ * plus some edges is the minimum spanning forest of the graph plus those edges. A reweight is a deletion and an
+ * insertion.
+ *
+ * @param graph The graph, which gets the changes
+ * @param tree The minimum spanning forest of the graph before the changes, cheapest when sorted by weight
+ * @param delta The changes, a deletion removes the last inserted edge between its endpoints
+ * @param stats If not null, receives the counts of what was done
+ * @return The minimum spanning forest of the changed graph, sorted by weight
+ */
+MST apply_delta(Graph &graph, const MST &tree, const vector<EdgeUpdate> &delta, DeltaStats *stats)
+{
+    int verts = graph.vertNumber();
+    DeltaStats counts;
+    // Only the tree edges a deletion could name are indexed
+    unordered_map<uint64_t, vector<int>> treeIndex;
+    for (const auto &update : delta)
+    {
+        if (!update.insert)
+        {
+            treeIndex[endpointKey(update.u, update.v)];
+        }
+    }
+    for (size_t i = 0; !treeIndex.empty() && i < tree.edges.size(); i++)
+    {
+        auto named = treeIndex.find(endpointKey(tree.edges[i].src, tree.edges[i].dest));
+        if (named != treeIndex.end())
+        {
+            named->second.push_back(i);
+        }
+    }
+
+    // The insertions wait until the deletions are done, so the scan below only sees the old edges
+    vector<bool> cut(tree.edges.size(), false);
+    vector<Graph::Edge> added;
+    for (const auto &update : delta)
+    {
+        int u = update.u, v = update.v;
+        if (u < 0 || v < 0 || u >= verts || v >= verts || u == v)
+        {
+            counts.ignored++;
+            continue;
+        }
+        if (update.insert)
+        {
+            added.emplace_back(u, v, update.weight);
+            counts.inserted++;
+            continue;
+        }
+
+        auto pending = find_if(added.rbegin(), added.rend(), [u, v](const Graph::Edge &edge)
+                               { return endpointKey(edge.src, edge.dest) == endpointKey(u, v); });
+        if (pending != added.rend())
+        {
+            added.erase(next(pending).base());
+            counts.deleted++;
+            continue;
+        }
+        // The last entry for an edge is the one inserted last, on both sides
+        auto &fromU = graph.adjList[u];
+        auto entry = find_if(fromU.rbegin(), fromU.rend(), [v](const pair<int, int> &neighbor)
+                             { return neighbor.first == v; });
+        if (entry == fromU.rend())
+        {
+            counts.ignored++;
+            continue;
+        }
+        int w = entry->second;
+        fromU.erase(next(entry).base());
+        auto &fromV = graph.adjList[v];
+        fromV.erase(next(find(fromV.rbegin(), fromV.rend(), make_pair(u, w))).base());
+        counts.deleted++;
+
+        for (int i : treeIndex[endpointKey(u, v)])
+        {
+            if (!cut[i] && tree.edges[i].weight == w)
+            {
+                cut[i] = true;
+                counts.cutEdges++;
+                break;
+            }
+        }
+    }
+
+    vector<Graph::Edge> forest;
+    forest.reserve(tree.edges.size());
+    for (size_t i = 0; i < tree.edges.size(); i++)
+    {
+        if (!cut[i])
+        {
+            forest.push_back(tree.edges[i]);
+        }
+    }
+    if (!is_sorted(forest.begin(), forest.end(), lighter))
+    {
+        stable_sort(forest.begin(), forest.end(), lighter);
+    }
+
+    if (counts.cutEdges > 0)
+    {
+        UnionFind pieces(verts);
+        for (const auto &edge : forest)
+        {
+            pieces.merge(edge.src, edge.dest);
+        }
+        vector<int> piece(verts), size(verts, 0);
+        for (int x = 0; x < verts; x++)
+        {
+            piece[x] = pieces.find(x);
+            size[piece[x]]++;
+        }
+        int largest = max_element(size.begin(), size.end()) - size.begin();
+        vector<Graph::Edge> crossing;
+        for (int x = 0; x < verts; x++)
+        {
+            if (piece[x] == largest)
+            {
+                continue;
+            }
+            for (const auto &[y, w] : graph.adjList[x])
+            {
+                // An edge between two small pieces is seen from both ends, and kept from the lower one
+                if (piece[y] != piece[x] && (piece[y] == largest || x < y))
+                {
+                    crossing.emplace_back(x, y, w);
+                }
+            }
+        }
+        counts.candidates += crossing.size();
+        sort(crossing.begin(), crossing.end(), lighter);
+
+        // Kruskal's algorithm goes on from the pieces
+        vector<Graph::Edge> joins;
+        for (const auto &edge : crossing)
+        {
+            if (pieces.find(edge.src) != pieces.find(edge.dest))
+            {
+                pieces.merge(edge.src, edge.dest);
+                joins.push_back(edge);
+            }
+        }
+        vector<Graph::Edge> rejoined;
+        rejoined.reserve(forest.size() + joins.size());
+        merge(forest.begin(), forest.end(), joins.begin(), joins.end(), back_inserter(rejoined), lighter);
+        forest.swap(rejoined);
+    }
+
+    for (const auto &edge : added)
+    {
+        graph.addEdge(edge.src, edge.dest, edge.weight);
+    }
+    counts.candidates += added.size();
+    if (stats != nullptr)
+    {
+        *stats = counts;
+    }
+
+    if (added.empty())
+    {
+        MST updated;
+        updated.edges = move(forest);
+        for (const auto &edge : updated.edges)
+        {
+            updated.totalWeight += edge.weight;
+        }
+        return updated;
+    }
+    stable_sort(added.begin(), added.end(), lighter);
+    vector<Graph::Edge> edges;
+    edges.reserve(forest.size() + added.size());
+    merge(forest.begin(), forest.end(), added.begin(), added.end(), back_inserter(edges), lighter);
+    return sortedKruskal(verts, edges);
+}
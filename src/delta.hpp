@@ -0,0 +1,21 @@
+#ifndef DELTA_HPP
+#define DELTA_HPP
+
+#include "graph.hpp"
+#include <vector>
+
+/**
+ * @brief What applying a change set took.
+ */
+struct DeltaStats
+{
+    int inserted = 0;   /**< The edges added to the graph. */
+    int deleted = 0;    /**< The edges removed from the graph. */
+    int ignored = 0;    /**< The deletions of edges the graph did not have, and the updates out of range. */
+    int cutEdges = 0;   /**< The tree edges that left with a deletion. */
+    int candidates = 0; /**< The edges Kruskal's algorithm looked at besides the remaining tree edges. */
+};
+
+MST apply_delta(Graph &graph, const MST &tree, const std::vector<EdgeUpdate> &delta, DeltaStats *stats = nullptr);
+
+#endif
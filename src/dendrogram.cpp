@@ -0,0 +1,182 @@
+#include "graph.hpp"
+#include "dendrogram.hpp"
+#include "kruskal.hpp"
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * Turns the merges of a union-find into dendrogram merges, with one cluster id per root.
+ */
+class DendrogramBuilder
+{
+private:
+    UnionFind components;
+    // The dendrogram cluster of every union-find root
+    vector<int> clusterOf;
+    vector<int> sizeOf;
+
+public:
+    Dendrogram dendrogram;
+
+    explicit DendrogramBuilder(int verts) : components(verts), clusterOf(verts), sizeOf(verts, 1)
+    {
+        iota(clusterOf.begin(), clusterOf.end(), 0);
+        dendrogram.leaves = verts;
+        dendrogram.merges.reserve(max(0, verts - 1));
+    }
+
+    /**
+     * Joins the clusters of `u` and `v` at `height`, if they are not already one.
+     *
+     * @return True if they were merged
+     */
+    bool join(int u, int v, int height)
+    {
+        int uRoot = components.find(u), vRoot = components.find(v);
+        if (uRoot == vRoot)
+        {
+            return false;
+        }
+        int left = clusterOf[uRoot], right = clusterOf[vRoot];
+        int size = sizeOf[uRoot] + sizeOf[vRoot];
+        components.merge(uRoot, vRoot);
+        int root = components.find(uRoot);
+        clusterOf[root] = dendrogram.leaves + dendrogram.merges.size();
+        sizeOf[root] = size;
+        dendrogram.merges.push_back({min(left, right), max(left, right), height, size});
+        return true;
+    }
+};
+
+/**
+ * Kruskal's Algorithm, recording the single-linkage dendrogram as it merges
+ *
+ * Every union Kruskal makes joins the two closest clusters, so its sequence of unions is the single-linkage
+ * hierarchy. Recording it only takes a cluster id and a size per vertex, on top of the n - 1 merges.
+ *
+ * @param graph The graph to cluster
+ * @param tree If given, receives the minimum spanning forest
+ * @return The dendrogram
+ */
+Dendrogram single_linkage(Graph &graph, MST *tree)
+{
+    EdgeList edges(graph);
+    DendrogramBuilder builder(graph.vertNumber());
+    sort(edges.list.begin(), edges.list.end(), [](const Graph::Edge &a, const Graph::Edge &b)
+         { return a.weight < b.weight; });
+
+    for (const auto &edge : edges.list)
+    {
+        if (builder.join(edge.src, edge.dest, edge.weight))
+        {
+            if (tree)
+            {
+                tree->edges.push_back(edge);
+                tree->totalWeight += edge.weight;
+            }
+            if (builder.dendrogram.components() == 1)
+            {
+                break;
+            }
+        }
+    }
+    return builder.dendrogram;
+}
+
+Dendrogram dendrogramFromTree(int verts, const MST &tree)
+{
+    vector<Graph::Edge> edges = tree.edges;
+    stable_sort(edges.begin(), edges.end(), [](const Graph::Edge &a, const Graph::Edge &b)
+                { return a.weight < b.weight; });
+    DendrogramBuilder builder(verts);
+    for (const auto &edge : edges)
+    {
+        builder.join(edge.src, edge.dest, edge.weight);
+    }
+    return builder.dendrogram;
+}
+
+vector<int> cutAfter(const Dendrogram &dendrogram, int count)
+{
+    int n = dendrogram.leaves;
+    count = max(0, min<int>(count, dendrogram.merges.size()));
+    // A vertex of every cluster, so a merge can be replayed as a union of two vertices
+    vector<int> member(n + count);
+    iota(member.begin(), member.begin() + n, 0);
+    UnionFind components(n);
+    for (int i = 0; i < count; i++)
+    {
+        const Dendrogram::Merge &merge = dendrogram.merges[i];
+        components.merge(member[merge.left], member[merge.right]);
+        member[n + i] = member[merge.left];
+    }
+
+    vector<int> labels(n);
+    vector<int> labelOf(n, -1);
+    int next = 0;
+    for (int v = 0; v < n; v++)
+    {
+        int root = components.find(v);
+        if (labelOf[root] == -1)
+        {
+            labelOf[root] = next++;
+        }
+        labels[v] = labelOf[root];
+    }
+    return labels;
+}
+
+vector<int> cutClusters(const Dendrogram &dendrogram, int k)
+{
+    return cutAfter(dendrogram, dendrogram.leaves - max(1, k));
+}
+
+vector<int> cutThreshold(const Dendrogram &dendrogram, int threshold)
+{
+    // The heights never decrease, so the merges under the threshold are a prefix
+    auto end = upper_bound(dendrogram.merges.begin(), dendrogram.merges.end(), threshold, [](int t, const Dendrogram::Merge &merge)
+                           { return t < merge.height; });
+    return cutAfter(dendrogram, end - dendrogram.merges.begin());
+}
+
+bool writeLinkage(const Dendrogram &dendrogram, const string &path)
+{
+    ofstream output(path, ios::binary);
+    if (!output)
+    {
+        cerr << "Error writing linkage file." << endl;
+        return false;
+    }
+    int32_t counts[2] = {dendrogram.leaves, static_cast<int32_t>(dendrogram.merges.size())};
+    output.write("MSTLINK", 8);
+    output.write(reinterpret_cast<const char *>(counts), sizeof(counts));
+    for (const auto &merge : dendrogram.merges)
+    {
+        double row[4] = {static_cast<double>(merge.left), static_cast<double>(merge.right),
+                         static_cast<double>(merge.height), static_cast<double>(merge.size)};
+        output.write(reinterpret_cast<const char *>(row), sizeof(row));
+    }
+    return static_cast<bool>(output);
+}
+
+bool writeLabels(const vector<int> &labels, const string &path)
+{
+    ofstream output(path, ios::binary);
+    if (!output)
+    {
+        cerr << "Error writing labels file." << endl;
+        return false;
+    }
+    int32_t clusters = labels.empty() ? 0 : *max_element(labels.begin(), labels.end()) + 1;
+    int32_t counts[2] = {static_cast<int32_t>(labels.size()), clusters};
+    output.write("MSTLABEL", 8);
+    output.write(reinterpret_cast<const char *>(counts), sizeof(counts));
+    vector<int32_t> values(labels.begin(), labels.end());
+    output.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(int32_t));
+    return static_cast<bool>(output);
+}
@@ -0,0 +1,86 @@
+#ifndef DENDROGRAM_HPP
+#define DENDROGRAM_HPP
+
+#include "graph.hpp"
+#include <vector>
+#include <string>
+
+/**
+ * @brief The single-linkage merge tree of a graph, in the layout of a SciPy linkage matrix.
+ *
+ * The vertices are the clusters `0` to `leaves - 1`, and merge `i` creates cluster `leaves + i` out of two
+ * earlier clusters. The merges are in the order Kruskal's algorithm makes them, so their heights never decrease.
+ * A disconnected graph has fewer than `leaves - 1` merges.
+ */
+struct Dendrogram
+{
+    /**
+     * @brief One merge, joining two clusters at the weight of the MST edge between them.
+     */
+    struct Merge
+    {
+        int left;   /**< The first cluster joined. */
+        int right;  /**< The second cluster joined. */
+        int height; /**< The weight of the edge that joined them. */
+        int size;   /**< The number of vertices in the new cluster. */
+    };
+
+    int leaves = 0;            /**< The number of vertices. */
+    std::vector<Merge> merges; /**< The merges, lowest first. */
+
+    /**
+     * @return The number of clusters left after every merge, the number of connected components.
+     */
+    int components() const
+    {
+        return leaves - merges.size();
+    }
+};
+
+Dendrogram single_linkage(Graph &graph, MST *tree = nullptr);
+
+/**
+ * Builds the dendrogram from a minimum spanning tree found by any of the engines.
+ *
+ * @param verts The number of vertices of the graph
+ * @param tree A minimum spanning tree or forest of the graph
+ * @return The dendrogram
+ */
+Dendrogram dendrogramFromTree(int verts, const MST &tree);
+
+/**
+ * Labels the vertices with their cluster after the first `count` merges.
+ *
+ * @param dendrogram The dendrogram to cut
+ * @param count The number of merges to apply
+ * @return The cluster of every vertex, numbered from 0 in order of their lowest vertex
+ */
+std::vector<int> cutAfter(const Dendrogram &dendrogram, int count);
+
+/**
+ * @return The labels of the `k` cluster cut, or of every component if the graph has more than `k`.
+ */
+std::vector<int> cutClusters(const Dendrogram &dendrogram, int k);
+
+/**
+ * @return The labels of the clusters joined by the edges of weight at most `threshold`.
+ */
+std::vector<int> cutThreshold(const Dendrogram &dendrogram, int threshold);
+
+/**
+ * Writes the linkage matrix, `MSTLINK` and a zero byte, the leaf and merge counts as int32, then one row of four
+ * float64 per merge: the two clusters, the height and the size. The rows load as a SciPy linkage matrix.
+ *
+ * @return False if the file can not be written
+ */
+bool writeLinkage(const Dendrogram &dendrogram, const std::string &path);
+
+/**
+ * Writes cluster labels, the 8 bytes `MSTLABEL`, the vertex and cluster counts as int32, then one int32 label per
+ * vertex.
+ *
+ * @return False if the file can not be written
+ */
+bool writeLabels(const std::vector<int> &labels, const std::string &path);
+
+#endif
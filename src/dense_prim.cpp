@@ -0,0 +1,230 @@
+#include "graph.hpp"
+#include "dense_prim.hpp"
+#include <climits>
+#include <algorithm>
+
+// The vector kernels are compiled with target attributes and picked at runtime, so no build flags are needed
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DENSE_PRIM_X86 1
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+static int argminScalar(const int *key, int n)
+{
+    int best = -1;
+    int bestKey = INT_MAX;
+    for (int j = 0; j < n; j++)
+    {
+        if (key[j] < bestKey)
+        {
+            bestKey = key[j];
+            best = j;
+        }
+    }
+    return best;
+}
+
+static void relaxScalar(int *key, int *parent, const int *open, const int *row, int n, int u)
+{
+    for (int j = 0; j < n; j++)
+    {
+        if (open[j] && row[j] < key[j])
+        {
+            key[j] = row[j];
+            parent[j] = u;
+        }
+    }
+}
+
+#ifdef DENSE_PRIM_X86
+
+__attribute__((target("sse4.1"))) static int argminSSE(const int *key, int n)
+{
+    // First pass finds the smallest key, the second finds where it first appears
+    __m128i best = _mm_set1_epi32(INT_MAX);
+    int j = 0;
+    for (; j + 4 <= n; j += 4)
+    {
+        best = _mm_min_epi32(best, _mm_loadu_si128(reinterpret_cast<const __m128i *>(key + j)));
+    }
+    int lanes[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), best);
+    int smallest = min(min(lanes[0], lanes[1]), min(lanes[2], lanes[3]));
+    for (; j < n; j++)
+    {
+        smallest = min(smallest, key[j]);
+    }
+    if (smallest == INT_MAX)
+    {
+        return -1;
+    }
+
+    __m128i target = _mm_set1_epi32(smallest);
+    for (j = 0; j + 4 <= n; j += 4)
+    {
+        __m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(key + j)), target);
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(equal));
+        if (mask)
+        {
+            return j + __builtin_ctz(mask);
+        }
+    }
+    for (; j < n; j++)
+    {
+        if (key[j] == smallest)
+        {
+            return j;
+        }
+    }
+    return -1;
+}
+
+__attribute__((target("sse4.1"))) static void relaxSSE(int *key, int *parent, const int *open, const int *row, int n, int u)
+{
+    __m128i from = _mm_set1_epi32(u);
+    int j = 0;
+    for (; j + 4 <= n; j += 4)
+    {
+        __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i *>(key + j));
+        __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + j));
+        __m128i o = _mm_loadu_si128(reinterpret_cast<const __m128i *>(open + j));
+        __m128i lower = _mm_and_si128(_mm_cmpgt_epi32(k, w), o);
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i *>(parent + j));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(key + j), _mm_blendv_epi8(k, w, lower));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(parent + j), _mm_blendv_epi8(p, from, lower));
+    }
+    relaxScalar(key + j, parent + j, open + j, row + j, n - j, u);
+}
+
+__attribute__((target("avx2"))) static int argminAVX2(const int *key, int n)
+{
+    // First pass finds the smallest key, the second finds where it first appears
+    __m256i best = _mm256_set1_epi32(INT_MAX);
+    int j = 0;
+    for (; j + 8 <= n; j += 8)
+    {
+        best = _mm256_min_epi32(best, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(key + j)));
+    }
+    __m128i half = _mm_min_epi32(_mm256_castsi256_si128(best), _mm256_extracti128_si256(best, 1));
+    half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    int smallest = _mm_cvtsi128_si32(half);
+    for (; j < n; j++)
+    {
+        smallest = min(smallest, key[j]);
+    }
+    if (smallest == INT_MAX)
+    {
+        return -1;
+    }
+
+    __m256i target = _mm256_set1_epi32(smallest);
+    for (j = 0; j + 8 <= n; j += 8)
+    {
+        __m256i equal = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(key + j)), target);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(equal));
+        if (mask)
+        {
+            return j + __builtin_ctz(mask);
+        }
+    }
+    for (; j < n; j++)
+    {
+        if (key[j] == smallest)
+        {
+            return j;
+        }
+    }
+    return -1;
+}
+
+__attribute__((target("avx2"))) static void relaxAVX2(int *key, int *parent, const int *open, const int *row, int n, int u)
+{
+    __m256i from = _mm256_set1_epi32(u);
+    int j = 0;
+    for (; j + 8 <= n; j += 8)
+    {
+        __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(key + j));
+        __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + j));
+        __m256i o = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(open + j));
+        __m256i lower = _mm256_and_si256(_mm256_cmpgt_epi32(k, w), o);
+        __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(parent + j));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(key + j), _mm256_blendv_epi8(k, w, lower));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(parent + j), _mm256_blendv_epi8(p, from, lower));
+    }
+    relaxScalar(key + j, parent + j, open + j, row + j, n - j, u);
+}
+
+#endif
+
+/**
+ * The kernels picked for the CPU we are running on.
+ */
+struct DenseKernels
+{
+    int (*argmin)(const int *, int);
+    void (*relax)(int *, int *, const int *, const int *, int, int);
+    const char *name;
+};
+
+static DenseKernels selectKernels()
+{
+#ifdef DENSE_PRIM_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return {argminAVX2, relaxAVX2, "avx2"};
+    }
+    if (__builtin_cpu_supports("sse4.1"))
+    {
+        return {argminSSE, relaxSSE, "sse4.1"};
+    }
+#endif
+    return {argminScalar, relaxScalar, "scalar"};
+}
+
+static const DenseKernels &kernels()
+{
+    static const DenseKernels selected = selectKernels();
+    return selected;
+}
+
+int denseArgmin(const int *key, int n)
+{
+    return kernels().argmin(key, n);
+}
+
+void denseRelax(int *key, int *parent, const int *open, const int *row, int n, int u)
+{
+    kernels().relax(key, parent, open, row, n, u);
+}
+
+const char *denseKernelName()
+{
+    return kernels().name;
+}
+
+/**
+ * Implementation of array based Prim's Algorithm on a weight matrix
+ *
+ * @param matrix The weight matrix to perform the algorithm on
+ * @return A `MST` object with the minimum spanning tree of the graph
+ */
+MST prim_mst_dense(const WeightMatrix &matrix)
+{
+    return prim_mst_rows(matrix.verts, [&](int u, const vector<int> &)
+                         { return matrix.row(u); });
+}
+
+/**
+ * Implementation of array based Prim's Algorithm, building the weight matrix first
+ *
+ * @param graph The graph to perform the algorithm on
+ * @return A `MST` object with the minimum spanning tree of the graph
+ */
+MST prim_mst_dense(Graph &graph)
+{
+    return prim_mst_dense(WeightMatrix::fromGraph(graph));
+}
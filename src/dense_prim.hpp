@@ -0,0 +1,171 @@
+#ifndef DENSE_PRIM_HPP
+#define DENSE_PRIM_HPP
+
+#include "graph.hpp"
+#include <vector>
+#include <climits>
+#include <cstdlib>
+#include <cstddef>
+#include <algorithm>
+
+/**
+ * @brief A dense graph stored as a contiguous, row-major V x V weight matrix.
+ *
+ * Missing edges are stored as `INT_MAX`, so an edge can not have that weight.
+ */
+struct WeightMatrix
+{
+    int verts;                /**< The number of vertices. */
+    std::vector<int> weights; /**< The weights, row `u` starts at `u * verts`. */
+
+    /**
+     * @brief Constructs a matrix with no edges.
+     *
+     * @param n The number of vertices.
+     */
+    explicit WeightMatrix(int n) : verts(n), weights(static_cast<size_t>(n) * n, INT_MAX) {}
+
+    /**
+     * @return A pointer to the first weight of row `u`.
+     */
+    const int *row(int u) const
+    {
+        return weights.data() + static_cast<size_t>(u) * verts;
+    }
+
+    /**
+     * @brief Adds an undirected edge, keeping the lighter one if the edge is already there.
+     */
+    void addEdge(int src, int dest, int weight)
+    {
+        int &forward = weights[static_cast<size_t>(src) * verts + dest];
+        int &backward = weights[static_cast<size_t>(dest) * verts + src];
+        if (weight < forward)
+        {
+            forward = weight;
+            backward = weight;
+        }
+    }
+
+    /**
+     * @brief Builds the weight matrix of an adjacency list graph.
+     */
+    static WeightMatrix fromGraph(const Graph &graph)
+    {
+        WeightMatrix matrix(graph.vertNumber());
+        for (int u = 0; u < graph.vertNumber(); u++)
+        {
+            for (const auto &[dest, weight] : graph.adjList[u])
+            {
+                matrix.addEdge(u, dest, weight);
+            }
+        }
+        return matrix;
+    }
+};
+
+/**
+ * Finds the first smallest key, vectorized with AVX2 or SSE4.1 when the CPU supports it.
+ *
+ * @param key The keys to scan
+ * @param n The number of keys
+ * @return The index of the first smallest key, or -1 if every key is `INT_MAX`
+ */
+int denseArgmin(const int *key, int n);
+
+/**
+ * Lowers every open key to the matching row weight where that is smaller, and points its parent at `u`.
+ * Vectorized with AVX2 or SSE4.1 when the CPU supports it.
+ *
+ * @param key The current keys
+ * @param parent The current parents
+ * @param open -1 for vertices that are not in the tree yet, 0 for the ones that are
+ * @param row The weights from `u` to every vertex
+ * @param n The number of vertices
+ * @param u The vertex that was just added to the tree
+ */
+void denseRelax(int *key, int *parent, const int *open, const int *row, int n, int u);
+
+/**
+ * @return The name of the kernels picked for this CPU, "avx2", "sse4.1" or "scalar".
+ */
+const char *denseKernelName();
+
+MST prim_mst_dense(const WeightMatrix &matrix);
+MST prim_mst_dense(Graph &graph);
+
+/**
+ * Array based Prim's Algorithm, O(V^2) with no heap
+ *
+ * Each iteration picks the closest vertex with a vectorized argmin over the key array, then relaxes its row.
+ * Tree vertices have their key pinned to `INT_MAX` so the argmin can scan the whole array.
+ *
+ * @param verts The number of vertices
+ * @param rowOf Returns a pointer to the weights of row `u`, given `u` and the open mask
+ * @return A `MST` object with the minimum spanning tree of the graph, or forest if it is disconnected
+ */
+template <typename RowFn>
+MST prim_mst_rows(int verts, RowFn rowOf)
+{
+    MST mst;
+    if (verts == 0)
+    {
+        return mst;
+    }
+
+    std::vector<int> key(verts, INT_MAX);
+    std::vector<int> parent(verts, -1);
+    std::vector<int> open(verts, -1);
+
+    // Pick random vertex to Start
+    int start = rand() % verts;
+    key[start] = 0;
+
+    for (int iteration = 0; iteration < verts; iteration++)
+    {
+        int u = denseArgmin(key.data(), verts);
+        if (u == -1)
+        {
+            // Everything left is unreachable from the trees so far, start the next one from the first open vertex
+            u = std::find(open.begin(), open.end(), -1) - open.begin();
+            key[u] = 0;
+        }
+
+        // Per our spec the edge should go from the lower vertex to the higher vertex.
+        if (parent[u] != -1)
+        {
+            mst.edges.push_back(Graph::Edge(std::min(u, parent[u]), std::max(u, parent[u]), key[u]));
+            mst.totalWeight += key[u];
+        }
+
+        open[u] = 0;
+        key[u] = INT_MAX;
+        denseRelax(key.data(), parent.data(), open.data(), rowOf(u, open), verts, u);
+    }
+    return mst;
+}
+
+/**
+ * Array based Prim's Algorithm on an implicit complete graph
+ *
+ * The weights are computed on demand, one row per iteration, so only O(V) memory is used.
+ * The callback is only called for vertices that are not in the tree yet.
+ *
+ * @param verts The number of vertices
+ * @param weight A callable `int(int u, int v)` giving the weight of the edge between `u` and `v`
+ * @return A `MST` object with the minimum spanning tree of the graph
+ */
+template <typename WeightFn>
+MST prim_mst_implicit(int verts, WeightFn weight)
+{
+    std::vector<int> row(verts, INT_MAX);
+    return prim_mst_rows(verts, [&](int u, const std::vector<int> &open)
+                         {
+                             for (int v = 0; v < verts; v++)
+                             {
+                                 row[v] = open[v] ? weight(u, v) : INT_MAX;
+                             }
+                             return row.data(); });
+}
+
+#endif
@@ -0,0 +1,680 @@
+#include "graph.hpp"
+#include "kruskal.hpp"
+#include "dynamic_msf.hpp"
+#include <climits>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+
+using namespace std;
+
+DecrementalMSF::DecrementalMSF(int vertices, unsigned seed) : verts(vertices), nonTree(vertices)
+{
+    // A tree at level i has at most V / 2^i vertices, and a tree with an edge has at least two
+    levels = 1;
+    while ((1LL << levels) <= vertices)
+    {
+        levels++;
+    }
+    forests.reserve(levels);
+    for (int i = 0; i < levels; i++)
+    {
+        forests.emplace_back(vertices, seed + i);
+    }
+}
+
+/**
+ * Gives `x` the key of its lightest non-tree edge of a level, in that level's forest.
+ */
+void DecrementalMSF::refreshVertex(int x, int level)
+{
+    auto it = nonTree[x].lower_bound({level, 0, INT_MIN});
+    bool any = it != nonTree[x].end() && get<0>(*it) == level;
+    forests[level].setValue(x, any ? get<1>(*it) : EulerTourForest::NONE);
+}
+
+void DecrementalMSF::addNonTree(int id, int level)
+{
+    Edge &edge = edges[id];
+    edge.level = level;
+    nonTree[edge.u].insert({level, edge.key, id});
+    nonTree[edge.v].insert({level, edge.key, id});
+    refreshVertex(edge.u, level);
+    refreshVertex(edge.v, level);
+}
+
+void DecrementalMSF::removeNonTree(int id)
+{
+    const Edge &edge = edges[id];
+    nonTree[edge.u].erase({edge.level, edge.key, id});
+    nonTree[edge.v].erase({edge.level, edge.key, id});
+    refreshVertex(edge.u, edge.level);
+    refreshVertex(edge.v, edge.level);
+}
+
+/**
+ * Adds an edge to the forest at every level up to its own.
+ */
+void DecrementalMSF::linkTree(int id)
+{
+    Edge &edge = edges[id];
+    edge.arcs.clear();
+    for (int i = 0; i <= edge.level; i++)
+    {
+        edge.arcs.push_back(forests[i].link(edge.u, edge.v, id));
+    }
+    // The arc marked at the edge's own level is how the smaller side finds the tree edges to promote
+    forests[edge.level].setMark(edge.arcs[edge.level].first, true);
+}
+
+void DecrementalMSF::cutTree(int id)
+{
+    Edge &edge = edges[id];
+    for (int i = 0; i <= edge.level; i++)
+    {
+        forests[i].cut(edge.arcs[i]);
+    }
+    edge.arcs.clear();
+}
+
+void DecrementalMSF::promoteTree(int id)
+{
+    Edge &edge = edges[id];
+    forests[edge.level].setMark(edge.arcs[edge.level].first, false);
+    edge.level++;
+    edge.arcs.push_back(forests[edge.level].link(edge.u, edge.v, id));
+    forests[edge.level].setMark(edge.arcs[edge.level].first, true);
+    promotions++;
+}
+
+int DecrementalMSF::addEdge(int u, int v, uint64_t key, bool tree)
+{
+    int id = edges.size();
+    edges.emplace_back();
+    Edge &edge = edges[id];
+    edge.u = u;
+    edge.v = v;
+    edge.key = key;
+    edge.tree = tree;
+    edge.alive = true;
+    if (tree)
+    {
+        linkTree(id);
+    }
+    else
+    {
+        addNonTree(id, 0);
+    }
+    return id;
+}
+
+int DecrementalMSF::deleteEdge(int id)
+{
+    Edge &edge = edges[id];
+    edge.alive = false;
+    if (!edge.tree)
+    {
+        removeNonTree(id);
+        return -1;
+    }
+    edge.tree = false;
+    cutTree(id);
+
+    int u = edge.u, v = edge.v;
+    for (int i = edge.level; i >= 0; i--)
+    {
+        // The smaller side has at most half of the vertices, so its tree fits the next level
+        int side = forests[i].treeSize(u) <= forests[i].treeSize(v) ? u : v;
+        for (int tree : forests[i].markedEdges(side))
+        {
+            promoteTree(tree);
+        }
+        // Lightest first, the edges before the first crossing one have both ends in the tree and move up with it
+        while (true)
+        {
+            int x = forests[i].minValueVertex(side);
+            if (x == -1)
+            {
+                break;
+            }
+            int found = get<2>(*nonTree[x].lower_bound({i, 0, INT_MIN}));
+            int other = edges[found].u == x ? edges[found].v : edges[found].u;
+            removeNonTree(found);
+            if (!forests[i].connected(side, other))
+            {
+                edges[found].tree = true;
+                linkTree(found);
+                return found;
+            }
+            addNonTree(found, i + 1);
+            promotions++;
+        }
+    }
+    return -1;
+}
+
+vector<int> DecrementalMSF::nonTreeEdges() const
+{
+    vector<int> ids;
+    for (size_t id = 0; id < edges.size(); id++)
+    {
+        if (edges[id].alive && !edges[id].tree)
+        {
+            ids.push_back(id);
+        }
+    }
+    return ids;
+}
+
+DynamicMSF::DynamicMSF(int vertices, unsigned seed) : verts(vertices), seed(seed), tour(vertices, seed),
+                                                      paths(vertices)
+{
+}
+
+DynamicMSF::DynamicMSF(int vertices, const vector<Graph::Edge> &initial, unsigned seed) : DynamicMSF(vertices, seed)
+{
+    edges.resize(initial.size());
+    vector<int> order;
+    for (size_t i = 0; i < initial.size(); i++)
+    {
+        const Graph::Edge &edge = initial[i];
+        if (edge.src < 0 || edge.dest < 0 || edge.src >= verts || edge.dest >= verts || edge.src == edge.dest)
+        {
+            freeIds.push_back(i);
+            continue;
+        }
+        Record &record = edges[i];
+        record.u = edge.src;
+        record.v = edge.dest;
+        record.weight = edge.weight;
+        record.key = edgeRank(edge.weight, serial++);
+        record.alive = true;
+        byEndpoints[endpointKey(edge.src, edge.dest)].push_back(i);
+        order.push_back(i);
+    }
+
+    // Kruskal's algorithm picks the forest, and every other edge goes into one bucket
+    sort(order.begin(), order.end(), [&](int a, int b)
+         { return edges[a].key < edges[b].key; });
+    UnionFind components(verts);
+    vector<int> others;
+    for (int id : order)
+    {
+        if (components.find(edges[id].u) != components.find(edges[id].v))
+        {
+            components.merge(edges[id].u, edges[id].v);
+            linkForest(id);
+        }
+        else
+        {
+            others.push_back(id);
+        }
+    }
+    if (!others.empty())
+    {
+        size_t j = 0;
+        while ((1ULL << j) < others.size())
+        {
+            j++;
+        }
+        buckets.resize(j + 1);
+        paths.reserveLabels(buckets.size());
+        rebuild(j, others);
+    }
+}
+
+int DynamicMSF::newEdge(int u, int v, int w)
+{
+    int id;
+    if (!freeIds.empty())
+    {
+        id = freeIds.back();
+        freeIds.pop_back();
+    }
+    else
+    {
+        id = edges.size();
+        edges.emplace_back();
+    }
+    Record &edge = edges[id];
+    edge = Record();
+    edge.u = u;
+    edge.v = v;
+    edge.weight = w;
+    edge.key = edgeRank(w, serial++);
+    edge.alive = true;
+    byEndpoints[endpointKey(u, v)].push_back(id);
+    return id;
+}
+
+void DynamicMSF::linkForest(int id)
+{
+    Record &edge = edges[id];
+    edge.tree = true;
+    edge.arcs = tour.link(edge.u, edge.v, id);
+    if (!freePathNodes.empty())
+    {
+        edge.pathNode = freePathNodes.back();
+        freePathNodes.pop_back();
+        paths.resetNode(edge.pathNode, true, edge.key);
+        pathEdge[edge.pathNode - verts] = id;
+    }
+    else
+    {
+        edge.pathNode = paths.addNode(true, edge.key);
+        pathEdge.push_back(id);
+    }
+    paths.link(edge.u, edge.pathNode);
+    paths.link(edge.pathNode, edge.v);
+    weight += edge.weight;
+    treeEdges++;
+}
+
+void DynamicMSF::cutForest(int id)
+{
+    Record &edge = edges[id];
+    edge.tree = false;
+    tour.cut(edge.arcs);
+    edge.arcs = {-1, -1};
+    paths.cut(edge.u, edge.pathNode);
+    paths.cut(edge.pathNode, edge.v);
+    freePathNodes.push_back(edge.pathNode);
+    edge.pathNode = -1;
+    weight -= edge.weight;
+    treeEdges--;
+}
+
+bool DynamicMSF::live(const Copy &copy) const
+{
+    return buckets[copy.bucket].generation == copy.generation;
+}
+
+/**
+ * Deletes every copy of an edge from the buckets, and adds the edges the searches brought into their forests to
+ * `found`.
+ */
+void DynamicMSF::dropCopies(int id, vector<int> &found)
+{
+    for (const Copy &copy : edges[id].copies)
+    {
+        if (!live(copy))
+        {
+            continue;
+        }
+        Bucket &bucket = buckets[copy.bucket];
+        if (!bucket.msf.isTreeEdge(copy.local))
+        {
+            bucket.held--;
+        }
+        int replacement = bucket.msf.deleteEdge(copy.local);
+        if (replacement != -1)
+        {
+            bucket.held--;
+            found.push_back(bucket.owner[replacement]);
+        }
+    }
+    edges[id].copies.clear();
+}
+
+/**
+ * Takes a tree edge out of the forest, and puts the lightest edge that reconnects it in, `offered` if that is the
+ * one. The edge itself is placed in a bucket again if it is still live.
+ *
+ * Every bucket that has the edge on one of its paths or as a copy deletes it there. The lightest live edge y across
+ * the cut is a non-tree copy in some bucket, and the path of y in that bucket's forest runs over the forest edges of
+ * the cut an odd number of times, so over the deleted edge or over a copy of a lighter edge across the cut, which
+ * can not exist. So that bucket searches, and the lightest replacement it can find is y.
+ */
+void DynamicMSF::leaveForest(int id, int offered)
+{
+    // The labels of a path may be left from an older build of the bucket, the ends coming apart tells them apart
+    vector<pair<int, int>> through;
+    for (size_t j = 0; j < buckets.size(); j++)
+    {
+        const Bucket &bucket = buckets[j];
+        int local = bucket.held == 0 ? -1 : paths.label(edges[id].pathNode, j);
+        if (local != -1 && local < static_cast<int>(bucket.owner.size()) && bucket.owner[local] == -1 &&
+            bucket.msf.isTreeEdge(local))
+        {
+            through.emplace_back(j, local);
+        }
+    }
+    cutForest(id);
+
+    vector<int> found;
+    for (const auto &[j, local] : through)
+    {
+        Bucket &bucket = buckets[j];
+        auto [a, b] = bucket.msf.endpoints(local);
+        if (tour.connected(bucket.vertex[a], bucket.vertex[b]))
+        {
+            continue;
+        }
+        int replacement = bucket.msf.deleteEdge(local);
+        if (replacement != -1)
+        {
+            bucket.held--;
+            found.push_back(bucket.owner[replacement]);
+        }
+    }
+    dropCopies(id, found);
+    if (offered != -1)
+    {
+        found.push_back(offered);
+    }
+
+    int best = -1;
+    for (int edge : found)
+    {
+        if (!tour.connected(edges[edge].u, edges[edge].v) && (best == -1 || edges[edge].key < edges[best].key))
+        {
+            best = edge;
+        }
+    }
+    if (best != -1)
+    {
+        linkForest(best);
+    }
+    for (int edge : found)
+    {
+        if (edge != best)
+        {
+            place(edge);
+        }
+    }
+    if (edges[id].alive)
+    {
+        place(id);
+    }
+}
+
+/**
+ * Gives a non-tree edge a bucket: the first one that is empty, or that can take in every bucket below it and the
+ * edge while staying within its 2^j edges.
+ */
+void DynamicMSF::place(int id)
+{
+    long long total = 1;
+    size_t j = 0;
+    for (; j < buckets.size(); j++)
+    {
+        total += buckets[j].held;
+        if (buckets[j].held == 0 || total <= (1LL << j))
+        {
+            break;
+        }
+    }
+    if (j == buckets.size())
+    {
+        buckets.emplace_back();
+        paths.reserveLabels(buckets.size());
+    }
+
+    vector<int> ids = {id};
+    for (size_t k = 0; k <= j; k++)
+    {
+        for (int local : buckets[k].msf.nonTreeEdges())
+        {
+            ids.push_back(buckets[k].owner[local]);
+        }
+        clearBucket(k);
+    }
+    rebuild(j, ids);
+}
+
+void DynamicMSF::clearBucket(int j)
+{
+    Bucket &bucket = buckets[j];
+    retiredPromotions += bucket.msf.promotionCount();
+    bucket.msf = DecrementalMSF();
+    bucket.generation = ++generations;
+    bucket.vertex.clear();
+    bucket.owner.clear();
+    bucket.held = 0;
+}
+
+/**
+ * Builds bucket `j`, which must be clear, from the non-tree edges `ids` and the forest compressed to their ends.
+ * The compressed paths go in as the tree and the edges as non-tree edges, which is the minimum spanning forest of
+ * the bucket since each edge is the heaviest on its cycle in the forest.
+ */
+void DynamicMSF::rebuild(int j, const vector<int> &ids)
+{
+    Bucket &bucket = buckets[j];
+    bucket.generation = ++generations;
+
+    vector<int> terminals;
+    for (int id : ids)
+    {
+        terminals.push_back(edges[id].u);
+        terminals.push_back(edges[id].v);
+    }
+    sort(terminals.begin(), terminals.end());
+    terminals.erase(unique(terminals.begin(), terminals.end()), terminals.end());
+    vector<pair<int, int>> tree;
+    compress(terminals, bucket.vertex, tree);
+    unordered_map<int, int> local;
+    for (size_t x = 0; x < bucket.vertex.size(); x++)
+    {
+        local[bucket.vertex[x]] = x;
+    }
+
+    bucket.msf = DecrementalMSF(bucket.vertex.size(), seed + bucket.generation);
+    for (const auto &[a, b] : tree)
+    {
+        int path = bucket.msf.addEdge(local[a], local[b], paths.key(paths.pathMax(a, b)), true);
+        bucket.owner.push_back(-1);
+        paths.labelPath(a, b, j, path);
+    }
+    for (int id : ids)
+    {
+        Record &edge = edges[id];
+        int copy = bucket.msf.addEdge(local[edge.u], local[edge.v], edge.key, false);
+        bucket.owner.push_back(id);
+        edge.copies.erase(remove_if(edge.copies.begin(), edge.copies.end(), [&](const Copy &old)
+                                    { return !live(old); }),
+                          edge.copies.end());
+        edge.copies.push_back({j, bucket.generation, copy});
+    }
+    bucket.held = ids.size();
+    rebuilt += ids.size();
+}
+
+/**
+ * Compresses the forest to the Steiner trees of the terminals, tree by tree: the terminals and the lowest common
+ * ancestors of neighbours in depth-first order are the vertices, and the path from each to the nearest of them
+ * above it is an edge. The paths only meet at their ends.
+ *
+ * @param vertex The vertices of the compressed forest
+ * @param tree Its edges, as pairs of vertices of the graph
+ */
+void DynamicMSF::compress(const vector<int> &terminals, vector<int> &vertex, vector<pair<int, int>> &tree)
+{
+    vertex.clear();
+    tree.clear();
+    vector<pair<int, int>> byTree;
+    for (int t : terminals)
+    {
+        byTree.emplace_back(tour.treeId(t), t);
+    }
+    sort(byTree.begin(), byTree.end());
+
+    for (size_t first = 0; first < byTree.size();)
+    {
+        size_t last = first;
+        while (last < byTree.size() && byTree[last].first == byTree[first].first)
+        {
+            last++;
+        }
+        int root = byTree[first].second;
+        tour.startTour(root);
+        paths.makeRoot(root);
+        // The arcs of the edge above a vertex enclose its subtree in the tour
+        auto span = [&](int x) -> tuple<int, int, int>
+        {
+            if (x == root)
+            {
+                return {-1, INT_MAX, x};
+            }
+            const Record &edge = edges[pathEdge[paths.parent(x) - verts]];
+            int a = tour.tourPosition(edge.arcs.first), b = tour.tourPosition(edge.arcs.second);
+            return {min(a, b), max(a, b), x};
+        };
+
+        vector<tuple<int, int, int>> spans;
+        for (size_t i = first; i < last; i++)
+        {
+            spans.push_back(span(byTree[i].second));
+        }
+        sort(spans.begin(), spans.end());
+        for (size_t i = 1, count = spans.size(); i < count; i++)
+        {
+            int above = paths.lca(get<2>(spans[i - 1]), get<2>(spans[i]));
+            spans.push_back(span(above));
+        }
+        sort(spans.begin(), spans.end());
+        spans.erase(unique(spans.begin(), spans.end()), spans.end());
+
+        vector<tuple<int, int, int>> stack;
+        for (const auto &current : spans)
+        {
+            // Sorted by where they start, so the top is an ancestor exactly when its subtree reaches this far
+            while (!stack.empty() && get<1>(stack.back()) < get<0>(current))
+            {
+                stack.pop_back();
+            }
+            if (!stack.empty())
+            {
+                tree.emplace_back(get<2>(stack.back()), get<2>(current));
+            }
+            stack.push_back(current);
+            vertex.push_back(get<2>(current));
+        }
+        first = last;
+    }
+}
+
+/**
+ * Clears the buckets that hold no edges any more, their searches could never find one.
+ */
+void DynamicMSF::tidy()
+{
+    for (size_t j = 0; j < buckets.size(); j++)
+    {
+        if (buckets[j].held == 0 && !buckets[j].vertex.empty())
+        {
+            clearBucket(j);
+        }
+    }
+}
+
+int DynamicMSF::insertEdge(int u, int v, int w)
+{
+    if (u < 0 || v < 0 || u >= verts || v >= verts)
+    {
+        cerr << "Edge " << u << " " << v << " is out of range." << endl;
+        return -1;
+    }
+    if (u == v)
+    {
+        return -1;
+    }
+    int id = newEdge(u, v, w);
+    if (!tour.connected(u, v))
+    {
+        linkForest(id);
+        return id;
+    }
+    int heaviest = pathEdge[paths.pathMax(u, v) - verts];
+    if (edges[heaviest].key < edges[id].key)
+    {
+        // The new edge is the heaviest on its cycle
+        place(id);
+    }
+    else
+    {
+        // The heaviest edge of the cycle leaves the forest, and the new edge is the lightest across the cut
+        leaveForest(heaviest, id);
+    }
+    tidy();
+    return id;
+}
+
+bool DynamicMSF::deleteEdge(int id)
+{
+    if (id < 0 || id >= static_cast<int>(edges.size()) || !edges[id].alive)
+    {
+        return false;
+    }
+    Record &edge = edges[id];
+    edge.alive = false;
+    vector<int> &parallel = byEndpoints[endpointKey(edge.u, edge.v)];
+    parallel.erase(find(parallel.begin(), parallel.end(), id));
+    if (parallel.empty())
+    {
+        byEndpoints.erase(endpointKey(edge.u, edge.v));
+    }
+    freeIds.push_back(id);
+
+    if (edge.tree)
+    {
+        leaveForest(id, -1);
+    }
+    else
+    {
+        // The forest stays, but the searches behind the copies may bring edges into the bucket forests
+        vector<int> found;
+        dropCopies(id, found);
+        for (int other : found)
+        {
+            place(other);
+        }
+    }
+    tidy();
+    return true;
+}
+
+int DynamicMSF::findEdge(int u, int v) const
+{
+    auto parallel = byEndpoints.find(endpointKey(u, v));
+    return parallel == byEndpoints.end() ? -1 : parallel->second.back();
+}
+
+bool DynamicMSF::deleteEdge(int u, int v)
+{
+    return deleteEdge(findEdge(u, v));
+}
+
+bool DynamicMSF::connected(int u, int v) const
+{
+    return tour.connected(u, v);
+}
+
+bool DynamicMSF::isTreeEdge(int id) const
+{
+    return id >= 0 && id < static_cast<int>(edges.size()) && edges[id].alive && edges[id].tree;
+}
+
+long long DynamicMSF::promotionCount() const
+{
+    long long total = retiredPromotions;
+    for (const auto &bucket : buckets)
+    {
+        total += bucket.msf.promotionCount();
+    }
+    return total;
+}
+
+MST DynamicMSF::mst() const
+{
+    MST forest;
+    for (const auto &edge : edges)
+    {
+        if (edge.alive && edge.tree)
+        {
+            forest.edges.emplace_back(edge.u, edge.v, edge.weight);
+            forest.totalWeight += edge.weight;
+        }
+    }
+    return forest;
+}
@@ -0,0 +1,317 @@
+#ifndef DYNAMIC_MSF_HPP
+#define DYNAMIC_MSF_HPP
+
+#include "graph.hpp"
+#include "euler_tour.hpp"
+#include "link_cut_tree.hpp"
+#include <set>
+#include <tuple>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+/**
+ * @brief A minimum spanning forest under edge deletions only, the decremental structure of Holm, de Lichtenberg and
+ * Thorup.
+ *
+ * Every edge has a level between 0 and log2(V), and level `i` keeps the forest of the tree edges of level at least
+ * `i` in an `EulerTourForest`. The levels keep three invariants: a tree at level `i` has at most V / 2^i vertices,
+ * the endpoints of a non-tree edge of level `i` are connected at level `i`, and the heaviest edge of a cycle has
+ * the lowest level on it.
+ *
+ * Every edge starts at level 0, so the edges added before the first deletion must have their tree edges form the
+ * minimum spanning forest of all of them. Deleting a tree edge searches the levels from the edge's down to 0, from
+ * the smaller of the two trees: its tree edges of that level move up, then its non-tree edges of that level are
+ * tried lightest first, and the ones that do not cross the cut move up until one does. That one replaces the edge
+ * and the search stops. Edges only ever move up, at most log2(V) times each, and a move costs O(log V), so the
+ * deletions cost O(log^2 V) amortized per edge added.
+ */
+class DecrementalMSF
+{
+private:
+    /**
+     * @brief An edge of the graph, live or deleted.
+     */
+    struct Edge
+    {
+        int u = 0;
+        int v = 0;
+        uint64_t key = 0;
+        int level = 0;
+        bool tree = false;
+        bool alive = false;
+        // The arc nodes of the edge at every level up to its own, for a tree edge
+        std::vector<std::pair<int, int>> arcs;
+    };
+
+    int verts = 0;
+    int levels = 0;
+    std::vector<EulerTourForest> forests;
+    // The non-tree edges of every vertex, as (level, key, id), so the lightest of a level is a lower_bound away
+    std::vector<std::set<std::tuple<int, uint64_t, int>>> nonTree;
+    std::vector<Edge> edges;
+    long long promotions = 0;
+
+    void refreshVertex(int x, int level);
+    void addNonTree(int id, int level);
+    void removeNonTree(int id);
+    void linkTree(int id);
+    void cutTree(int id);
+    void promoteTree(int id);
+
+public:
+    /**
+     * @param vertices The number of vertices
+     * @param seed The seed of the treap priorities
+     */
+    explicit DecrementalMSF(int vertices = 0, unsigned seed = 1);
+
+    /**
+     * Adds an edge at level 0, which is only allowed before the first deletion.
+     *
+     * @param tree True for an edge of the minimum spanning forest, whose endpoints must not be connected yet
+     * @return The id of the edge, the number of edges added before it
+     */
+    int addEdge(int u, int v, uint64_t key, bool tree);
+
+    /**
+     * Deletes a live edge. Deleting a tree edge searches the levels for the lightest replacement.
+     *
+     * @return The non-tree edge that joined the forest in its place, or -1 if none did
+     */
+    int deleteEdge(int id);
+
+    /**
+     * @return True if the edge is live and in the forest.
+     */
+    bool isTreeEdge(int id) const
+    {
+        return edges[id].alive && edges[id].tree;
+    }
+
+    /**
+     * @return The ids of the live non-tree edges, in O(E).
+     */
+    std::vector<int> nonTreeEdges() const;
+
+    /**
+     * @return The endpoints of an edge.
+     */
+    std::pair<int, int> endpoints(int id) const
+    {
+        return {edges[id].u, edges[id].v};
+    }
+
+    /**
+     * @return The number of times an edge moved up a level.
+     */
+    long long promotionCount() const
+    {
+        return promotions;
+    }
+};
+
+/**
+ * @brief A minimum spanning forest under edge insertions and deletions, after Holm, de Lichtenberg and Thorup.
+ *
+ * The forest is kept in a `LinkCutTree`, for the heaviest edge on a path, and in an `EulerTourForest`, for
+ * connectivity and depth-first orders. An inserted edge that closes a cycle swaps with the heaviest edge on it if it
+ * is lighter. The non-tree edges are spread over `DecrementalMSF` buckets like the digits of a binary counter:
+ * bucket `j` holds at most 2^j of them, and an edge that needs a bucket merges the buckets below the first one with
+ * room into it, which is rebuilt. So an edge is rebuilt O(log E) times before it moves again.
+ *
+ * The graph of a bucket is its non-tree edges plus the forest compressed to their endpoints: every path of the
+ * forest between two branch points of their Steiner tree becomes one tree edge, as heavy as the heaviest edge on
+ * it. A bucket of k edges then has O(k) vertices whatever V is. Its paths are labelled in the `LinkCutTree`, so a
+ * forest edge finds the path of every bucket it is on in O(log V) per bucket.
+ *
+ * When an edge leaves the forest, every bucket that has it, on one of its paths or as a tree edge copied from the
+ * graph, deletes it there. The lightest of the replacements the buckets find that reconnects the forest joins it.
+ * The other replacements, and the edge itself if it is still in the graph, are placed in a bucket again. Their old
+ * copies stay behind as tree edges until their edge leaves the graph or the forest. Only edges ever move up inside
+ * the buckets, each update deletes at most one edge and places at most one edge again per bucket, so an update
+ * costs polylogarithmic amortized time.
+ */
+class DynamicMSF
+{
+private:
+    /**
+     * @brief Where an edge of the graph is copied in a bucket, until the bucket is rebuilt.
+     */
+    struct Copy
+    {
+        int bucket = 0;
+        int generation = 0;
+        int local = 0;
+    };
+
+    /**
+     * @brief An edge of the graph, live or waiting for its id to be reused.
+     */
+    struct Record
+    {
+        int u = 0;
+        int v = 0;
+        int weight = 0;
+        uint64_t key = 0;
+        bool tree = false;
+        bool alive = false;
+        // The arc nodes of a tree edge in `tour`, and its node in `paths`
+        std::pair<int, int> arcs = {-1, -1};
+        int pathNode = -1;
+        // One non-tree copy while the edge is out of the forest, and the tree copies the searches left behind
+        std::vector<Copy> copies;
+    };
+
+    /**
+     * @brief A decremental structure over some of the non-tree edges and the forest compressed to their endpoints.
+     */
+    struct Bucket
+    {
+        DecrementalMSF msf;
+        int generation = 0;
+        // The vertex of the graph of every vertex of the bucket
+        std::vector<int> vertex;
+        // The edge of the graph every edge of the bucket copies, -1 for a path of the forest
+        std::vector<int> owner;
+        // The number of non-tree copies, which are the edges the bucket holds
+        int held = 0;
+    };
+
+    int verts;
+    unsigned seed;
+    EulerTourForest tour;
+    // The forest with every tree edge as a node, for the heaviest edge on a path and the labels of the paths
+    LinkCutTree paths;
+    std::vector<int> pathEdge;
+    std::vector<int> freePathNodes;
+
+    std::vector<Record> edges;
+    std::vector<int> freeIds;
+    std::unordered_map<uint64_t, std::vector<int>> byEndpoints;
+    uint32_t serial = 0;
+
+    std::vector<Bucket> buckets;
+    int generations = 0;
+
+    long long weight = 0;
+    int treeEdges = 0;
+    long long retiredPromotions = 0;
+    long long rebuilt = 0;
+
+    int newEdge(int u, int v, int w);
+    void linkForest(int id);
+    void cutForest(int id);
+    bool live(const Copy &copy) const;
+    void dropCopies(int id, std::vector<int> &found);
+    void leaveForest(int id, int offered);
+    void place(int id);
+    void clearBucket(int j);
+    void rebuild(int j, const std::vector<int> &ids);
+    void compress(const std::vector<int> &terminals, std::vector<int> &vertex,
+                  std::vector<std::pair<int, int>> &tree);
+    void tidy();
+
+public:
+    /**
+     * @param vertices The number of vertices
+     * @param seed The seed of the treap priorities
+     */
+    explicit DynamicMSF(int vertices, unsigned seed = 1);
+
+    /**
+     * Builds the forest of a whole graph at once, in O((V + E) log(V + E)), which is much cheaper than inserting
+     * its edges one by one. The edge at index `i` of `initial` gets the id `i`, the ids of self loops and of edges
+     * out of range are left free.
+     */
+    DynamicMSF(int vertices, const std::vector<Graph::Edge> &initial, unsigned seed = 1);
+
+    /**
+     * Inserts an edge. An edge lighter than the heaviest on the cycle it closes replaces that one, which costs a
+     * replacement search like a deletion does.
+     *
+     * @return The id of the edge, or -1 for a self loop or a vertex out of range
+     */
+    int insertEdge(int u, int v, int w);
+
+    /**
+     * Deletes an edge by id. Deleting a tree edge searches the buckets for the lightest replacement.
+     *
+     * @return False if there is no live edge with that id
+     */
+    bool deleteEdge(int id);
+
+    /**
+     * @return The id of the live edge between `u` and `v` inserted last, or -1 if there is none.
+     */
+    int findEdge(int u, int v) const;
+
+    /**
+     * Deletes one edge between `u` and `v`, the one inserted last.
+     *
+     * @return False if there is none
+     */
+    bool deleteEdge(int u, int v);
+
+    /**
+     * @return True if `u` and `v` are connected.
+     */
+    bool connected(int u, int v) const;
+
+    /**
+     * @return True if the edge is live and in the forest.
+     */
+    bool isTreeEdge(int id) const;
+
+    /**
+     * @return The total weight of the forest.
+     */
+    long long totalWeight() const
+    {
+        return weight;
+    }
+
+    /**
+     * @return The number of edges in the forest.
+     */
+    int edgeCount() const
+    {
+        return treeEdges;
+    }
+
+    /**
+     * @return The number of trees in the forest, counting lone vertices.
+     */
+    int componentCount() const
+    {
+        return verts - treeEdges;
+    }
+
+    /**
+     * @return The number of vertices.
+     */
+    int vertNumber() const
+    {
+        return verts;
+    }
+
+    /**
+     * @return The number of times an edge moved up a level in a bucket, which pays for the searches.
+     */
+    long long promotionCount() const;
+
+    /**
+     * @return The number of edges placed in rebuilt buckets, which pays for the rebuilds.
+     */
+    long long rebuiltEdges() const
+    {
+        return rebuilt;
+    }
+
+    /**
+     * @return The forest as a `MST` object, in O(E).
+     */
+    MST mst() const;
+};
+
+#endif
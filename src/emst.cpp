@@ -0,0 +1,362 @@
+#include "graph.hpp"
+#include "emst.hpp"
+#include "kruskal.hpp"
+#include <vector>
+#include <limits>
+#include <numeric>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+using namespace std;
+
+// The number of points below which a kd-tree node is not split
+static const int KD_LEAF_SIZE = 16;
+
+PointCloud loadPointCloud(const string &file)
+{
+    ifstream inputFile(file);
+    if (!inputFile)
+    {
+        cerr << "Error loading point cloud file.";
+        return PointCloud();
+    }
+    string cloudName;
+    int count = 0, dims = 0;
+    inputFile >> cloudName >> count >> dims;
+
+    PointCloud points(dims, cloudName);
+    points.coords.reserve(static_cast<size_t>(max(0, count)) * max(0, dims));
+    double value;
+    while (static_cast<int>(points.coords.size()) < count * dims && inputFile >> value)
+    {
+        points.coords.push_back(value);
+    }
+    // Drop a partial last point
+    points.coords.resize(static_cast<size_t>(points.size()) * max(0, dims));
+    return points;
+}
+
+double treeLength(const PointCloud &points, const MST &mst)
+{
+    double length = 0;
+    for (const auto &edge : mst.edges)
+    {
+        length += points.distance(edge.src, edge.dest);
+    }
+    return length;
+}
+
+/**
+ * Dual-tree Borůvka on a kd-tree, see `euclidean_mst`.
+ */
+class DualTreeBoruvka
+{
+private:
+    /**
+     * @brief A kd-tree node, the points `[begin, end)` of the sorted order and their bounding box.
+     */
+    struct Node
+    {
+        int begin;
+        int end;
+        int left = -1;
+        int right = -1;
+        // The component every point of the node is in, or -1 if they are not all in one
+        int component = -1;
+        // No point of the node can improve its component's candidate with a pair farther than this
+        double bound = 0;
+    };
+
+    /**
+     * @brief The lightest edge found so far leaving a component, ties broken by the point indices.
+     */
+    struct Candidate
+    {
+        double distance;
+        int u;
+        int v;
+
+        bool lighterThan(double d, int a, int b) const
+        {
+            if (d != distance)
+            {
+                return d < distance;
+            }
+            return make_pair(min(a, b), max(a, b)) < make_pair(min(u, v), max(u, v));
+        }
+    };
+
+    int dims;
+    int count;
+    // The points in kd-tree order, and the input index of each one
+    vector<double> coords;
+    vector<int> order;
+    vector<Node> nodes;
+    // The bounding boxes, node `i` has its lower corner at `i * dims` of `low`
+    vector<double> low;
+    vector<double> high;
+
+    UnionFind components;
+    vector<int> componentOf;
+    vector<Candidate> best;
+
+    const double *point(int i) const
+    {
+        return coords.data() + static_cast<size_t>(i) * dims;
+    }
+
+    double squaredDistance(int a, int b) const
+    {
+        double sum = 0;
+        for (int d = 0; d < dims; d++)
+        {
+            double delta = point(a)[d] - point(b)[d];
+            sum += delta * delta;
+        }
+        return sum;
+    }
+
+    /**
+     * @return The squared distance between the bounding boxes of two nodes, 0 if they overlap.
+     */
+    double boxDistance(int a, int b) const
+    {
+        double sum = 0;
+        for (int d = 0; d < dims; d++)
+        {
+            double gap = max(low[a * dims + d] - high[b * dims + d], low[b * dims + d] - high[a * dims + d]);
+            if (gap > 0)
+            {
+                sum += gap * gap;
+            }
+        }
+        return sum;
+    }
+
+    /**
+     * Builds the subtree of `order[begin, end)`, splitting at the median of the widest dimension.
+     */
+    int build(const PointCloud &points, int begin, int end)
+    {
+        int id = nodes.size();
+        nodes.push_back({begin, end});
+        for (int d = 0; d < dims; d++)
+        {
+            low.push_back(numeric_limits<double>::infinity());
+            high.push_back(-numeric_limits<double>::infinity());
+        }
+        for (int i = begin; i < end; i++)
+        {
+            for (int d = 0; d < dims; d++)
+            {
+                low[id * dims + d] = min(low[id * dims + d], points.point(order[i])[d]);
+                high[id * dims + d] = max(high[id * dims + d], points.point(order[i])[d]);
+            }
+        }
+        if (end - begin <= KD_LEAF_SIZE)
+        {
+            return id;
+        }
+
+        int widest = 0;
+        for (int d = 1; d < dims; d++)
+        {
+            if (high[id * dims + d] - low[id * dims + d] > high[id * dims + widest] - low[id * dims + widest])
+            {
+                widest = d;
+            }
+        }
+        int middle = begin + (end - begin) / 2;
+        nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end, [&](int a, int b)
+                    { return points.point(a)[widest] < points.point(b)[widest]; });
+        int left = build(points, begin, middle);
+        int right = build(points, middle, end);
+        nodes[id].left = left;
+        nodes[id].right = right;
+        return id;
+    }
+
+    bool isLeaf(int node) const
+    {
+        return nodes[node].left == -1;
+    }
+
+    /**
+     * Labels every node with the component all of its points are in, and resets the bounds for a new round.
+     */
+    void labelNodes()
+    {
+        // Children always come after their parent, so a backwards sweep is a post-order
+        for (int id = nodes.size() - 1; id >= 0; id--)
+        {
+            Node &node = nodes[id];
+            node.bound = numeric_limits<double>::infinity();
+            if (isLeaf(id))
+            {
+                node.component = componentOf[node.begin];
+                for (int i = node.begin + 1; i < node.end && node.component != -1; i++)
+                {
+                    if (componentOf[i] != node.component)
+                    {
+                        node.component = -1;
+                    }
+                }
+            }
+            else
+            {
+                int left = nodes[node.left].component;
+                node.component = left == nodes[node.right].component ? left : -1;
+            }
+        }
+    }
+
+    void baseCase(int query, int reference)
+    {
+        const Node &q = nodes[query];
+        const Node &r = nodes[reference];
+        double bound = 0;
+        for (int i = q.begin; i < q.end; i++)
+        {
+            int component = componentOf[i];
+            Candidate &candidate = best[component];
+            for (int j = r.begin; j < r.end; j++)
+            {
+                if (componentOf[j] == component)
+                {
+                    continue;
+                }
+                double d = squaredDistance(i, j);
+                if (candidate.lighterThan(d, i, j))
+                {
+                    candidate = {d, i, j};
+                }
+            }
+            bound = max(bound, candidate.distance);
+        }
+        nodes[query].bound = bound;
+    }
+
+    /**
+     * Finds, for every component with a point under `query`, the lightest edge to a point under `reference`.
+     */
+    void traverse(int query, int reference)
+    {
+        const Node &q = nodes[query];
+        const Node &r = nodes[reference];
+        if (q.component != -1 && q.component == r.component)
+        {
+            return;
+        }
+        if (boxDistance(query, reference) > q.bound)
+        {
+            return;
+        }
+        if (isLeaf(query) && isLeaf(reference))
+        {
+            baseCase(query, reference);
+            return;
+        }
+
+        // Visit the closer child of the reference first, so the bounds shrink before the farther one is tried
+        auto visitReference = [&](int child)
+        {
+            int near = r.left, far = r.right;
+            if (boxDistance(child, far) < boxDistance(child, near))
+            {
+                swap(near, far);
+            }
+            traverse(child, near);
+            traverse(child, far);
+        };
+
+        if (isLeaf(query))
+        {
+            visitReference(query);
+            return;
+        }
+        int left = q.left, right = q.right;
+        if (isLeaf(reference))
+        {
+            traverse(left, reference);
+            traverse(right, reference);
+        }
+        else
+        {
+            visitReference(left);
+            visitReference(right);
+        }
+        nodes[query].bound = max(nodes[left].bound, nodes[right].bound);
+    }
+
+public:
+    explicit DualTreeBoruvka(const PointCloud &points)
+        : dims(points.dims), count(points.size()), order(points.size()), components(points.size()),
+          componentOf(points.size()), best(points.size())
+    {
+        iota(order.begin(), order.end(), 0);
+        if (count > 0)
+        {
+            build(points, 0, count);
+        }
+        coords.reserve(static_cast<size_t>(count) * dims);
+        for (int i = 0; i < count; i++)
+        {
+            coords.insert(coords.end(), points.point(order[i]), points.point(order[i]) + dims);
+        }
+    }
+
+    MST run(const PointCloud &points)
+    {
+        MST mst;
+        int remaining = count;
+        while (remaining > 1)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                componentOf[i] = components.find(i);
+                best[i] = {numeric_limits<double>::infinity(), -1, -1};
+            }
+            labelNodes();
+            traverse(0, 0);
+
+            // The candidates are the lightest edges leaving each component under a total order, so they form a forest
+            for (int c = 0; c < count; c++)
+            {
+                const Candidate &candidate = best[c];
+                if (candidate.u == -1 || components.find(candidate.u) == components.find(candidate.v))
+                {
+                    continue;
+                }
+                components.merge(candidate.u, candidate.v);
+                remaining--;
+
+                int u = order[candidate.u], v = order[candidate.v];
+                double length = points.distance(u, v);
+                int weight = static_cast<int>(llround(length));
+                mst.edges.push_back(Graph::Edge(min(u, v), max(u, v), weight));
+                mst.totalWeight += weight;
+            }
+        }
+        return mst;
+    }
+};
+
+/**
+ * Euclidean minimum spanning tree of a point cloud, with dual-tree Borůvka on a kd-tree
+ *
+ * The complete graph is never built. Each Borůvka round walks pairs of kd-tree nodes, skipping pairs whose
+ * points are all in the same component and pairs farther apart than the current candidates of the query node,
+ * so a round costs about O(n log n) instead of O(n^2). There are at most log n rounds.
+ *
+ * The tree is picked with the exact distances, the weights of the returned edges are the distances rounded to the
+ * nearest integer, use `treeLength` for the exact length.
+ *
+ * @param points The points to span, in any number of dimensions
+ * @return A `MST` object with the minimum spanning tree of the points
+ */
+MST euclidean_mst(const PointCloud &points)
+{
+    DualTreeBoruvka boruvka(points);
+    return boruvka.run(points);
+}
@@ -0,0 +1,76 @@
+#ifndef EMST_HPP
+#define EMST_HPP
+
+#include "graph.hpp"
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstddef>
+
+/**
+ * @brief A set of points with the same number of coordinates, stored point after point.
+ */
+struct PointCloud
+{
+    std::string name;           /**< The name from the file. */
+    int dims = 0;               /**< The number of coordinates of each point. */
+    std::vector<double> coords; /**< The coordinates, point `i` starts at `i * dims`. */
+
+    PointCloud() = default;
+    PointCloud(int dimensions, const std::string &cloudName = "") : name(cloudName), dims(dimensions) {}
+
+    /**
+     * @return The number of points.
+     */
+    int size() const
+    {
+        return dims > 0 ? coords.size() / dims : 0;
+    }
+
+    /**
+     * @return A pointer to the first coordinate of point `i`.
+     */
+    const double *point(int i) const
+    {
+        return coords.data() + static_cast<size_t>(i) * dims;
+    }
+
+    /**
+     * @brief Appends a point, `p` has to have `dims` coordinates.
+     */
+    void addPoint(const std::vector<double> &p)
+    {
+        coords.insert(coords.end(), p.begin(), p.end());
+    }
+
+    /**
+     * @return The Euclidean distance between points `i` and `j`.
+     */
+    double distance(int i, int j) const
+    {
+        double sum = 0;
+        for (int d = 0; d < dims; d++)
+        {
+            double delta = point(i)[d] - point(j)[d];
+            sum += delta * delta;
+        }
+        return std::sqrt(sum);
+    }
+};
+
+/**
+ * Loads a point cloud file, a name, then the number of points and of coordinates, then one point per line.
+ *
+ * @param file The path to the file containing the points.
+ * @return The loaded points, or an empty cloud if the file can not be read.
+ */
+PointCloud loadPointCloud(const std::string &file);
+
+/**
+ * @return The exact length of a tree over a point cloud, the edge weights of the `MST` are rounded.
+ */
+double treeLength(const PointCloud &points, const MST &mst);
+
+MST euclidean_mst(const PointCloud &points);
+
+#endif
@@ -0,0 +1,276 @@
+#include "euler_tour.hpp"
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+using namespace std;
+
+// The vertex nodes are created first, so vertex `v` is node `v`
+EulerTourForest::EulerTourForest(int vertices, unsigned seed) : state(seed * 2654435761u + 1)
+{
+    nodes.reserve(vertices);
+    for (int v = 0; v < vertices; v++)
+    {
+        newNode(v, true);
+    }
+}
+
+uint32_t EulerTourForest::nextPriority()
+{
+    // xorshift32, the priorities only need to look random
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+int EulerTourForest::newNode(int owner, bool vertex)
+{
+    int t;
+    if (!freeNodes.empty())
+    {
+        t = freeNodes.back();
+        freeNodes.pop_back();
+        nodes[t] = Node();
+    }
+    else
+    {
+        t = nodes.size();
+        nodes.emplace_back();
+    }
+    nodes[t].owner = owner;
+    nodes[t].vertex = vertex;
+    nodes[t].vertices = vertex ? 1 : 0;
+    nodes[t].priority = nextPriority();
+    return t;
+}
+
+void EulerTourForest::update(int t)
+{
+    Node &node = nodes[t];
+    node.count = 1;
+    node.vertices = node.vertex ? 1 : 0;
+    node.anyMark = node.mark;
+    node.minValue = node.value;
+    for (int child : {node.left, node.right})
+    {
+        if (child != -1)
+        {
+            node.count += nodes[child].count;
+            node.vertices += nodes[child].vertices;
+            node.anyMark = node.anyMark || nodes[child].anyMark;
+            node.minValue = min(node.minValue, nodes[child].minValue);
+        }
+    }
+}
+
+void EulerTourForest::updateUpward(int t)
+{
+    for (; t != -1; t = nodes[t].parent)
+    {
+        update(t);
+    }
+}
+
+int EulerTourForest::root(int t) const
+{
+    while (nodes[t].parent != -1)
+    {
+        t = nodes[t].parent;
+    }
+    return t;
+}
+
+/**
+ * @return The number of nodes before `t` in its sequence.
+ */
+int EulerTourForest::position(int t) const
+{
+    int index = count(nodes[t].left);
+    for (; nodes[t].parent != -1; t = nodes[t].parent)
+    {
+        int p = nodes[t].parent;
+        if (nodes[p].right == t)
+        {
+            index += count(nodes[p].left) + 1;
+        }
+    }
+    return index;
+}
+
+/**
+ * Splits the sequence of the treap `t` into its first `k` nodes and the rest.
+ */
+pair<int, int> EulerTourForest::split(int t, int k)
+{
+    if (t == -1)
+    {
+        return {-1, -1};
+    }
+    if (count(nodes[t].left) >= k)
+    {
+        auto [first, rest] = split(nodes[t].left, k);
+        nodes[t].left = rest;
+        if (rest != -1)
+        {
+            nodes[rest].parent = t;
+        }
+        if (first != -1)
+        {
+            nodes[first].parent = -1;
+        }
+        nodes[t].parent = -1;
+        update(t);
+        return {first, t};
+    }
+    auto [first, rest] = split(nodes[t].right, k - count(nodes[t].left) - 1);
+    nodes[t].right = first;
+    if (first != -1)
+    {
+        nodes[first].parent = t;
+    }
+    if (rest != -1)
+    {
+        nodes[rest].parent = -1;
+    }
+    nodes[t].parent = -1;
+    update(t);
+    return {t, rest};
+}
+
+/**
+ * Concatenates the sequences of the treaps `a` and `b`.
+ */
+int EulerTourForest::merge(int a, int b)
+{
+    if (a == -1 || b == -1)
+    {
+        return a == -1 ? b : a;
+    }
+    if (nodes[a].priority > nodes[b].priority)
+    {
+        int right = merge(nodes[a].right, b);
+        nodes[a].right = right;
+        nodes[right].parent = a;
+        update(a);
+        return a;
+    }
+    int left = merge(a, nodes[b].left);
+    nodes[b].left = left;
+    nodes[left].parent = b;
+    update(b);
+    return b;
+}
+
+/**
+ * Rotates the tour of the tree of `vertex` to start at it, and returns the new treap root.
+ */
+int EulerTourForest::reroot(int vertex)
+{
+    auto [before, after] = split(root(vertex), position(vertex));
+    return merge(after, before);
+}
+
+bool EulerTourForest::connected(int u, int v) const
+{
+    return u == v || root(u) == root(v);
+}
+
+int EulerTourForest::treeSize(int v) const
+{
+    return nodes[root(v)].vertices;
+}
+
+pair<int, int> EulerTourForest::link(int u, int v, int edge)
+{
+    int uTour = reroot(u);
+    int vTour = reroot(v);
+    int forward = newNode(edge, false);
+    int backward = newNode(edge, false);
+    merge(merge(merge(uTour, forward), vTour), backward);
+    return {forward, backward};
+}
+
+void EulerTourForest::cut(pair<int, int> arcs)
+{
+    auto [first, second] = arcs;
+    int firstIndex = position(first), secondIndex = position(second);
+    if (firstIndex > secondIndex)
+    {
+        swap(first, second);
+        swap(firstIndex, secondIndex);
+    }
+    // The tour is `before first inside second after`, the far side of the edge is `inside`
+    auto [before, rest] = split(root(first), firstIndex);
+    auto [firstArc, afterFirst] = split(rest, 1);
+    auto [inside, fromSecond] = split(afterFirst, secondIndex - firstIndex - 1);
+    auto [secondArc, after] = split(fromSecond, 1);
+    merge(before, after);
+    freeNodes.push_back(firstArc);
+    freeNodes.push_back(secondArc);
+}
+
+void EulerTourForest::setValue(int v, uint64_t value)
+{
+    if (nodes[v].value != value)
+    {
+        nodes[v].value = value;
+        updateUpward(v);
+    }
+}
+
+void EulerTourForest::setMark(int arc, bool mark)
+{
+    if (nodes[arc].mark != mark)
+    {
+        nodes[arc].mark = mark;
+        updateUpward(arc);
+    }
+}
+
+int EulerTourForest::minValueVertex(int v) const
+{
+    int t = root(v);
+    uint64_t target = nodes[t].minValue;
+    if (target == NONE)
+    {
+        return -1;
+    }
+    while (true)
+    {
+        const Node &node = nodes[t];
+        if (node.left != -1 && nodes[node.left].minValue == target)
+        {
+            t = node.left;
+        }
+        else if (node.value == target)
+        {
+            return node.owner;
+        }
+        else
+        {
+            t = node.right;
+        }
+    }
+}
+
+void EulerTourForest::collectMarks(int t, vector<int> &edges) const
+{
+    if (t == -1 || !nodes[t].anyMark)
+    {
+        return;
+    }
+    if (nodes[t].mark)
+    {
+        edges.push_back(nodes[t].owner);
+    }
+    collectMarks(nodes[t].left, edges);
+    collectMarks(nodes[t].right, edges);
+}
+
+vector<int> EulerTourForest::markedEdges(int v) const
+{
+    vector<int> edges;
+    collectMarks(root(v), edges);
+    return edges;
+}
@@ -0,0 +1,141 @@
+#ifndef EULER_TOUR_HPP
+#define EULER_TOUR_HPP
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <limits>
+
+/**
+ * @brief A forest kept as Euler tours in treaps, supporting link, cut and connectivity in O(log n) expected.
+ *
+ * Every tree is a cyclic sequence with one node per vertex and two arc nodes per edge, one for each direction.
+ * Rerooting rotates the sequence, linking splices two sequences with the two new arcs, and cutting splits out
+ * the part between the two arcs of the edge, which is the subtree on the far side.
+ *
+ * Each vertex can carry a value and each arc a mark, and the treaps keep the minimum value and whether a mark is
+ * present per subtree, so a whole tree can be searched for its smallest value or its marked arcs in O(log n) per
+ * result. The dynamic MSF uses one of these per level.
+ *
+ * A tour that starts at a vertex is a depth-first walk from it, so the positions of the arcs in it give the
+ * depth-first order of a tree rooted there.
+ */
+class EulerTourForest
+{
+public:
+    // The value of a vertex that has nothing to offer
+    static constexpr uint64_t NONE = std::numeric_limits<uint64_t>::max();
+
+private:
+    struct Node
+    {
+        int left = -1;
+        int right = -1;
+        int parent = -1;
+        uint32_t priority = 0;
+        // The number of nodes and of vertex nodes in the subtree
+        int count = 1;
+        int vertices = 0;
+        // The vertex of a vertex node, the edge of an arc node
+        int owner = -1;
+        bool vertex = false;
+        bool mark = false;
+        bool anyMark = false;
+        uint64_t value = NONE;
+        uint64_t minValue = NONE;
+    };
+    std::vector<Node> nodes;
+    std::vector<int> freeNodes;
+    uint32_t state;
+
+    uint32_t nextPriority();
+    int newNode(int owner, bool vertex);
+    int count(int t) const
+    {
+        return t == -1 ? 0 : nodes[t].count;
+    }
+    void update(int t);
+    void updateUpward(int t);
+    int root(int t) const;
+    int position(int t) const;
+    std::pair<int, int> split(int t, int k);
+    int merge(int a, int b);
+    int reroot(int vertex);
+    void collectMarks(int t, std::vector<int> &edges) const;
+
+public:
+    /**
+     * @param vertices The number of vertices, each starts as a tree of its own
+     * @param seed The seed of the treap priorities
+     */
+    explicit EulerTourForest(int vertices, unsigned seed = 1);
+
+    /**
+     * @return True if `u` and `v` are in the same tree.
+     */
+    bool connected(int u, int v) const;
+
+    /**
+     * @return The number of vertices in the tree of `v`.
+     */
+    int treeSize(int v) const;
+
+    /**
+     * @return A name for the tree of `v`, the same for all of its vertices until the forest changes.
+     */
+    int treeId(int v) const
+    {
+        return root(v);
+    }
+
+    /**
+     * @brief Rotates the tour of the tree of `vertex` to start at it. The part of the tour between the two arcs of
+     *        an edge is then the subtree below the edge.
+     */
+    void startTour(int vertex)
+    {
+        reroot(vertex);
+    }
+
+    /**
+     * @return The position of a vertex or of an arc node in the tour of its tree.
+     */
+    int tourPosition(int node) const
+    {
+        return position(node);
+    }
+
+    /**
+     * @brief Links the trees of `u` and `v`, which must be different, with the edge `edge`.
+     *
+     * @return The two arc nodes of the edge, which `cut` and `setMark` take
+     */
+    std::pair<int, int> link(int u, int v, int edge);
+
+    /**
+     * @brief Removes an edge, given the arc nodes `link` returned for it.
+     */
+    void cut(std::pair<int, int> arcs);
+
+    /**
+     * @brief Sets the value of a vertex, `NONE` clears it.
+     */
+    void setValue(int v, uint64_t value);
+
+    /**
+     * @brief Marks or unmarks an arc node.
+     */
+    void setMark(int arc, bool mark);
+
+    /**
+     * @return The vertex with the smallest value in the tree of `v`, or -1 if none has a value.
+     */
+    int minValueVertex(int v) const;
+
+    /**
+     * @return The edges of the marked arcs in the tree of `v`.
+     */
+    std::vector<int> markedEdges(int v) const;
+};
+
+#endif
@@ -0,0 +1,135 @@
+#include "graph.hpp"
+#include "forest.hpp"
+#include "kruskal.hpp"
+#include "prim.hpp"
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * Finds the connected components with a breadth first search over flat arrays
+ *
+ * The BFS queue is the `order` array itself, so each component's vertices end up next to each other.
+ *
+ * @param graph The graph to split
+ * @return The components of the graph
+ */
+Components connectedComponents(const Graph &graph)
+{
+    int verts = graph.vertNumber();
+    Components components;
+    components.label.assign(verts, -1);
+    components.local.assign(verts, 0);
+    components.order.reserve(verts);
+    components.offsets.push_back(0);
+
+    for (int root = 0; root < verts; root++)
+    {
+        if (components.label[root] != -1)
+        {
+            continue;
+        }
+        int c = components.count++;
+        int head = components.order.size();
+        components.label[root] = c;
+        components.order.push_back(root);
+
+        // Breadth first search, the unprocessed part of `order` is the queue
+        while (head < static_cast<int>(components.order.size()))
+        {
+            int u = components.order[head++];
+            components.local[u] = head - 1 - components.offsets[c];
+            for (const auto &[dest, weight] : graph.adjList[u])
+            {
+                if (components.label[dest] == -1)
+                {
+                    components.label[dest] = c;
+                    components.order.push_back(dest);
+                }
+            }
+        }
+        components.offsets.push_back(components.order.size());
+    }
+    return components;
+}
+
+/**
+ * Splits the edges of a spanning forest into one tree per component
+ *
+ * @param components The components of the graph the forest spans
+ * @param forest The forest, as returned by `kruskal_mst` or `prim_mst`
+ * @return The forest with its trees separated
+ */
+MSF splitForest(const Components &components, const MST &forest)
+{
+    MSF msf;
+    msf.trees.resize(components.count);
+    msf.component = components.label;
+    for (const auto &edge : forest.edges)
+    {
+        MST &tree = msf.trees[components.label[edge.src]];
+        tree.edges.push_back(edge);
+        tree.totalWeight += edge.weight;
+    }
+    msf.totalWeight = forest.totalWeight;
+    return msf;
+}
+
+/**
+ * Kruskal's Algorithm as a minimum spanning forest
+ *
+ * @param graph The graph to perform the algorithm on
+ * @return A `MSF` object with one tree per connected component
+ */
+MSF kruskal_msf(Graph &graph)
+{
+    return splitForest(connectedComponents(graph), kruskal_mst(graph));
+}
+
+/**
+ * Prim's Algorithm as a minimum spanning forest, with the components processed in parallel
+ *
+ * A connected components pass groups the vertices first, then each component's tree is grown on the pool with
+ * arrays and a heap the size of that component. The largest components are handed out first so a big one does
+ * not end up running alone at the end.
+ *
+ * @param graph The graph to perform the algorithm on
+ * @param pool The pool to run the components on
+ * @return A `MSF` object with one tree per connected component
+ */
+MSF prim_msf(Graph &graph, ThreadPool &pool)
+{
+    Components components = connectedComponents(graph);
+    MSF msf;
+    msf.trees.resize(components.count);
+    msf.component = components.label;
+
+    vector<int> bySize(components.count);
+    iota(bySize.begin(), bySize.end(), 0);
+    stable_sort(bySize.begin(), bySize.end(), [&](int a, int b)
+                { return components.size(a) > components.size(b); });
+
+    // Lots of tiny components are handed out in chunks, so the pool is not flooded with one vertex jobs
+    int grain = max(1, components.count / static_cast<int>(pool.size() * 8));
+    pool.parallelFor(0, components.count, [&](int i)
+                     {
+                         int c = bySize[i];
+                         int verts = components.size(c);
+                         if (verts == 1)
+                         {
+                             return;
+                         }
+                         const int *members = components.order.data() + components.offsets[c];
+                         IndexedDaryHeap<PRIM_HEAP_ARITY> heap(verts);
+                         msf.trees[c] = prim_grow(graph, 0, verts, heap, [&](int v)
+                                                  { return components.local[v]; }, [&](int local)
+                                                  { return members[local]; }); }, grain);
+
+    for (const auto &tree : msf.trees)
+    {
+        msf.totalWeight += tree.totalWeight;
+    }
+    return msf;
+}
@@ -0,0 +1,33 @@
+#ifndef FOREST_HPP
+#define FOREST_HPP
+
+#include "graph.hpp"
+#include "thread_pool.hpp"
+#include <vector>
+
+/**
+ * @brief The connected components of a graph, with the vertices grouped by component.
+ */
+struct Components
+{
+    int count = 0;            /**< The number of components. */
+    std::vector<int> label;   /**< The component of each vertex. */
+    std::vector<int> offsets; /**< The vertices of component `c` are `order[offsets[c]]` to `order[offsets[c + 1] - 1]`. */
+    std::vector<int> order;   /**< Every vertex, grouped by component. */
+    std::vector<int> local;   /**< The position of each vertex within its component's group. */
+
+    /**
+     * @return The number of vertices in component `c`.
+     */
+    int size(int c) const
+    {
+        return offsets[c + 1] - offsets[c];
+    }
+};
+
+Components connectedComponents(const Graph &graph);
+MSF splitForest(const Components &components, const MST &forest);
+MSF kruskal_msf(Graph &graph);
+MSF prim_msf(Graph &graph, ThreadPool &pool = sharedPool());
+
+#endif
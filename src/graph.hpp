@@ -8,6 +8,8 @@
 #include <set>
 #include <sstream>
 #include <algorithm>
+#include <tuple>
+#include <cstdint>
 
 /**
  * @brief Represents a graph data structure.
@@ -156,6 +158,79 @@ struct MST
     }
 };
 
+/**
+ * @brief Represents a minimum spanning forest (MSF), with one tree per connected component.
+ */
+struct MSF
+{
+    std::vector<MST> trees;     /**< The tree of each component, a lone vertex has a tree with no edges. */
+    std::vector<int> component; /**< The component of each vertex, an index into `trees`. */
+    int totalWeight = 0;        /**< The total weight of all of the trees. */
+
+    /**
+     * @return The number of connected components.
+     */
+    int componentCount() const
+    {
+        return trees.size();
+    }
+
+    /**
+     * @return All of the forest's edges as a single `MST` object.
+     */
+    MST merged() const
+    {
+        MST mst;
+        for (const auto &tree : trees)
+        {
+            mst.edges.insert(mst.edges.end(), tree.edges.begin(), tree.edges.end());
+        }
+        mst.totalWeight = totalWeight;
+        return mst;
+    }
+
+    /**
+     * @brief Prints the minimum spanning forest (MSF) information, skipping components with no edges.
+     */
+    void print() const
+    {
+        std::cout << "Minimum Spanning Forest (MSF) - Components: " << componentCount() << ", Total Weight: " << totalWeight << "\n";
+        for (size_t i = 0; i < trees.size(); i++)
+        {
+            if (!trees[i].edges.empty())
+            {
+                std::cout << "Component " << i << " - Weight: " << trees[i].totalWeight << ", Edges: " << trees[i].edges.size() << "\n";
+            }
+        }
+    }
+};
+
+/**
+ * Packs an edge's weight and id into one key that orders by weight, then by id.
+ * The parallel engines use it to agree on a single lightest edge with an atomic min.
+ *
+ * @param weight The weight of the edge.
+ * @param id The id of the edge, used to break ties.
+ * @return The packed key.
+ */
+inline uint64_t edgeRank(int weight, int id)
+{
+    // Flip the sign bit so negative weights still order correctly as unsigned numbers
+    return (static_cast<uint64_t>(static_cast<uint32_t>(weight) ^ 0x80000000u) << 32) | static_cast<uint32_t>(id);
+}
+
+/**
+ * Packs the endpoints of an edge into one key, the same for both directions.
+ *
+ * @param u One endpoint.
+ * @param v The other endpoint.
+ * @return The packed key.
+ */
+inline uint64_t endpointKey(int u, int v)
+{
+    return (static_cast<uint64_t>(std::min(u, v)) << 32) | static_cast<uint32_t>(std::max(u, v));
+}
+
 /**
  * Serializes the Minimum Spanning Tree (MST) into a string representation.
  * 
@@ -242,6 +317,78 @@ inline Graph loadGraphFromFile(const std::string &file)
 }
 
 
+/**
+ * @brief One line of an update log, an insertion or a deletion of an edge.
+ */
+struct EdgeUpdate
+{
+    bool insert;        /**< True to insert the edge, false to delete one edge between the endpoints. */
+    int u;              /**< One endpoint. */
+    int v;              /**< The other endpoint. */
+    int weight;         /**< The weight of an inserted edge. */
+    long long time = 0; /**< When the update happens, the updates of one time form one step. */
+};
+
+/**
+ * Loads an update log, one update per line: `+ u v w` inserts an edge, `- u v` deletes one and `= u v w` changes
+ * its weight, which is read as a deletion and an insertion at the same time. A line can start with a timestamp,
+ * as in `12 + u v w`, otherwise its time is its index in the log.
+ *
+ * @param file The path to the log
+ * @return The updates in order, the lines that can not be read are skipped
+ */
+inline std::vector<EdgeUpdate> loadUpdateLog(const std::string &file)
+{
+    std::vector<EdgeUpdate> updates;
+    std::ifstream inputFile(file);
+    if (!inputFile)
+    {
+        std::cerr << "Error loading update log.";
+        return updates;
+    }
+    std::string line;
+    while (std::getline(inputFile, line))
+    {
+        std::istringstream fields(line);
+        std::string operation;
+        EdgeUpdate update{true, 0, 0, 0, static_cast<long long>(updates.size())};
+        if (!(fields >> operation))
+        {
+            continue;
+        }
+        if (operation != "+" && operation != "-" && operation != "=")
+        {
+            std::istringstream stamp(operation);
+            if (!(stamp >> update.time) || !(fields >> operation))
+            {
+                continue;
+            }
+        }
+        if (!(fields >> update.u >> update.v))
+        {
+            continue;
+        }
+        if (operation == "+" && fields >> update.weight)
+        {
+            updates.push_back(update);
+        }
+        else if (operation == "-")
+        {
+            update.insert = false;
+            updates.push_back(update);
+        }
+        else if (operation == "=" && fields >> update.weight)
+        {
+            EdgeUpdate removal = update;
+            removal.insert = false;
+            updates.push_back(removal);
+            updates.push_back(update);
+        }
+    }
+    return updates;
+}
+
+
 /**
  * Generates a Graphviz representation of the Minimum Spanning Tree (MST) of a given graph.
  * The generated representation can be used to visualize the MST using Graphviz tools.
@@ -0,0 +1,853 @@
+#ifndef HEAP_HPP
+#define HEAP_HPP
+
+#include <vector>
+#include <climits>
+
+/*
+ * Every heap in this file is a priority queue policy for `prim_mst_queue`. They all hold the vertex ids `0..n-1`
+ * and share the same interface: `empty()`, `contains(v)`, `push(v, key)`, `decreaseKey(v, key)` and `popMin()`.
+ * The bucket and radix queues also take the largest key they will see, and only accept non-negative keys.
+ */
+
+/**
+ * @brief An indexed d-ary min heap over the vertex ids `0..n-1`.
+ *
+ * Every vertex can be in the heap at most once, and a position index is kept for each vertex
+ * so that its key can be lowered in place. This keeps the heap bounded by the number of vertices,
+ * instead of the number of edges like a lazy heap.
+ *
+ * @tparam Arity The number of children of each heap node, fixed at compile time.
+ */
+template <int Arity>
+class IndexedDaryHeap
+{
+    static_assert(Arity >= 2, "A heap needs at least two children per node");
+
+private:
+    /**
+     * @brief A single heap slot, the key is stored next to the vertex so sifting never leaves the heap array.
+     */
+    struct Entry
+    {
+        int key;    /**< The priority of the vertex. */
+        int vertex; /**< The vertex id. */
+    };
+
+    // The heap itself, stored as an implicit d-ary tree
+    std::vector<Entry> heap;
+    // The position of each vertex in the heap, or -1 if it is not in the heap
+    std::vector<int> position;
+
+    /**
+     * Moves the entry at index `i` up until its parent is smaller.
+     */
+    void siftUp(int i)
+    {
+        Entry entry = heap[i];
+        while (i > 0)
+        {
+            int parent = (i - 1) / Arity;
+            if (heap[parent].key <= entry.key)
+            {
+                break;
+            }
+            heap[i] = heap[parent];
+            position[heap[i].vertex] = i;
+            i = parent;
+        }
+        heap[i] = entry;
+        position[entry.vertex] = i;
+    }
+
+    /**
+     * Moves the entry at index `i` down until all of its children are larger.
+     */
+    void siftDown(int i)
+    {
+        Entry entry = heap[i];
+        int size = heap.size();
+        while (true)
+        {
+            int first = i * Arity + 1;
+            if (first >= size)
+            {
+                break;
+            }
+            // Find the smallest child
+            int last = first + Arity < size ? first + Arity : size;
+            int smallest = first;
+            for (int child = first + 1; child < last; child++)
+            {
+                if (heap[child].key < heap[smallest].key)
+                {
+                    smallest = child;
+                }
+            }
+            if (entry.key <= heap[smallest].key)
+            {
+                break;
+            }
+            heap[i] = heap[smallest];
+            position[heap[i].vertex] = i;
+            i = smallest;
+        }
+        heap[i] = entry;
+        position[entry.vertex] = i;
+    }
+
+public:
+    /**
+     * @brief Constructs an empty heap that can hold the vertices `0..n-1`.
+     *
+     * @param n The number of vertices.
+     */
+    explicit IndexedDaryHeap(int n) : position(n, -1)
+    {
+        heap.reserve(n);
+    }
+
+    /**
+     * @return True if there are no vertices in the heap.
+     */
+    bool empty() const
+    {
+        return heap.empty();
+    }
+
+    /**
+     * @return The number of vertices in the heap.
+     */
+    int size() const
+    {
+        return heap.size();
+    }
+
+    /**
+     * @param v The vertex to check.
+     * @return True if the vertex is currently in the heap.
+     */
+    bool contains(int v) const
+    {
+        return position[v] != -1;
+    }
+
+    /**
+     * @param v A vertex that is in the heap.
+     * @return The current key of the vertex.
+     */
+    int key(int v) const
+    {
+        return heap[position[v]].key;
+    }
+
+    /**
+     * @brief Inserts a vertex that is not already in the heap.
+     *
+     * @param v The vertex to insert.
+     * @param priority The key of the vertex.
+     */
+    void push(int v, int priority)
+    {
+        heap.push_back({priority, v});
+        siftUp(heap.size() - 1);
+    }
+
+    /**
+     * @brief Lowers the key of a vertex that is already in the heap.
+     *
+     * @param v The vertex to update.
+     * @param priority The new key, which must not be larger than the current one.
+     */
+    void decreaseKey(int v, int priority)
+    {
+        int i = position[v];
+        heap[i].key = priority;
+        siftUp(i);
+    }
+
+    /**
+     * @brief Removes the vertex with the smallest key.
+     *
+     * @return The removed vertex.
+     */
+    int popMin()
+    {
+        int top = heap[0].vertex;
+        position[top] = -1;
+        Entry last = heap.back();
+        heap.pop_back();
+        if (!heap.empty())
+        {
+            heap[0] = last;
+            siftDown(0);
+        }
+        return top;
+    }
+
+    /**
+     * @brief Removes every vertex from the heap, in time proportional to its size.
+     */
+    void clear()
+    {
+        for (const auto &entry : heap)
+        {
+            position[entry.vertex] = -1;
+        }
+        heap.clear();
+    }
+};
+
+/**
+ * @brief The classic indexed binary heap.
+ */
+using BinaryHeap = IndexedDaryHeap<2>;
+
+/**
+ * @brief An indexed pairing heap over the vertex ids `0..n-1`.
+ *
+ * Each vertex owns one node, stored in flat arrays. A node links to its first child and to its next sibling,
+ * and `prev` points at the previous sibling, or at the parent for a first child.
+ * Insert and decrease-key are O(1), delete-min is O(log n) amortized.
+ */
+class PairingHeap
+{
+private:
+    std::vector<int> keys;
+    std::vector<int> child;
+    std::vector<int> sibling;
+    std::vector<int> prev;
+    std::vector<char> inHeap;
+    // Scratch space for the first pass of delete-min
+    std::vector<int> pairs;
+    int root = -1;
+    int count = 0;
+
+    /**
+     * Links two root nodes, the larger one becomes the first child of the smaller one.
+     */
+    int meld(int a, int b)
+    {
+        if (a == -1)
+            return b;
+        if (b == -1)
+            return a;
+        if (keys[b] < keys[a])
+        {
+            int temp = a;
+            a = b;
+            b = temp;
+        }
+        sibling[b] = child[a];
+        if (child[a] != -1)
+        {
+            prev[child[a]] = b;
+        }
+        prev[b] = a;
+        child[a] = b;
+        sibling[a] = -1;
+        prev[a] = -1;
+        return a;
+    }
+
+    /**
+     * Removes a node and its subtree from its parent or sibling list.
+     */
+    void detach(int v)
+    {
+        if (child[prev[v]] == v)
+            child[prev[v]] = sibling[v];
+        else
+            sibling[prev[v]] = sibling[v];
+        if (sibling[v] != -1)
+        {
+            prev[sibling[v]] = prev[v];
+        }
+        sibling[v] = -1;
+        prev[v] = -1;
+    }
+
+public:
+    explicit PairingHeap(int n) : keys(n), child(n, -1), sibling(n, -1), prev(n, -1), inHeap(n, 0) {}
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    int size() const
+    {
+        return count;
+    }
+
+    bool contains(int v) const
+    {
+        return inHeap[v];
+    }
+
+    void push(int v, int priority)
+    {
+        keys[v] = priority;
+        child[v] = sibling[v] = prev[v] = -1;
+        inHeap[v] = 1;
+        count++;
+        root = meld(root, v);
+    }
+
+    void decreaseKey(int v, int priority)
+    {
+        keys[v] = priority;
+        if (v != root)
+        {
+            detach(v);
+            root = meld(root, v);
+        }
+    }
+
+    int popMin()
+    {
+        int top = root;
+        inHeap[top] = 0;
+        count--;
+
+        // First pass, meld the children in pairs from left to right
+        pairs.clear();
+        int current = child[top];
+        while (current != -1)
+        {
+            int first = current;
+            int second = sibling[first];
+            current = second == -1 ? -1 : sibling[second];
+            sibling[first] = prev[first] = -1;
+            if (second != -1)
+            {
+                sibling[second] = prev[second] = -1;
+            }
+            pairs.push_back(meld(first, second));
+        }
+
+        // Second pass, meld the pairs from right to left
+        root = -1;
+        for (auto it = pairs.rbegin(); it != pairs.rend(); ++it)
+        {
+            root = meld(*it, root);
+        }
+        child[top] = -1;
+        return top;
+    }
+};
+
+/**
+ * @brief An indexed Fibonacci heap over the vertex ids `0..n-1`.
+ *
+ * Each vertex owns one node, stored in flat arrays, and the sibling lists are circular and doubly linked.
+ * Insert and decrease-key are O(1) amortized, delete-min is O(log n) amortized.
+ */
+class FibonacciHeap
+{
+private:
+    std::vector<int> keys;
+    std::vector<int> parent;
+    std::vector<int> child;
+    std::vector<int> left;
+    std::vector<int> right;
+    std::vector<int> degree;
+    std::vector<char> marked;
+    std::vector<char> inHeap;
+    // Scratch space for consolidation, the current roots and the roots indexed by degree
+    std::vector<int> roots;
+    std::vector<int> byDegree;
+    int minRoot = -1;
+    int count = 0;
+
+    /**
+     * Splices a single node into the root list next to the minimum.
+     */
+    void addRoot(int v)
+    {
+        parent[v] = -1;
+        marked[v] = 0;
+        if (minRoot == -1)
+        {
+            left[v] = right[v] = v;
+            minRoot = v;
+            return;
+        }
+        left[v] = minRoot;
+        right[v] = right[minRoot];
+        left[right[minRoot]] = v;
+        right[minRoot] = v;
+        if (keys[v] < keys[minRoot])
+        {
+            minRoot = v;
+        }
+    }
+
+    /**
+     * Removes a node from whichever circular list it is in.
+     */
+    void unlink(int v)
+    {
+        right[left[v]] = right[v];
+        left[right[v]] = left[v];
+        left[v] = right[v] = v;
+    }
+
+    /**
+     * Makes root `b` a child of root `a`.
+     */
+    void link(int b, int a)
+    {
+        unlink(b);
+        parent[b] = a;
+        marked[b] = 0;
+        if (child[a] == -1)
+        {
+            child[a] = b;
+        }
+        else
+        {
+            left[b] = child[a];
+            right[b] = right[child[a]];
+            left[right[child[a]]] = b;
+            right[child[a]] = b;
+        }
+        degree[a]++;
+    }
+
+    /**
+     * Cuts a node from its parent and moves it to the root list.
+     */
+    void cut(int v)
+    {
+        int p = parent[v];
+        if (right[v] == v)
+            child[p] = -1;
+        else if (child[p] == v)
+            child[p] = right[v];
+        unlink(v);
+        degree[p]--;
+        addRoot(v);
+    }
+
+    /**
+     * Merges roots of equal degree until every root has a different degree.
+     */
+    void consolidate()
+    {
+        roots.clear();
+        int v = minRoot;
+        do
+        {
+            roots.push_back(v);
+            v = right[v];
+        } while (v != minRoot);
+
+        for (int root : roots)
+        {
+            int x = root;
+            int d = degree[x];
+            while (byDegree[d] != -1)
+            {
+                int y = byDegree[d];
+                if (keys[y] < keys[x])
+                {
+                    int temp = x;
+                    x = y;
+                    y = temp;
+                }
+                link(y, x);
+                byDegree[d] = -1;
+                d++;
+            }
+            byDegree[d] = x;
+        }
+
+        // Rebuild the root list from the degree table
+        minRoot = -1;
+        for (int &slot : byDegree)
+        {
+            if (slot != -1)
+            {
+                left[slot] = right[slot] = slot;
+                addRoot(slot);
+                slot = -1;
+            }
+        }
+    }
+
+public:
+    explicit FibonacciHeap(int n)
+        : keys(n), parent(n, -1), child(n, -1), left(n), right(n), degree(n, 0), marked(n, 0), inHeap(n, 0),
+          byDegree(64, -1) {}
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    int size() const
+    {
+        return count;
+    }
+
+    bool contains(int v) const
+    {
+        return inHeap[v];
+    }
+
+    void push(int v, int priority)
+    {
+        keys[v] = priority;
+        child[v] = -1;
+        degree[v] = 0;
+        inHeap[v] = 1;
+        count++;
+        addRoot(v);
+    }
+
+    void decreaseKey(int v, int priority)
+    {
+        keys[v] = priority;
+        int p = parent[v];
+        if (p != -1 && keys[v] < keys[p])
+        {
+            // Cascading cut, walk up while the parents have already lost a child
+            cut(v);
+            while (parent[p] != -1)
+            {
+                if (!marked[p])
+                {
+                    marked[p] = 1;
+                    break;
+                }
+                int grandparent = parent[p];
+                cut(p);
+                p = grandparent;
+            }
+        }
+        if (keys[v] < keys[minRoot])
+        {
+            minRoot = v;
+        }
+    }
+
+    int popMin()
+    {
+        int top = minRoot;
+        inHeap[top] = 0;
+        count--;
+
+        // Move every child of the minimum to the root list
+        while (child[top] != -1)
+        {
+            int c = child[top];
+            if (right[c] == c)
+                child[top] = -1;
+            else
+                child[top] = right[c];
+            unlink(c);
+            parent[c] = -1;
+            marked[c] = 0;
+            left[c] = minRoot;
+            right[c] = right[minRoot];
+            left[right[minRoot]] = c;
+            right[minRoot] = c;
+        }
+        degree[top] = 0;
+
+        if (right[top] == top)
+        {
+            minRoot = -1;
+        }
+        else
+        {
+            minRoot = right[top];
+            unlink(top);
+            consolidate();
+        }
+        return top;
+    }
+};
+
+/**
+ * @brief A bucket queue (Dial's algorithm) for small non-negative integer keys.
+ *
+ * There is one doubly linked bucket per key value, so insert and decrease-key are O(1). The scan for the
+ * minimum moves forward from a cursor. Prim's keys are not monotone, a vertex next to the newest tree vertex
+ * can get a key below the last one extracted, so the cursor moves back when that happens.
+ */
+class BucketQueue
+{
+private:
+    std::vector<int> keys;
+    std::vector<int> next;
+    std::vector<int> prev;
+    std::vector<int> heads;
+    std::vector<char> inQueue;
+    int cursor = 0;
+    int count = 0;
+
+    void insert(int v)
+    {
+        int k = keys[v];
+        prev[v] = -1;
+        next[v] = heads[k];
+        if (heads[k] != -1)
+        {
+            prev[heads[k]] = v;
+        }
+        heads[k] = v;
+        if (k < cursor)
+        {
+            cursor = k;
+        }
+    }
+
+    void remove(int v)
+    {
+        if (prev[v] != -1)
+            next[prev[v]] = next[v];
+        else
+            heads[keys[v]] = next[v];
+        if (next[v] != -1)
+        {
+            prev[next[v]] = prev[v];
+        }
+    }
+
+public:
+    // There is one bucket per key, so huge weight ranges would allocate gigabytes
+    static constexpr int MAX_KEY = 1 << 24;
+
+    /**
+     * @return True if every key in `[minKey, maxKey]` has a bucket.
+     */
+    static bool acceptsKeys(int minKey, int maxKey)
+    {
+        return minKey >= 0 && maxKey <= MAX_KEY;
+    }
+
+    /**
+     * @param n The number of vertices.
+     * @param maxKey The largest key that will be pushed, at most `MAX_KEY`.
+     */
+    BucketQueue(int n, int maxKey) : keys(n), next(n, -1), prev(n, -1), heads(maxKey + 1, -1), inQueue(n, 0) {}
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    int size() const
+    {
+        return count;
+    }
+
+    bool contains(int v) const
+    {
+        return inQueue[v];
+    }
+
+    void push(int v, int priority)
+    {
+        keys[v] = priority;
+        inQueue[v] = 1;
+        count++;
+        insert(v);
+    }
+
+    void decreaseKey(int v, int priority)
+    {
+        remove(v);
+        keys[v] = priority;
+        insert(v);
+    }
+
+    int popMin()
+    {
+        while (heads[cursor] == -1)
+        {
+            cursor++;
+        }
+        int top = heads[cursor];
+        remove(top);
+        inQueue[top] = 0;
+        count--;
+        return top;
+    }
+};
+
+/**
+ * @brief A radix heap for non-negative integer keys.
+ *
+ * Bucket `i` holds the keys whose highest bit that differs from the last extracted key is bit `i - 1`, and
+ * bucket 0 holds keys equal to it. Only the first non-empty bucket is ever redistributed, and every key moves
+ * to a lower bucket when it is, so each key is touched O(log C) times.
+ *
+ * A radix heap needs every key to be at least the last one extracted, which Prim only guarantees for keys
+ * on the current cut. Keys that fall below it go to a small binary heap that is always drained first,
+ * since everything in it is smaller than everything in the buckets.
+ */
+class RadixHeap
+{
+private:
+    static constexpr int BUCKETS = 33;
+    // The bucket a vertex is in, or UNDERFLOW, or -1 if it is not in the heap
+    static constexpr int UNDERFLOW = BUCKETS;
+
+    std::vector<int> keys;
+    std::vector<int> next;
+    std::vector<int> prev;
+    std::vector<int> where;
+    int heads[BUCKETS];
+    BinaryHeap underflow;
+    unsigned last = 0;
+    int count = 0;
+
+    static int bucketFor(unsigned key, unsigned base)
+    {
+        if (key == base)
+        {
+            return 0;
+        }
+        // The position of the highest differing bit, plus one
+        return 32 - __builtin_clz(key ^ base);
+    }
+
+    void insert(int v)
+    {
+        if (static_cast<unsigned>(keys[v]) < last)
+        {
+            where[v] = UNDERFLOW;
+            underflow.push(v, keys[v]);
+            return;
+        }
+        int b = bucketFor(keys[v], last);
+        where[v] = b;
+        prev[v] = -1;
+        next[v] = heads[b];
+        if (heads[b] != -1)
+        {
+            prev[heads[b]] = v;
+        }
+        heads[b] = v;
+    }
+
+    void remove(int v)
+    {
+        int b = where[v];
+        if (prev[v] != -1)
+            next[prev[v]] = next[v];
+        else
+            heads[b] = next[v];
+        if (next[v] != -1)
+        {
+            prev[next[v]] = prev[v];
+        }
+    }
+
+public:
+    /**
+     * @return True if the keys can be compared as unsigned, which needs them all non-negative.
+     */
+    static bool acceptsKeys(int minKey, int maxKey)
+    {
+        (void)maxKey;
+        return minKey >= 0;
+    }
+
+    /**
+     * @param n The number of vertices.
+     * @param maxKey The largest key that will be pushed, unused since the buckets cover every 32 bit key.
+     */
+    RadixHeap(int n, int maxKey = INT_MAX) : keys(n), next(n, -1), prev(n, -1), where(n, -1), underflow(n)
+    {
+        (void)maxKey;
+        for (int &head : heads)
+        {
+            head = -1;
+        }
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    int size() const
+    {
+        return count;
+    }
+
+    bool contains(int v) const
+    {
+        return where[v] != -1;
+    }
+
+    void push(int v, int priority)
+    {
+        keys[v] = priority;
+        count++;
+        insert(v);
+    }
+
+    void decreaseKey(int v, int priority)
+    {
+        keys[v] = priority;
+        if (where[v] == UNDERFLOW)
+        {
+            underflow.decreaseKey(v, priority);
+            return;
+        }
+        remove(v);
+        insert(v);
+    }
+
+    int popMin()
+    {
+        count--;
+        if (!underflow.empty())
+        {
+            int top = underflow.popMin();
+            where[top] = -1;
+            return top;
+        }
+
+        if (heads[0] == -1)
+        {
+            // Find the first non-empty bucket and its smallest key
+            int b = 1;
+            while (heads[b] == -1)
+            {
+                b++;
+            }
+            unsigned smallest = UINT_MAX;
+            for (int v = heads[b]; v != -1; v = next[v])
+            {
+                if (static_cast<unsigned>(keys[v]) < smallest)
+                {
+                    smallest = keys[v];
+                }
+            }
+
+            // Redistribute the bucket relative to the new minimum
+            last = smallest;
+            int v = heads[b];
+            heads[b] = -1;
+            while (v != -1)
+            {
+                int following = next[v];
+                insert(v);
+                v = following;
+            }
+        }
+
+        int top = heads[0];
+        remove(top);
+        where[top] = -1;
+        return top;
+    }
+};
+
+#endif
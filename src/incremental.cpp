@@ -0,0 +1,88 @@
+#include "graph.hpp"
+#include "incremental.hpp"
+#include <vector>
+#include <iostream>
+
+using namespace std;
+
+IncrementalMST::IncrementalMST(int vertices, const MST &initial) : verts(vertices), tree(vertices)
+{
+    for (const auto &edge : initial.edges)
+    {
+        insertEdge(edge.src, edge.dest, edge.weight);
+    }
+}
+
+void IncrementalMST::addTreeEdge(int u, int v, int w)
+{
+    uint64_t key = edgeRank(w, nextId++);
+    int slot;
+    if (!freeSlots.empty())
+    {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        tree.resetNode(verts + slot, true, key);
+        slots[slot] = Graph::Edge(u, v, w);
+        used[slot] = 1;
+    }
+    else
+    {
+        slot = slots.size();
+        tree.addNode(true, key);
+        slots.emplace_back(u, v, w);
+        used.push_back(1);
+    }
+    tree.link(u, verts + slot);
+    tree.link(verts + slot, v);
+    weight += w;
+    edgeTotal++;
+}
+
+bool IncrementalMST::insertEdge(int u, int v, int w)
+{
+    if (u < 0 || v < 0 || u >= verts || v >= verts)
+    {
+        cerr << "Edge " << u << " " << v << " is out of range." << endl;
+        return false;
+    }
+    if (u == v)
+    {
+        return false;
+    }
+    if (!tree.connected(u, v))
+    {
+        addTreeEdge(u, v, w);
+        return true;
+    }
+
+    int heaviest = tree.pathMax(u, v);
+    int slot = heaviest - verts;
+    // A new edge always has the largest id, so it only wins with a strictly smaller weight
+    if (heaviest == -1 || slots[slot].weight <= w)
+    {
+        return false;
+    }
+    const Graph::Edge old = slots[slot];
+    tree.cut(old.src, heaviest);
+    tree.cut(heaviest, old.dest);
+    used[slot] = 0;
+    freeSlots.push_back(slot);
+    weight -= old.weight;
+    edgeTotal--;
+    addTreeEdge(u, v, w);
+    return true;
+}
+
+MST IncrementalMST::mst() const
+{
+    MST forest;
+    for (size_t slot = 0; slot < slots.size(); slot++)
+    {
+        if (used[slot])
+        {
+            forest.edges.push_back(slots[slot]);
+            forest.totalWeight += slots[slot].weight;
+        }
+    }
+    return forest;
+}
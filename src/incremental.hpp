@@ -0,0 +1,86 @@
+#ifndef INCREMENTAL_HPP
+#define INCREMENTAL_HPP
+
+#include "graph.hpp"
+#include "link_cut_tree.hpp"
+#include <vector>
+
+/**
+ * @brief A minimum spanning forest that stays minimal as edges are inserted, in O(log V) amortized per edge.
+ *
+ * The forest lives in a link-cut tree, with every tree edge as a node between its endpoints. A new edge between
+ * two trees is linked. A new edge inside a tree closes a cycle, and the forest stays minimal by dropping the
+ * heaviest edge of that cycle, which is the new edge or the heaviest edge on the tree path between its endpoints.
+ * Equal weights keep the older edge.
+ */
+class IncrementalMST
+{
+private:
+    int verts;
+    LinkCutTree tree;
+    // The edge of every edge node, node `verts + i` is slot `i`
+    std::vector<Graph::Edge> slots;
+    std::vector<char> used;
+    std::vector<int> freeSlots;
+    int nextId = 0;
+    long long weight = 0;
+    int edgeTotal = 0;
+
+    void addTreeEdge(int u, int v, int w);
+
+public:
+    /**
+     * @param vertices The number of vertices
+     * @param initial A minimum spanning forest of the edges so far, empty to start from no edges
+     */
+    explicit IncrementalMST(int vertices, const MST &initial = MST());
+
+    /**
+     * Inserts an edge and updates the forest.
+     *
+     * @param u One endpoint
+     * @param v The other endpoint
+     * @param w The weight
+     * @return True if the edge joined the forest
+     */
+    bool insertEdge(int u, int v, int w);
+
+    /**
+     * @return The total weight of the forest.
+     */
+    long long totalWeight() const
+    {
+        return weight;
+    }
+
+    /**
+     * @return The number of edges in the forest.
+     */
+    int edgeCount() const
+    {
+        return edgeTotal;
+    }
+
+    /**
+     * @return The number of trees in the forest, counting lone vertices.
+     */
+    int componentCount() const
+    {
+        return verts - edgeTotal;
+    }
+
+    /**
+     * @return The number of vertices.
+     */
+    int vertNumber() const
+    {
+        return verts;
+    }
+
+    /**
+     * @return The forest as a `MST` object, in O(V).
+     */
+    MST mst() const;
+};
+
+#endif
@@ -0,0 +1,407 @@
+#include "graph.hpp"
+#include "kkt.hpp"
+#include "kruskal.hpp"
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+
+using namespace std;
+
+/**
+ * An edge of a KKT subproblem
+ *
+ * `rank` orders the edges by weight with the original index as the tie break, so no two edges compare equal, and
+ * `slot` is the index of the edge in the edge list the current subproblem was called with.
+ */
+struct KktEdge
+{
+    int u;
+    int v;
+    uint64_t rank;
+    int slot;
+};
+
+/**
+ * The state shared by every level of the recursion, the original edges and the random source.
+ */
+class KktSolver
+{
+private:
+    const vector<Graph::Edge> &original;
+    mt19937 random;
+
+    // Scratch space for the path compression of `find`
+    vector<int> path;
+
+    /**
+     * One Borůvka step, every vertex picks its lightest edge, the picked edges are contracted and the edges that
+     * end up inside a vertex are dropped.
+     *
+     * @param verts The number of vertices
+     * @param edges The edges, relabelled to the contracted vertices in place
+     * @param forest The slots of the picked edges are appended here
+     * @return The number of vertices after the contraction that still have an edge
+     */
+    int boruvkaStep(int verts, vector<KktEdge> &edges, vector<int> &forest)
+    {
+        vector<int> lightest(verts, -1);
+        for (int i = 0; i < static_cast<int>(edges.size()); i++)
+        {
+            for (int side : {edges[i].u, edges[i].v})
+            {
+                if (lightest[side] == -1 || edges[i].rank < edges[lightest[side]].rank)
+                {
+                    lightest[side] = i;
+                }
+            }
+        }
+
+        // The ranks are distinct, so the picked edges form a forest, an edge picked by both ends is added once
+        UnionFind components(verts);
+        for (int v = 0; v < verts; v++)
+        {
+            if (lightest[v] == -1)
+            {
+                continue;
+            }
+            const KktEdge &edge = edges[lightest[v]];
+            if (components.find(edge.u) != components.find(edge.v))
+            {
+                components.merge(edge.u, edge.v);
+                forest.push_back(edge.slot);
+            }
+        }
+
+        vector<int> label(verts, -1);
+        int count = 0;
+        for (int v = 0; v < verts; v++)
+        {
+            int root = components.find(v);
+            if (label[root] == -1)
+            {
+                label[root] = count++;
+            }
+            label[v] = label[root];
+        }
+
+        // Vertices left without edges are done, so only the ones that still have an edge are numbered again
+        vector<int> compact(count, -1);
+        int remaining = 0;
+        size_t kept = 0;
+        for (const KktEdge &edge : edges)
+        {
+            int u = label[edge.u];
+            int v = label[edge.v];
+            if (u != v)
+            {
+                for (int *end : {&u, &v})
+                {
+                    if (compact[*end] == -1)
+                    {
+                        compact[*end] = remaining++;
+                    }
+                    *end = compact[*end];
+                }
+                edges[kept++] = {u, v, edge.rank, edge.slot};
+            }
+        }
+        edges.resize(kept);
+        return remaining;
+    }
+
+    /**
+     * Finds the representative of `x` and compresses the path, leaving in `up[x]` the heaviest rank between `x`
+     * and the representative.
+     */
+    int find(vector<int> &parent, vector<uint64_t> &up, int x)
+    {
+        int root = x;
+        while (parent[root] != root)
+        {
+            root = parent[root];
+        }
+        path.clear();
+        for (int y = x; y != root && parent[y] != root; y = parent[y])
+        {
+            path.push_back(y);
+        }
+        // From the top down, so the parent of each vertex already holds its maximum up to the root
+        for (int k = static_cast<int>(path.size()) - 1; k >= 0; k--)
+        {
+            int y = path[k];
+            up[y] = max(up[y], up[parent[y]]);
+            parent[y] = root;
+        }
+        return root;
+    }
+
+    /**
+     * Drops the F-heavy edges, the ones heavier than every edge on the path between their ends in `forest`.
+     *
+     * The path maxima come from Tarjan's offline LCA on the forest. Each query is filed under its LCA when its
+     * second end is reached, and answered when the LCA is finished, at which point the union find holds the
+     * heaviest rank from both ends up to the LCA. That is O((V + E) α) rather than truly linear, but it needs
+     * none of the table machinery of the linear time verification algorithms.
+     *
+     * @param verts The number of vertices
+     * @param edges The edges to filter, in place
+     * @param forest A spanning forest over the same vertices
+     */
+    void dropHeavy(int verts, vector<KktEdge> &edges, const vector<KktEdge> &forest)
+    {
+        int m = edges.size();
+
+        // CSR adjacency of the forest, and of the queries
+        vector<int> treeStart(verts + 1, 0), queryStart(verts + 1, 0);
+        for (const KktEdge &edge : forest)
+        {
+            treeStart[edge.u + 1]++;
+            treeStart[edge.v + 1]++;
+        }
+        for (const KktEdge &edge : edges)
+        {
+            queryStart[edge.u + 1]++;
+            queryStart[edge.v + 1]++;
+        }
+        for (int v = 0; v < verts; v++)
+        {
+            treeStart[v + 1] += treeStart[v];
+            queryStart[v + 1] += queryStart[v];
+        }
+        vector<pair<int, uint64_t>> tree(treeStart[verts]);
+        vector<int> queries(queryStart[verts]);
+        {
+            vector<int> treeNext(treeStart.begin(), treeStart.end() - 1);
+            vector<int> queryNext(queryStart.begin(), queryStart.end() - 1);
+            for (const KktEdge &edge : forest)
+            {
+                tree[treeNext[edge.u]++] = {edge.v, edge.rank};
+                tree[treeNext[edge.v]++] = {edge.u, edge.rank};
+            }
+            for (int i = 0; i < m; i++)
+            {
+                queries[queryNext[edges[i].u]++] = i;
+                queries[queryNext[edges[i].v]++] = i;
+            }
+        }
+
+        vector<int> parent(verts);
+        vector<uint64_t> up(verts, 0);
+        vector<int> treeOf(verts, -1);
+        // Queries waiting on their LCA, as linked lists
+        vector<int> bucket(verts, -1), nextInBucket(m, -1);
+        vector<char> hasLca(m, 0);
+        vector<uint64_t> pathMax(m, 0);
+
+        // The DFS stack, each frame is a vertex, its tree parent, the rank of the edge to it and the next neighbor
+        struct Frame
+        {
+            int vertex;
+            int from;
+            uint64_t rank;
+            int next;
+        };
+        vector<Frame> stack;
+
+        for (int root = 0; root < verts; root++)
+        {
+            if (treeOf[root] != -1)
+            {
+                continue;
+            }
+            stack.push_back({root, -1, 0, -1});
+            while (!stack.empty())
+            {
+                Frame &frame = stack.back();
+                int x = frame.vertex;
+                if (frame.next == -1)
+                {
+                    // Entering, file every query whose other end has already been reached under their LCA
+                    treeOf[x] = root;
+                    parent[x] = x;
+                    frame.next = treeStart[x];
+                    for (int q = queryStart[x]; q < queryStart[x + 1]; q++)
+                    {
+                        int i = queries[q];
+                        int y = edges[i].u == x ? edges[i].v : edges[i].u;
+                        if (y != x && treeOf[y] == root && !hasLca[i])
+                        {
+                            int lca = find(parent, up, y);
+                            hasLca[i] = 1;
+                            nextInBucket[i] = bucket[lca];
+                            bucket[lca] = i;
+                        }
+                    }
+                }
+
+                if (frame.next < treeStart[x + 1])
+                {
+                    auto [child, rank] = tree[frame.next++];
+                    if (child != frame.from)
+                    {
+                        stack.push_back({child, x, rank, -1});
+                    }
+                    continue;
+                }
+
+                // Leaving, every child is merged into `x`, so both ends of the filed queries find `x`
+                for (int i = bucket[x]; i != -1; i = nextInBucket[i])
+                {
+                    find(parent, up, edges[i].u);
+                    find(parent, up, edges[i].v);
+                    pathMax[i] = max(edges[i].u == x ? 0 : up[edges[i].u], edges[i].v == x ? 0 : up[edges[i].v]);
+                }
+                if (frame.from != -1)
+                {
+                    parent[x] = frame.from;
+                    up[x] = frame.rank;
+                }
+                stack.pop_back();
+            }
+        }
+
+        size_t kept = 0;
+        for (int i = 0; i < m; i++)
+        {
+            // Edges between two trees of the forest have no path, so they are never heavy
+            if (!hasLca[i] || edges[i].rank <= pathMax[i])
+            {
+                edges[kept++] = edges[i];
+            }
+        }
+        edges.resize(kept);
+    }
+
+    /**
+     * Hands a small subproblem to `kruskal_mst`. Parallel edges are merged first, keeping the lightest, so each
+     * tree edge Kruskal returns maps back to exactly one of our edges.
+     */
+    vector<int> baseCase(int verts, const vector<KktEdge> &edges)
+    {
+        vector<KktEdge> unique(edges);
+        for (KktEdge &edge : unique)
+        {
+            if (edge.u > edge.v)
+            {
+                swap(edge.u, edge.v);
+            }
+        }
+        sort(unique.begin(), unique.end(), [](const KktEdge &a, const KktEdge &b)
+             { return tie(a.u, a.v, a.rank) < tie(b.u, b.v, b.rank); });
+
+        Graph graph(verts);
+        unordered_map<uint64_t, int> slotOf;
+        for (size_t i = 0; i < unique.size(); i++)
+        {
+            if (i > 0 && unique[i].u == unique[i - 1].u && unique[i].v == unique[i - 1].v)
+            {
+                continue;
+            }
+            graph.addEdge(unique[i].u, unique[i].v, original[static_cast<uint32_t>(unique[i].rank)].weight);
+            slotOf[(static_cast<uint64_t>(unique[i].u) << 32) | static_cast<uint32_t>(unique[i].v)] = unique[i].slot;
+        }
+
+        vector<int> forest;
+        for (const Graph::Edge &edge : kruskal_mst(graph).edges)
+        {
+            forest.push_back(slotOf[(static_cast<uint64_t>(edge.src) << 32) | static_cast<uint32_t>(edge.dest)]);
+        }
+        return forest;
+    }
+
+public:
+    KktSolver(const vector<Graph::Edge> &edges, unsigned seed) : original(edges), random(seed) {}
+
+    /**
+     * The minimum spanning forest of a subproblem
+     *
+     * @param verts The number of vertices
+     * @param edges The edges, taken by value since every level relabels and filters its own copy
+     * @return The positions in `edges` of the forest edges
+     */
+    vector<int> solve(int verts, vector<KktEdge> edges)
+    {
+        for (int i = 0; i < static_cast<int>(edges.size()); i++)
+        {
+            edges[i].slot = i;
+        }
+        if (edges.size() <= KKT_BASE_EDGES)
+        {
+            return baseCase(verts, edges);
+        }
+
+        // Two Borůvka steps cut the vertices to a quarter
+        vector<int> forest;
+        for (int step = 0; step < 2 && !edges.empty(); step++)
+        {
+            verts = boruvkaStep(verts, edges, forest);
+        }
+        if (edges.empty())
+        {
+            return forest;
+        }
+
+        // Keep each edge with probability one half, 32 coin flips per draw
+        vector<KktEdge> sample;
+        uint32_t bits = 0;
+        for (size_t i = 0; i < edges.size(); i++)
+        {
+            if (i % 32 == 0)
+            {
+                bits = random();
+            }
+            if (bits & 1)
+            {
+                sample.push_back(edges[i]);
+            }
+            bits >>= 1;
+        }
+
+        // The forest of the sample filters out every edge that can not be in the forest of the whole graph
+        vector<KktEdge> sampleForest;
+        for (int i : solve(verts, sample))
+        {
+            sampleForest.push_back(sample[i]);
+        }
+        dropHeavy(verts, edges, sampleForest);
+
+        for (int i : solve(verts, edges))
+        {
+            forest.push_back(edges[i].slot);
+        }
+        return forest;
+    }
+};
+
+/**
+ * Implementation of the randomized Karger-Klein-Tarjan algorithm, expected O(V + E)
+ *
+ * Each level runs two Borůvka steps, solves a half size random sample of the remaining edges recursively, drops
+ * the edges that are F-heavy for the sample's forest, and solves what is left recursively. Small subproblems go
+ * to Kruskal's algorithm. A disconnected graph gives a minimum spanning forest.
+ *
+ * @param graph The graph to perform the algorithm on
+ * @param seed The seed of the edge sampling, the same seed gives the same tree
+ * @return A `MST` object with the minimum spanning tree of the graph
+ */
+MST kkt_mst(Graph &graph, unsigned seed)
+{
+    MST mst;
+    EdgeList list(graph);
+    vector<KktEdge> edges;
+    edges.reserve(list.list.size());
+    for (size_t i = 0; i < list.list.size(); i++)
+    {
+        edges.push_back({list.list[i].src, list.list[i].dest, edgeRank(list.list[i].weight, i), static_cast<int>(i)});
+    }
+
+    KktSolver solver(list.list, seed);
+    for (int slot : solver.solve(graph.vertNumber(), edges))
+    {
+        mst.edges.push_back(list.list[slot]);
+        mst.totalWeight += list.list[slot].weight;
+    }
+    return mst;
+}
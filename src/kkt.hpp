@@ -0,0 +1,13 @@
+#ifndef KKT_HPP
+#define KKT_HPP
+
+#include "graph.hpp"
+
+// Subproblems with at most this many edges are handed to Kruskal's algorithm, can be overridden with -DKKT_BASE_EDGES=4096
+#ifndef KKT_BASE_EDGES
+#define KKT_BASE_EDGES 1024
+#endif
+
+MST kkt_mst(Graph &graph, unsigned seed = 1);
+
+#endif
@@ -0,0 +1,531 @@
+#include "graph.hpp"
+#include "knn.hpp"
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include <climits>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+// The distance kernels are compiled with target attributes and picked at runtime, like the dense Prim ones
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KNN_X86 1
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// Brute force compares a block of queries against a block of references at a time, so the references stay in cache
+static const int QUERY_BLOCK = 64;
+static const int REFERENCE_BLOCK = 256;
+// The points NN-descent joins as one task, each task collects its updates separately
+static const int DESCENT_CHUNK = 256;
+// NN-descent stops once an iteration improves fewer than this fraction of the slots
+static const double DESCENT_DELTA = 0.001;
+
+PointCloud loadVectors(const string &file)
+{
+    const string extension = ".fvecs";
+    if (file.size() < extension.size() || file.compare(file.size() - extension.size(), extension.size(), extension) != 0)
+    {
+        return loadPointCloud(file);
+    }
+
+    ifstream inputFile(file, ios::binary);
+    if (!inputFile)
+    {
+        cerr << "Error loading vector file.";
+        return PointCloud();
+    }
+    PointCloud points;
+    points.name = file.substr(file.find_last_of("/\\") + 1);
+    points.name.resize(points.name.size() - extension.size());
+    int32_t dims;
+    vector<float> values;
+    while (inputFile.read(reinterpret_cast<char *>(&dims), sizeof(dims)))
+    {
+        if (dims <= 0 || (points.dims != 0 && dims != points.dims))
+        {
+            cerr << "Error loading vector file, the vectors do not all have the same dimension.";
+            return PointCloud();
+        }
+        points.dims = dims;
+        values.resize(dims);
+        if (!inputFile.read(reinterpret_cast<char *>(values.data()), dims * sizeof(float)))
+        {
+            // Drop a partial last vector
+            break;
+        }
+        points.coords.insert(points.coords.end(), values.begin(), values.end());
+    }
+    return points;
+}
+
+static double squaredDistanceScalar(const double *a, const double *b, int dims)
+{
+    double sum = 0;
+    for (int d = 0; d < dims; d++)
+    {
+        double delta = a[d] - b[d];
+        sum += delta * delta;
+    }
+    return sum;
+}
+
+#ifdef KNN_X86
+
+/**
+ * The squared distance two coordinates per instruction, with two accumulators so the adds of consecutive
+ * coordinates do not wait on each other.
+ */
+__attribute__((target("sse2"))) static double squaredDistanceSSE2(const double *a, const double *b, int dims)
+{
+    __m128d first = _mm_setzero_pd(), second = _mm_setzero_pd();
+    int d = 0;
+    for (; d + 4 <= dims; d += 4)
+    {
+        __m128d delta = _mm_sub_pd(_mm_loadu_pd(a + d), _mm_loadu_pd(b + d));
+        first = _mm_add_pd(first, _mm_mul_pd(delta, delta));
+        delta = _mm_sub_pd(_mm_loadu_pd(a + d + 2), _mm_loadu_pd(b + d + 2));
+        second = _mm_add_pd(second, _mm_mul_pd(delta, delta));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(first, second));
+    return lanes[0] + lanes[1] + squaredDistanceScalar(a + d, b + d, dims - d);
+}
+
+/**
+ * The same with four coordinates per instruction.
+ */
+__attribute__((target("avx"))) static double squaredDistanceAVX(const double *a, const double *b, int dims)
+{
+    __m256d first = _mm256_setzero_pd(), second = _mm256_setzero_pd();
+    int d = 0;
+    for (; d + 8 <= dims; d += 8)
+    {
+        __m256d delta = _mm256_sub_pd(_mm256_loadu_pd(a + d), _mm256_loadu_pd(b + d));
+        first = _mm256_add_pd(first, _mm256_mul_pd(delta, delta));
+        delta = _mm256_sub_pd(_mm256_loadu_pd(a + d + 4), _mm256_loadu_pd(b + d + 4));
+        second = _mm256_add_pd(second, _mm256_mul_pd(delta, delta));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(first, second));
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + squaredDistanceScalar(a + d, b + d, dims - d);
+}
+
+#endif
+
+/**
+ * The distance kernel picked for the CPU we are running on.
+ */
+struct DistanceKernel
+{
+    double (*distance)(const double *, const double *, int);
+    const char *name;
+};
+
+static DistanceKernel selectDistanceKernel()
+{
+#ifdef KNN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx"))
+    {
+        return {squaredDistanceAVX, "avx"};
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return {squaredDistanceSSE2, "sse2"};
+    }
+#endif
+    return {squaredDistanceScalar, "scalar"};
+}
+
+static const DistanceKernel &distanceKernel()
+{
+    static const DistanceKernel selected = selectDistanceKernel();
+    return selected;
+}
+
+double squaredDistance(const double *a, const double *b, int dims)
+{
+    return distanceKernel().distance(a, b, dims);
+}
+
+const char *knnKernelName()
+{
+    return distanceKernel().name;
+}
+
+/**
+ * @return Lists of `k` empty slots for every point.
+ */
+static KnnLists emptyLists(int n, int k)
+{
+    KnnLists lists;
+    lists.k = k;
+    lists.ids.assign(static_cast<size_t>(n) * k, -1);
+    lists.distances.assign(static_cast<size_t>(n) * k, numeric_limits<double>::infinity());
+    return lists;
+}
+
+/**
+ * Inserts a neighbour into a sorted list of `k` slots, if it is closer than the farthest one and not there yet.
+ *
+ * @param isNew The NN-descent flags of the slots, or `nullptr`
+ * @return True if the list changed
+ */
+static bool insertNeighbor(int *ids, double *distances, char *isNew, int k, int id, double distance)
+{
+    if (distance >= distances[k - 1])
+    {
+        return false;
+    }
+    int slot = k - 1;
+    for (int i = 0; i < k; i++)
+    {
+        if (ids[i] == id)
+        {
+            return false;
+        }
+    }
+    while (slot > 0 && distances[slot - 1] > distance)
+    {
+        ids[slot] = ids[slot - 1];
+        distances[slot] = distances[slot - 1];
+        if (isNew)
+        {
+            isNew[slot] = isNew[slot - 1];
+        }
+        slot--;
+    }
+    ids[slot] = id;
+    distances[slot] = distance;
+    if (isNew)
+    {
+        isNew[slot] = 1;
+    }
+    return true;
+}
+
+/**
+ * The lists hold squared distances while they are built, this turns them into distances.
+ */
+static void takeRoots(KnnLists &lists)
+{
+    for (double &distance : lists.distances)
+    {
+        distance = sqrt(distance);
+    }
+}
+
+/**
+ * Exact k nearest neighbours by comparing every pair, O(n^2 d)
+ *
+ * The queries are split in blocks that run in parallel, and every block walks the references one cache sized
+ * block at a time. Ties go to the lower index.
+ *
+ * @param points The points
+ * @param k The number of neighbours per point
+ * @param pool The pool to run on
+ * @return The neighbour lists
+ */
+KnnLists knn_brute_force(const PointCloud &points, int k, ThreadPool &pool)
+{
+    int n = points.size();
+    if (k <= 0)
+    {
+        return KnnLists();
+    }
+    KnnLists lists = emptyLists(n, k);
+    // The kernel is looked up once, not once per pair
+    auto distanceOf = distanceKernel().distance;
+    int blocks = (n + QUERY_BLOCK - 1) / QUERY_BLOCK;
+    pool.parallelFor(0, blocks, [&](int block)
+                     {
+                         int queryEnd = min(n, (block + 1) * QUERY_BLOCK);
+                         for (int referenceBegin = 0; referenceBegin < n; referenceBegin += REFERENCE_BLOCK)
+                         {
+                             int referenceEnd = min(n, referenceBegin + REFERENCE_BLOCK);
+                             for (int q = block * QUERY_BLOCK; q < queryEnd; q++)
+                             {
+                                 int *ids = lists.ids.data() + static_cast<size_t>(q) * k;
+                                 double *distances = lists.distances.data() + static_cast<size_t>(q) * k;
+                                 for (int r = referenceBegin; r < referenceEnd; r++)
+                                 {
+                                     if (r == q)
+                                     {
+                                         continue;
+                                     }
+                                     double distance = distanceOf(points.point(q), points.point(r), points.dims);
+                                     if (distance < distances[k - 1])
+                                     {
+                                         insertNeighbor(ids, distances, nullptr, k, r, distance);
+                                     }
+                                 }
+                             }
+                         } });
+    takeRoots(lists);
+    return lists;
+}
+
+/**
+ * @brief A proposed neighbour for `target`, found by a local join.
+ */
+struct Update
+{
+    int target;
+    int neighbor;
+    double distance;
+};
+
+/**
+ * Approximate k nearest neighbours with NN-descent (Dong, Charikar and Li)
+ *
+ * Every point starts with random neighbours. Each iteration joins, for every point, the pairs among its
+ * neighbours and reverse neighbours, since a neighbour of a neighbour is likely to be a neighbour. Only pairs
+ * with at least one side that joined the lists in the last iteration are compared, so settled regions cost
+ * nothing. It stops when an iteration improves fewer than 0.1% of the slots, usually after 5 to 10 iterations
+ * with a recall above 90%, at a small fraction of the pairs brute force compares.
+ *
+ * The joins run in parallel and only read the lists, each task keeps its proposed updates, and the updates are
+ * then applied in parallel per target point. The result only depends on the seed, not on the thread count.
+ *
+ * @param points The points
+ * @param k The number of neighbours per point
+ * @param seed The seed of the random starting neighbours
+ * @param maxIterations The most join iterations to run
+ * @param pool The pool to run on
+ * @return The neighbour lists
+ */
+KnnLists knn_descent(const PointCloud &points, int k, unsigned seed, int maxIterations, ThreadPool &pool)
+{
+    int n = points.size();
+    if (k <= 0)
+    {
+        return KnnLists();
+    }
+    KnnLists lists = emptyLists(n, k);
+    vector<char> isNew(static_cast<size_t>(n) * k, 0);
+    auto slots = [&](int p)
+    {
+        return static_cast<size_t>(p) * k;
+    };
+    auto distance = [&](int a, int b)
+    {
+        return squaredDistance(points.point(a), points.point(b), points.dims);
+    };
+
+    pool.parallelFor(0, n, [&](int p)
+                     {
+                         size_t base = slots(p);
+                         if (n - 1 <= 2 * k)
+                         {
+                             // Few enough points that trying them all is as cheap as sampling
+                             for (int q = 0; q < n; q++)
+                             {
+                                 if (q != p)
+                                 {
+                                     insertNeighbor(&lists.ids[base], &lists.distances[base], &isNew[base], k, q, distance(p, q));
+                                 }
+                             }
+                             return;
+                         }
+                         minstd_rand random(seed * 2654435761u + p + 1);
+                         uniform_int_distribution<int> vertex(0, n - 1);
+                         for (int filled = 0; filled < k;)
+                         {
+                             int q = vertex(random);
+                             if (q != p && insertNeighbor(&lists.ids[base], &lists.distances[base], &isNew[base], k, q, distance(p, q)))
+                             {
+                                 filled++;
+                             }
+                         } },
+                     DESCENT_CHUNK);
+
+    vector<vector<int>> fresh(n), old(n), freshReverse(n), oldReverse(n);
+    int chunks = (n + DESCENT_CHUNK - 1) / DESCENT_CHUNK;
+    vector<vector<Update>> updates(chunks);
+    vector<int> offsets(n + 1);
+    vector<Update> byTarget;
+    vector<int> changed(n);
+    for (int iteration = 0; iteration < maxIterations; iteration++)
+    {
+        // Split every list into the neighbours that are new since the last join and the old ones
+        pool.parallelFor(0, n, [&](int p)
+                         {
+                             fresh[p].clear();
+                             old[p].clear();
+                             freshReverse[p].clear();
+                             oldReverse[p].clear();
+                             for (size_t s = slots(p); s < slots(p + 1); s++)
+                             {
+                                 if (lists.ids[s] == -1)
+                                 {
+                                     continue;
+                                 }
+                                 (isNew[s] ? fresh[p] : old[p]).push_back(lists.ids[s]);
+                                 isNew[s] = 0;
+                             } },
+                         DESCENT_CHUNK);
+        // The reverse lists are capped at k, so a hub does not join with everything that points to it
+        for (int p = 0; p < n; p++)
+        {
+            for (int q : fresh[p])
+            {
+                if (static_cast<int>(freshReverse[q].size()) < k)
+                {
+                    freshReverse[q].push_back(p);
+                }
+            }
+            for (int q : old[p])
+            {
+                if (static_cast<int>(oldReverse[q].size()) < k)
+                {
+                    oldReverse[q].push_back(p);
+                }
+            }
+        }
+
+        // The local joins, only proposing what would get into the target's list as it is now
+        pool.parallelFor(0, chunks, [&](int chunk)
+                         {
+                             vector<Update> &proposed = updates[chunk];
+                             proposed.clear();
+                             vector<int> newSide, oldSide;
+                             auto propose = [&](int u, int v)
+                             {
+                                 if (u == v)
+                                 {
+                                     return;
+                                 }
+                                 double d = distance(u, v);
+                                 if (d < lists.distances[slots(u) + k - 1])
+                                 {
+                                     proposed.push_back({u, v, d});
+                                 }
+                                 if (d < lists.distances[slots(v) + k - 1])
+                                 {
+                                     proposed.push_back({v, u, d});
+                                 }
+                             };
+                             for (int p = chunk * DESCENT_CHUNK; p < min(n, (chunk + 1) * DESCENT_CHUNK); p++)
+                             {
+                                 newSide = fresh[p];
+                                 newSide.insert(newSide.end(), freshReverse[p].begin(), freshReverse[p].end());
+                                 sort(newSide.begin(), newSide.end());
+                                 newSide.erase(unique(newSide.begin(), newSide.end()), newSide.end());
+                                 oldSide = old[p];
+                                 oldSide.insert(oldSide.end(), oldReverse[p].begin(), oldReverse[p].end());
+                                 sort(oldSide.begin(), oldSide.end());
+                                 oldSide.erase(unique(oldSide.begin(), oldSide.end()), oldSide.end());
+
+                                 for (size_t i = 0; i < newSide.size(); i++)
+                                 {
+                                     for (size_t j = i + 1; j < newSide.size(); j++)
+                                     {
+                                         propose(newSide[i], newSide[j]);
+                                     }
+                                     for (int v : oldSide)
+                                     {
+                                         propose(newSide[i], v);
+                                     }
+                                 }
+                             } });
+
+        // Group the updates by target, in chunk order, and apply each target's updates in one task
+        fill(offsets.begin(), offsets.end(), 0);
+        for (const auto &proposed : updates)
+        {
+            for (const Update &update : proposed)
+            {
+                offsets[update.target + 1]++;
+            }
+        }
+        for (int p = 0; p < n; p++)
+        {
+            offsets[p + 1] += offsets[p];
+        }
+        byTarget.resize(offsets[n]);
+        vector<int> next(offsets.begin(), offsets.end() - 1);
+        for (const auto &proposed : updates)
+        {
+            for (const Update &update : proposed)
+            {
+                byTarget[next[update.target]++] = update;
+            }
+        }
+        pool.parallelFor(0, n, [&](int p)
+                         {
+                             changed[p] = 0;
+                             size_t base = slots(p);
+                             for (int i = offsets[p]; i < offsets[p + 1]; i++)
+                             {
+                                 changed[p] += insertNeighbor(&lists.ids[base], &lists.distances[base], &isNew[base], k,
+                                                              byTarget[i].neighbor, byTarget[i].distance);
+                             } },
+                         DESCENT_CHUNK);
+
+        long long improved = 0;
+        for (int count : changed)
+        {
+            improved += count;
+        }
+        if (improved <= DESCENT_DELTA * n * k)
+        {
+            break;
+        }
+    }
+    takeRoots(lists);
+    return lists;
+}
+
+double knnRecall(const KnnLists &approximate, const KnnLists &exact)
+{
+    long long found = 0, total = 0;
+    int n = min(approximate.size(), exact.size());
+    for (int p = 0; p < n; p++)
+    {
+        for (int i = 0; i < exact.k; i++)
+        {
+            int id = exact.ids[static_cast<size_t>(p) * exact.k + i];
+            if (id == -1)
+            {
+                continue;
+            }
+            total++;
+            auto begin = approximate.ids.begin() + static_cast<size_t>(p) * approximate.k;
+            found += find(begin, begin + approximate.k, id) != begin + approximate.k;
+        }
+    }
+    return total > 0 ? static_cast<double>(found) / total : 1.0;
+}
+
+Graph knnGraph(const KnnLists &lists, double scale)
+{
+    int n = lists.size();
+    int k = lists.k;
+    Graph graph(n);
+    auto listed = [&](int p, int id)
+    {
+        auto begin = lists.ids.begin() + static_cast<size_t>(p) * k;
+        return find(begin, begin + k, id) != begin + k;
+    };
+    for (int p = 0; p < n; p++)
+    {
+        for (int i = 0; i < k; i++)
+        {
+            size_t slot = static_cast<size_t>(p) * k + i;
+            int q = lists.ids[slot];
+            // A pair that are each other's neighbours gets one edge, added from the lower index
+            if (q == -1 || (q < p && listed(q, p)))
+            {
+                continue;
+            }
+            int weight = static_cast<int>(llround(min<double>(INT_MAX, lists.distances[slot] * scale)));
+            graph.addEdge(p, q, weight);
+        }
+    }
+    return graph;
+}
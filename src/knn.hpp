@@ -0,0 +1,68 @@
+#ifndef KNN_HPP
+#define KNN_HPP
+
+#include "graph.hpp"
+#include "emst.hpp"
+#include "thread_pool.hpp"
+#include <vector>
+#include <string>
+
+/**
+ * @brief The `k` nearest neighbours of every point, in CSR form with exactly `k` entries per point.
+ *
+ * The neighbours of point `i` are `ids[i * k]` to `ids[i * k + k - 1]`, closest first. Points with fewer than
+ * `k` other points have their missing entries set to -1.
+ */
+struct KnnLists
+{
+    int k = 0;                     /**< The number of neighbours per point. */
+    std::vector<int> ids;          /**< The neighbour of every slot, or -1. */
+    std::vector<double> distances; /**< The Euclidean distance of every slot. */
+
+    /**
+     * @return The number of points.
+     */
+    int size() const
+    {
+        return k > 0 ? ids.size() / k : 0;
+    }
+};
+
+/**
+ * Loads dense vectors, from a `.fvecs` file (per vector an int32 dimension then that many float32) or from a
+ * `.points` file.
+ *
+ * @param file The path to the file containing the vectors.
+ * @return The loaded vectors, or an empty cloud if the file can not be read.
+ */
+PointCloud loadVectors(const std::string &file);
+
+/**
+ * @return The squared Euclidean distance between two vectors of `dims` coordinates.
+ */
+double squaredDistance(const double *a, const double *b, int dims);
+
+/**
+ * @return The name of the distance kernel picked for this CPU, "avx", "sse2" or "scalar".
+ */
+const char *knnKernelName();
+
+KnnLists knn_brute_force(const PointCloud &points, int k, ThreadPool &pool = sharedPool());
+
+KnnLists knn_descent(const PointCloud &points, int k, unsigned seed = 1, int maxIterations = 12, ThreadPool &pool = sharedPool());
+
+/**
+ * @return The fraction of the exact neighbours that `approximate` found.
+ */
+double knnRecall(const KnnLists &approximate, const KnnLists &exact);
+
+/**
+ * Builds the undirected k-NN graph, with an edge wherever one point is a neighbour of the other.
+ *
+ * @param lists The neighbour lists
+ * @param scale The distances are multiplied by this before they are rounded to integer weights
+ * @return The graph, ready for any of the MST engines
+ */
+Graph knnGraph(const KnnLists &lists, double scale = 1.0);
+
+#endif
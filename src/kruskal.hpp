@@ -5,6 +5,7 @@
 #include "algorithm"
 #include "unordered_map"
 #include <numeric>
+#include <atomic>
 
 using namespace std;
 MST kruskal_mst(Graph &graph);
@@ -93,4 +94,75 @@ public:
     }
 };
 
+/**
+ * Lock-free Union Find that many threads can use at once, used by the parallel engines.
+ *
+ * Roots are linked with a compare-and-swap, always the larger index under the smaller one so no cycles can form,
+ * and `find` halves the path it walks with a compare-and-swap that is allowed to fail.
+ */
+class ConcurrentUnionFind
+{
+private:
+    // The parent vector
+    vector<atomic<int>> parent;
+
+public:
+    // Constructor
+    explicit ConcurrentUnionFind(int numElements) : parent(numElements)
+    {
+        for (int i = 0; i < numElements; i++)
+        {
+            parent[i].store(i, memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Find with path halving
+     */
+    int find(int x)
+    {
+        while (true)
+        {
+            int p = parent[x].load(memory_order_acquire);
+            if (p == x)
+            {
+                return x;
+            }
+            int grandparent = parent[p].load(memory_order_acquire);
+            if (p != grandparent)
+            {
+                parent[x].compare_exchange_weak(p, grandparent, memory_order_release, memory_order_relaxed);
+            }
+            x = grandparent;
+        }
+    }
+
+    /**
+     * Links the sets of `x` and `y`
+     *
+     * @return True if they were in different sets, so exactly one caller wins for each pair that gets joined
+     */
+    bool merge(int x, int y)
+    {
+        while (true)
+        {
+            int xRoot = find(x);
+            int yRoot = find(y);
+            if (xRoot == yRoot)
+            {
+                return false;
+            }
+            if (xRoot < yRoot)
+            {
+                swap(xRoot, yRoot);
+            }
+            int expected = xRoot;
+            if (parent[xRoot].compare_exchange_strong(expected, yRoot, memory_order_acq_rel))
+            {
+                return true;
+            }
+        }
+    }
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,254 @@
+#include "link_cut_tree.hpp"
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+using namespace std;
+
+LinkCutTree::LinkCutTree(int count) : nodes(count)
+{
+}
+
+int LinkCutTree::addNode(bool edge, uint64_t key)
+{
+    nodes.emplace_back();
+    labels.resize(nodes.size() * slots);
+    int x = nodes.size() - 1;
+    resetNode(x, edge, key);
+    return x;
+}
+
+void LinkCutTree::resetNode(int x, bool edge, uint64_t key)
+{
+    nodes[x] = Node();
+    nodes[x].edge = edge;
+    nodes[x].key = key;
+    nodes[x].best = edge ? x : -1;
+    fill(labels.begin() + x * slots, labels.begin() + (x + 1) * slots, -1);
+}
+
+bool LinkCutTree::isSplayRoot(int x) const
+{
+    int p = nodes[x].parent;
+    return p == -1 || (nodes[p].child[0] != x && nodes[p].child[1] != x);
+}
+
+/**
+ * Hands the pending reversal and labels of `x` down to its children.
+ */
+void LinkCutTree::push(int x)
+{
+    if (nodes[x].flip)
+    {
+        swap(nodes[x].child[0], nodes[x].child[1]);
+        for (int c : nodes[x].child)
+        {
+            if (c != -1)
+            {
+                nodes[c].flip = !nodes[c].flip;
+            }
+        }
+        nodes[x].flip = false;
+    }
+    for (uint64_t pending = nodes[x].pending; pending != 0; pending &= pending - 1)
+    {
+        int slot = __builtin_ctzll(pending);
+        for (int c : nodes[x].child)
+        {
+            if (c != -1)
+            {
+                labels[c * slots + slot] = labels[x * slots + slot];
+                nodes[c].pending |= 1ULL << slot;
+            }
+        }
+    }
+    nodes[x].pending = 0;
+}
+
+/**
+ * Recomputes the best edge of `x` from its children.
+ */
+void LinkCutTree::pull(int x)
+{
+    int best = nodes[x].edge ? x : -1;
+    for (int c : nodes[x].child)
+    {
+        if (c != -1 && nodes[c].best != -1 && (best == -1 || nodes[nodes[c].best].key > nodes[best].key))
+        {
+            best = nodes[c].best;
+        }
+    }
+    nodes[x].best = best;
+}
+
+void LinkCutTree::rotate(int x)
+{
+    int p = nodes[x].parent;
+    int g = nodes[p].parent;
+    int side = nodes[p].child[1] == x;
+    int moved = nodes[x].child[!side];
+    if (!isSplayRoot(p))
+    {
+        nodes[g].child[nodes[g].child[1] == p] = x;
+    }
+    nodes[x].parent = g;
+    nodes[x].child[!side] = p;
+    nodes[p].parent = x;
+    nodes[p].child[side] = moved;
+    if (moved != -1)
+    {
+        nodes[moved].parent = p;
+    }
+    pull(p);
+    pull(x);
+}
+
+void LinkCutTree::splay(int x)
+{
+    // Push the reversals down from the splay root first, so the rotations see the real child order
+    path.assign(1, x);
+    for (int y = x; !isSplayRoot(y); y = nodes[y].parent)
+    {
+        path.push_back(nodes[y].parent);
+    }
+    for (auto it = path.rbegin(); it != path.rend(); ++it)
+    {
+        push(*it);
+    }
+
+    while (!isSplayRoot(x))
+    {
+        int p = nodes[x].parent;
+        if (!isSplayRoot(p))
+        {
+            int g = nodes[p].parent;
+            bool zigZig = (nodes[g].child[1] == p) == (nodes[p].child[1] == x);
+            rotate(zigZig ? p : x);
+        }
+        rotate(x);
+    }
+}
+
+/**
+ * Makes the path from the root to `x` preferred, and leaves `x` at the root of its splay tree with no deeper nodes.
+ *
+ * @return The last node the walk up joined the root's path at, which after an `access(u)` is the lowest common
+ *         ancestor of `u` and `x`
+ */
+int LinkCutTree::access(int x)
+{
+    int last = -1;
+    for (int y = x; y != -1; y = nodes[y].parent)
+    {
+        splay(y);
+        nodes[y].child[1] = last;
+        pull(y);
+        last = y;
+    }
+    splay(x);
+    return last;
+}
+
+void LinkCutTree::makeRoot(int x)
+{
+    access(x);
+    nodes[x].flip = !nodes[x].flip;
+}
+
+int LinkCutTree::findRoot(int x)
+{
+    access(x);
+    int root = x;
+    push(root);
+    while (nodes[root].child[0] != -1)
+    {
+        root = nodes[root].child[0];
+        push(root);
+    }
+    // Splaying the root keeps repeated queries cheap
+    splay(root);
+    return root;
+}
+
+bool LinkCutTree::connected(int u, int v)
+{
+    return u == v || findRoot(u) == findRoot(v);
+}
+
+void LinkCutTree::link(int u, int v)
+{
+    makeRoot(u);
+    nodes[u].parent = v;
+}
+
+void LinkCutTree::cut(int u, int v)
+{
+    makeRoot(u);
+    access(v);
+    // The path is just u then v, so u is the left child of v
+    nodes[v].child[0] = -1;
+    nodes[u].parent = -1;
+    pull(v);
+}
+
+int LinkCutTree::pathMax(int u, int v)
+{
+    makeRoot(u);
+    access(v);
+    return nodes[v].best;
+}
+
+int LinkCutTree::lca(int u, int v)
+{
+    access(u);
+    return access(v);
+}
+
+int LinkCutTree::parent(int x)
+{
+    access(x);
+    // The nodes above `x` are its left subtree, and the lowest of them is the last in depth order
+    int above = nodes[x].child[0];
+    if (above == -1)
+    {
+        return -1;
+    }
+    push(above);
+    while (nodes[above].child[1] != -1)
+    {
+        above = nodes[above].child[1];
+        push(above);
+    }
+    splay(above);
+    return above;
+}
+
+void LinkCutTree::reserveLabels(int count)
+{
+    if (count <= slots)
+    {
+        return;
+    }
+    vector<int> wider(nodes.size() * count, -1);
+    for (size_t x = 0; x < nodes.size(); x++)
+    {
+        copy(labels.begin() + x * slots, labels.begin() + (x + 1) * slots, wider.begin() + x * count);
+    }
+    labels.swap(wider);
+    slots = count;
+}
+
+void LinkCutTree::labelPath(int u, int v, int slot, int value)
+{
+    makeRoot(u);
+    access(v);
+    // After the access the splay tree of `v` is exactly the path
+    labels[v * slots + slot] = value;
+    nodes[v].pending |= 1ULL << slot;
+}
+
+int LinkCutTree::label(int x, int slot)
+{
+    splay(x);
+    return labels[x * slots + slot];
+}
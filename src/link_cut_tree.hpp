@@ -0,0 +1,144 @@
+#ifndef LINK_CUT_TREE_HPP
+#define LINK_CUT_TREE_HPP
+
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief A forest of rooted trees that supports linking, cutting and path maximum queries in O(log n) amortized.
+ *
+ * Every node has a key, and only the nodes marked as edges take part in the path maximum. To keep the maximum
+ * weight edge of a tree path, store each tree edge as its own node between its two endpoints, with the edge's
+ * `edgeRank` as the key, and the vertices as plain nodes.
+ *
+ * The preferred paths are kept in splay trees ordered by depth, with a lazy flag to reverse a path when the tree
+ * is rerooted.
+ *
+ * Every node can also carry a few integer labels, one per slot, which a whole path can be given at once. The labels
+ * are pushed down the splay trees lazily, like the reversals, so labelling a path is O(log n) amortized too.
+ */
+class LinkCutTree
+{
+private:
+    struct Node
+    {
+        int child[2] = {-1, -1};
+        // The splay tree parent, or the path parent if this is the root of its splay tree
+        int parent = -1;
+        bool flip = false;
+        bool edge = false;
+        uint64_t key = 0;
+        // The edge node with the largest key in this splay subtree, or -1
+        int best = -1;
+        // The label slots whose value this node still has to hand down to its splay subtree, one bit per slot
+        uint64_t pending = 0;
+    };
+    std::vector<Node> nodes;
+    // The labels of every node, `slots` apiece, -1 for none
+    std::vector<int> labels;
+    int slots = 0;
+    // The splay path of `splay`, kept between calls so it does not allocate
+    std::vector<int> path;
+
+    bool isSplayRoot(int x) const;
+    void push(int x);
+    void pull(int x);
+    void rotate(int x);
+    void splay(int x);
+    int access(int x);
+
+public:
+    /**
+     * @param count The number of plain nodes to start with
+     */
+    explicit LinkCutTree(int count = 0);
+
+    /**
+     * @brief Adds a node with no links.
+     *
+     * @param edge True if the node takes part in path maximum queries
+     * @param key The key it is compared by
+     * @return The index of the new node
+     */
+    int addNode(bool edge, uint64_t key);
+
+    /**
+     * @brief Turns a node that has no links into a fresh one with a new key, so edge nodes can be reused.
+     */
+    void resetNode(int x, bool edge, uint64_t key);
+
+    /**
+     * @return The number of nodes.
+     */
+    int size() const
+    {
+        return nodes.size();
+    }
+
+    /**
+     * @return The key of a node.
+     */
+    uint64_t key(int x) const
+    {
+        return nodes[x].key;
+    }
+
+    /**
+     * @brief Makes `x` the root of its tree.
+     */
+    void makeRoot(int x);
+
+    /**
+     * @return The root of the tree `x` is in.
+     */
+    int findRoot(int x);
+
+    /**
+     * @return True if `u` and `v` are in the same tree.
+     */
+    bool connected(int u, int v);
+
+    /**
+     * @brief Links the trees of `u` and `v` with an edge between them, they must be in different trees.
+     */
+    void link(int u, int v);
+
+    /**
+     * @brief Removes the link between `u` and `v`, they must be linked.
+     */
+    void cut(int u, int v);
+
+    /**
+     * @return The edge node with the largest key on the path from `u` to `v`, or -1 if the path has none. They
+     *         must be in the same tree.
+     */
+    int pathMax(int u, int v);
+
+    /**
+     * @return The lowest common ancestor of `u` and `v` in the rooting of the last `makeRoot`. They must be in the
+     *         same tree.
+     */
+    int lca(int u, int v);
+
+    /**
+     * @return The node just above `x` on its path to the root, or -1 if `x` is the root.
+     */
+    int parent(int x);
+
+    /**
+     * @brief Makes room for at least `count` label slots, at most 64, every new label starts at -1.
+     */
+    void reserveLabels(int count);
+
+    /**
+     * @brief Gives every node on the path from `u` to `v` the label `value` in a slot. They must be in the same tree.
+     */
+    void labelPath(int u, int v, int slot, int value);
+
+    /**
+     * @return The label of `x` in a slot, the last one a path through it was given, or -1 if none was.
+     */
+    int label(int x, int slot);
+};
+
+#endif
@@ -2,6 +2,29 @@
 #include "graph.hpp"
 #include "kruskal.hpp"
 #include "prim.hpp"
+#include "boruvka.hpp"
+#include "dense_prim.hpp"
+#include "forest.hpp"
+#include "parallel_prim.hpp"
+#include "parallel_boruvka.hpp"
+#include "kkt.hpp"
+#include "selector.hpp"
+#include "emst.hpp"
+#include "approx.hpp"
+#include "knn.hpp"
+#include "dendrogram.hpp"
+#include "sweep.hpp"
+#include "incremental.hpp"
+#include "dynamic_msf.hpp"
+#include "offline_msf.hpp"
+#include "delta.hpp"
+#include "sliding_window.hpp"
+#include "bottleneck.hpp"
+#include "verify.hpp"
+#include "boruvka_tree.hpp"
+#include "sensitivity.hpp"
+#include "topk.hpp"
+#include "rooted_tree.hpp"
 #include "CLI11.hpp"
 #include <iostream>
 #include <chrono>
@@ -13,25 +36,73 @@
 #include <cstdio>
 #include <cstring>
 #include <random>
+#include <tuple>
 #include "spinner.hpp"
 
 using namespace std;
 
-void createImage(const string &type, const string &algorithm, const string &graphFile, const string &outputPath)
+/**
+ * The global options every subcommand that runs an engine needs
+ */
+struct RunOptions
 {
-    const string tempFilePath("temp.dot");
-    ofstream outFile(tempFilePath);
-    Graph testGraph = loadGraphFromFile(graphFile);
-    MST mst;
+    // The seed of the randomized algorithms
+    unsigned seed = 1;
+    // The cost profile `auto` picks an engine with, written by `calibrate`
+    string profile = "mst_profile.txt";
+};
 
-    if (algorithm == "kruskal")
+/**
+ * Runs the MST algorithm picked with `-a/--algo` on a graph
+ */
+MST computeMST(const string &algorithm, Graph &graph, const RunOptions &options)
+{
+    if (algorithm == "auto")
+    {
+        string selected = selectAlgorithm(graphStats(graph, sharedPool().size()), CostProfile::load(options.profile));
+        cout << "Selected algorithm: " << selected << endl;
+        return computeMST(selected, graph, options);
+    }
+    else if (algorithm == "kruskal")
+    {
+        return kruskal_mst(graph);
+    }
+    else if (algorithm == "boruvka")
+    {
+        return boruvka_mst(graph);
+    }
+    else if (algorithm == "boruvka-parallel")
+    {
+        return parallel_boruvka_mst(graph);
+    }
+    else if (algorithm == "prim-bucket")
+    {
+        return prim_mst_queue<BucketQueue>(graph);
+    }
+    else if (algorithm == "prim-dense")
+    {
+        return prim_mst_dense(graph);
+    }
+    else if (algorithm == "prim-parallel")
     {
-        mst = kruskal_mst(testGraph);
+        return parallel_prim_mst(graph);
+    }
+    else if (algorithm == "kkt")
+    {
+        return kkt_mst(graph, options.seed);
     }
     else
     {
-        mst = prim_mst(testGraph);
+        return prim_mst(graph);
     }
+}
+
+void createImage(const string &type, const string &algorithm, const string &graphFile, const string &outputPath, const RunOptions &options)
+{
+    const string tempFilePath("temp.dot");
+    ofstream outFile(tempFilePath);
+    Graph testGraph = loadGraphFromFile(graphFile);
+    MST mst = computeMST(algorithm, testGraph, options);
 
     if (type == "graph")
     {
@@ -67,6 +138,28 @@ void createImage(const string &type, const string &algorithm, const string &grap
          << mst.totalWeight << endl;
 }
 
+/**
+ * Prints the minimum spanning forest of a graph file, one tree per connected component
+ */
+void printForest(const string &algorithm, const string &graphFile)
+{
+    Graph graph = loadGraphFromFile(graphFile);
+    MSF msf;
+    if (algorithm == "kruskal")
+    {
+        msf = kruskal_msf(graph);
+    }
+    else if (algorithm == "boruvka")
+    {
+        msf = splitForest(connectedComponents(graph), boruvka_mst(graph));
+    }
+    else
+    {
+        msf = prim_msf(graph);
+    }
+    msf.print();
+}
+
 void generateRandGraph(Graph &g, int V, int E)
 {
     std::random_device rd;
@@ -104,7 +197,8 @@ void runBenchmark(const string &outputFile)
     jms::Spinner s("Running Benchmark (This may take some time)", jms::classic);
     s.start();
     ofstream results(outputFile);
-    results << "Vertices,Edges,Kruskal,Prim\n";
+    // The Prim columns after the shipped one compare the arities of the indexed heap
+    results << "Vertices,Edges,Kruskal,Prim,Prim2,Prim4,Prim8,PrimDense,PrimParallel,Boruvka,BoruvkaParallel,Kkt\n";
 
     for (int i = 10; i <= 1000; i += 5)
     {
@@ -116,13 +210,1110 @@ void runBenchmark(const string &outputFile)
         generateRandGraph(g, i, e);
 
         long long timeKruskal = benchmarkMST(kruskal_mst, g);
+        long long timePrim = benchmarkMST(prim_mst, g);
+        long long timePrim2 = benchmarkMST(prim_mst_dary<2>, g);
+        long long timePrim4 = benchmarkMST(prim_mst_dary<4>, g);
+        long long timePrim8 = benchmarkMST(prim_mst_dary<8>, g);
+        long long timePrimDense = benchmarkMST([](Graph &graph)
+                                               { return prim_mst_dense(graph); }, g);
+        long long timePrimParallel = benchmarkMST([](Graph &graph)
+                                                  { return parallel_prim_mst(graph); }, g);
+        long long timeBoruvka = benchmarkMST(boruvka_mst, g);
+        long long timeBoruvkaParallel = benchmarkMST([](Graph &graph)
+                                                     { return parallel_boruvka_mst(graph); }, g);
+        long long timeKkt = benchmarkMST([](Graph &graph)
+                                         { return kkt_mst(graph); }, g);
 
-        results << i << "," << e << "," << timeKruskal << "," << 0.0 << "\n";
+        results << i << "," << e << "," << timeKruskal << "," << timePrim << ","
+                << timePrim2 << "," << timePrim4 << "," << timePrim8 << "," << timePrimDense << ","
+                << timePrimParallel << "," << timeBoruvka << "," << timeBoruvkaParallel << "," << timeKkt << "\n";
     }
     results.close();
     s.finish(jms::FinishedState::SUCCESS, "Finished Benchmark!");
 }
 
+/**
+ * Times Prim's algorithm with every priority queue policy, over a sweep of vertex counts and edge densities.
+ */
+void runHeapBenchmark(const string &outputFile)
+{
+    jms::Spinner s("Running Heap Benchmark (This may take some time)", jms::classic);
+    s.start();
+    ofstream results(outputFile);
+    results << "Vertices,Edges,Density,Binary,Dary4,Dary8,Pairing,Fibonacci,Bucket,Radix\n";
+
+    const vector<double> densities{0.01, 0.05, 0.1, 0.25, 0.5, 1.0};
+    for (int i = 250; i <= 2000; i *= 2)
+    {
+        for (double density : densities)
+        {
+            // Fraction of the edges of a complete graph
+            int e = static_cast<int>(density * i * (i - 1) / 2);
+            Graph g(i);
+            generateRandGraph(g, i, e);
+
+            results << i << "," << e << "," << density << ","
+                    << benchmarkMST(prim_mst_queue<BinaryHeap>, g) << ","
+                    << benchmarkMST(prim_mst_queue<IndexedDaryHeap<4>>, g) << ","
+                    << benchmarkMST(prim_mst_queue<IndexedDaryHeap<8>>, g) << ","
+                    << benchmarkMST(prim_mst_queue<PairingHeap>, g) << ","
+                    << benchmarkMST(prim_mst_queue<FibonacciHeap>, g) << ","
+                    << benchmarkMST(prim_mst_queue<BucketQueue>, g) << ","
+                    << benchmarkMST(prim_mst_queue<RadixHeap>, g) << "\n";
+        }
+    }
+    results.close();
+    s.finish(jms::FinishedState::SUCCESS, "Finished Heap Benchmark!");
+}
+
+/**
+ * Times the sparse graph engines on a fixed vertex count while the edge count grows, to show where the
+ * expected linear time KKT overtakes the O(E log E) sort of Kruskal's algorithm.
+ */
+void runScalingBenchmark(const string &outputFile, int verts)
+{
+    jms::Spinner s("Running Scaling Benchmark (This may take some time)", jms::classic);
+    s.start();
+    ofstream results(outputFile);
+    results << "Vertices,Edges,Kruskal,Boruvka,BoruvkaParallel,Kkt\n";
+
+    for (int degree = 1; degree <= 64; degree *= 2)
+    {
+        int e = verts * degree;
+        Graph g(verts);
+        generateRandGraph(g, verts, e);
+
+        results << verts << "," << e << ","
+                << benchmarkMST(kruskal_mst, g) << ","
+                << benchmarkMST(boruvka_mst, g) << ","
+                << benchmarkMST([](Graph &graph)
+                                { return parallel_boruvka_mst(graph); }, g)
+                << ","
+                << benchmarkMST([](Graph &graph)
+                                { return kkt_mst(graph); }, g)
+                << "\n";
+    }
+    results.close();
+    s.finish(jms::FinishedState::SUCCESS, "Finished Scaling Benchmark!");
+}
+
+/**
+ * Estimates the MST weight of a graph file, and builds the bucketed approximate tree if asked to
+ */
+void runApproximation(const string &graphFile, double epsilon, bool buildTree, unsigned seed)
+{
+    Graph graph = loadGraphFromFile(graphFile);
+    auto start = chrono::high_resolution_clock::now();
+    MSTEstimate estimate = estimate_mst_weight(graph, epsilon, seed);
+    auto end = chrono::high_resolution_clock::now();
+    cout << "Estimated MST Weight: " << fixed << setprecision(1) << estimate.weight
+         << ", Components: " << estimate.components << ", Samples: " << estimate.samples
+         << ", Edges Scanned: " << estimate.edgesScanned
+         << ", Time: " << chrono::duration_cast<chrono::microseconds>(end - start).count() << "us" << endl;
+
+    if (buildTree)
+    {
+        MST mst = approx_mst_buckets(graph, epsilon);
+        cout << "Approximate tree, within " << defaultfloat << setprecision(6) << 1 + epsilon << " times the minimum:" << endl;
+        mst.print();
+    }
+}
+
+/**
+ * Reports the speed and the accuracy of the approximations against Kruskal's algorithm, for several epsilons.
+ */
+void runApproxBenchmark(const string &outputFile)
+{
+    jms::Spinner s("Running Approximation Benchmark (This may take some time)", jms::classic);
+    s.start();
+    ofstream results(outputFile);
+    results << "Vertices,Edges,Epsilon,Kruskal,KruskalWeight,Estimate,EstimateWeight,EstimateError,Buckets,BucketsWeight,BucketsError\n";
+
+    const vector<double> epsilons{0.2, 0.1, 0.05};
+    for (int i = 10000; i <= 1000000; i *= 10)
+    {
+        int e = i * 4;
+        Graph g(i);
+        generateRandGraph(g, i, e);
+        // Keep the weights small enough that the totals fit in an int
+        for (auto &neighbors : g.adjList)
+        {
+            for (auto &[dest, weight] : neighbors)
+            {
+                weight = 1 + weight % 100;
+            }
+        }
+
+        MST exact;
+        long long timeKruskal = benchmarkMST([&](Graph &graph)
+                                             { return exact = kruskal_mst(graph); }, g);
+        for (double epsilon : epsilons)
+        {
+            MSTEstimate estimate;
+            long long timeEstimate = benchmarkMST([&](Graph &graph)
+                                                  { estimate = estimate_mst_weight(graph, epsilon);
+                                                    return MST(); }, g);
+            MST buckets;
+            long long timeBuckets = benchmarkMST([&](Graph &graph)
+                                                 { return buckets = approx_mst_buckets(graph, epsilon); }, g);
+
+            results << i << "," << e << "," << epsilon << "," << timeKruskal << "," << exact.totalWeight << ","
+                    << timeEstimate << "," << estimate.weight << ","
+                    << (estimate.weight - exact.totalWeight) / exact.totalWeight << ","
+                    << timeBuckets << "," << buckets.totalWeight << ","
+                    << static_cast<double>(buckets.totalWeight - exact.totalWeight) / exact.totalWeight << "\n";
+        }
+    }
+    results.close();
+    s.finish(jms::FinishedState::SUCCESS, "Finished Approximation Benchmark!");
+}
+
+/**
+ * Builds the single-linkage dendrogram of a graph file, cuts it, and writes the labels and the linkage matrix
+ */
+void runClustering(const string &graphFile, const string &algorithm, int k, int threshold, bool byThreshold,
+                   const string &labelsPath, const string &linkagePath, const RunOptions &options)
+{
+    Graph graph = loadGraphFromFile(graphFile);
+    auto start = chrono::high_resolution_clock::now();
+    // Kruskal records the merges as it goes, the other engines' trees are replayed in weight order
+    Dendrogram dendrogram = algorithm == "kruskal" ? single_linkage(graph)
+                                                   : dendrogramFromTree(graph.vertNumber(), computeMST(algorithm, graph, options));
+    auto end = chrono::high_resolution_clock::now();
+    cout << "Single-Linkage - Vertices: " << dendrogram.leaves << ", Merges: " << dendrogram.merges.size()
+         << ", Components: " << dendrogram.components()
+         << ", Time: " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << "ms" << endl;
+
+    if (k > 0 || byThreshold)
+    {
+        vector<int> labels = byThreshold ? cutThreshold(dendrogram, threshold) : cutClusters(dendrogram, k);
+        vector<int> sizes(labels.empty() ? 0 : *max_element(labels.begin(), labels.end()) + 1, 0);
+        for (int label : labels)
+        {
+            sizes[label]++;
+        }
+        cout << "Cut - Clusters: " << sizes.size()
+             << ", Largest: " << (sizes.empty() ? 0 : *max_element(sizes.begin(), sizes.end())) << endl;
+        if (!labelsPath.empty() && writeLabels(labels, labelsPath))
+        {
+            cout << "Labels written to: " << labelsPath << endl;
+        }
+    }
+    if (!linkagePath.empty() && writeLinkage(dendrogram, linkagePath))
+    {
+        cout << "Linkage written to: " << linkagePath << endl;
+    }
+}
+
+/**
+ * Sweeps the weight threshold of a graph file, writes the connectivity curve and answers the threshold queries
+ */
+void runThresholdSweep(const string &graphFile, const string &outputFile, const vector<int> &queries)
+{
+    Graph graph = loadGraphFromFile(graphFile);
+    auto start = chrono::high_resolution_clock::now();
+    ConnectivityCurve curve = threshold_sweep(graph);
+    auto end = chrono::high_resolution_clock::now();
+    cout << "Threshold Sweep - Vertices: " << curve.vertices << ", Points: " << curve.points.size()
+         << ", Time: " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << "ms" << endl;
+
+    if (!outputFile.empty())
+    {
+        ofstream results(outputFile);
+        results << "Weight,Components,Largest\n";
+        for (const auto &point : curve.points)
+        {
+            results << point.weight << "," << point.components << "," << point.largest << "\n";
+        }
+        cout << "Curve written to: " << outputFile << endl;
+    }
+    for (int threshold : queries)
+    {
+        ConnectivityCurve::Point point = curve.at(threshold);
+        cout << "Threshold " << threshold << " - Components: " << point.components << ", Largest: " << point.largest << endl;
+    }
+}
+
+/**
+ * Writes a tree as a .graph file
+ */
+void writeTree(const MST &mst, const string &name, int verts, const string &outputPath)
+{
+    ofstream outFile(outputPath);
+    outFile << name << "\n"
+            << verts << "\n";
+    for (const auto &edge : mst.edges)
+    {
+        outFile << edge.src << " " << edge.dest << " " << edge.weight << "\n";
+    }
+    cout << "Tree written to: " << outputPath << endl;
+}
+
+/**
+ * Compares keeping the MST up to date with `IncrementalMST` against rerunning Kruskal's algorithm after every batch
+ */
+void runIncrementalBenchmark(const string &outputFile)
+{
+    jms::Spinner s("Running Incremental Benchmark (This may take some time)", jms::classic);
+    s.start();
+    ofstream results(outputFile);
+    results << "Vertices,InitialEdges,BatchSize,Batches,KruskalPerBatch,IncrementalPerBatch,Weight\n";
+
+    const int batches = 10;
+    for (int i = 10000; i <= 1000000; i *= 10)
+    {
+        int e = i * 4;
+        Graph g(i);
+        generateRandGraph(g, i, e);
+        for (int batchSize : {100, 10000})
+        {
+            Graph grown = g;
+            IncrementalMST incremental(i, kruskal_mst(grown));
+            mt19937 random(batchSize);
+            uniform_int_distribution<int> vertex(1, i - 1);
+            long long timeKruskal = 0, timeIncremental = 0;
+            for (int batch = 0; batch < batches; batch++)
+            {
+                vector<Graph::Edge> edges;
+                for (int j = 0; j < batchSize; j++)
+                {
+                    int u = vertex(random), v = vertex(random);
+                    if (u != v)
+                    {
+                        edges.emplace_back(u, v, vertex(random));
+                    }
+                }
+                auto start = chrono::high_resolution_clock::now();
+                for (const auto &edge : edges)
+                {
+                    incremental.insertEdge(edge.src, edge.dest, edge.weight);
+                }
+                auto end = chrono::high_resolution_clock::now();
+                timeIncremental += chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+                for (const auto &edge : edges)
+                {
+                    grown.addEdge(edge.src, edge.dest, edge.weight);
+                }
+                timeKruskal += benchmarkMST(kruskal_mst, grown);
+            }
+            results << i << "," << e << "," << batchSize << "," << batches << "," << timeKruskal / batches << ","
+                    << timeIncremental / batches << "," << incremental.totalWeight() << "\n";
+        }
+    }
+    results.close();
+    s.finish(jms::FinishedState::SUCCESS, "Finished Incremental Benchmark!");
+}
+
+/**
+ * The cost of replaying an update log, per update
+ */
+struct ReplayResult
+{
+    double dynamicPerUpdate = 0;
+    double recomputePerUpdate = 0;
+    long long weight = 0;
+    // How often an edge moved up a level in a bucket of the dynamic forest, and how many edges its rebuilt buckets
+    // took in, which is what its cost is bounded by
+    long long promotions = 0;
+    long long rebuilt = 0;
+    // The checkpoints where the weight differed from the recomputed one
+    int mismatches = 0;
+};
+
+/**
+ * Replays an update log on a `DynamicMSF` built from the initial edges, and reruns Kruskal's algorithm on the live
+ * edges at evenly spaced checkpoints, which is what every update would cost without the dynamic forest. The weights
+ * of the two are compared at every checkpoint.
+ */
+ReplayResult replayUpdateLog(int verts, const vector<Graph::Edge> &initial, const vector<EdgeUpdate> &updates)
+{
+    const int checkpoints = 5;
+    DynamicMSF dynamic(verts, initial);
+    // The live edges, with the slot of every edge id, so a deletion can swap its edge out
+    vector<Graph::Edge> live;
+    vector<int> liveIds;
+    vector<int> slot(initial.size());
+    auto track = [&](int id, int u, int v, int w)
+    {
+        if (id >= static_cast<int>(slot.size()))
+        {
+            slot.resize(id + 1);
+        }
+        slot[id] = live.size();
+        live.emplace_back(u, v, w);
+        liveIds.push_back(id);
+    };
+    auto insert = [&](int u, int v, int w)
+    {
+        int id = dynamic.insertEdge(u, v, w);
+        if (id != -1)
+        {
+            track(id, u, v, w);
+        }
+    };
+    auto erase = [&](int id)
+    {
+        if (dynamic.deleteEdge(id))
+        {
+            int index = slot[id];
+            live[index] = live.back();
+            liveIds[index] = liveIds.back();
+            slot[liveIds[index]] = index;
+            live.pop_back();
+            liveIds.pop_back();
+        }
+    };
+    // Every initial edge but a self loop is live, with its index as its id
+    for (size_t i = 0; i < initial.size(); i++)
+    {
+        if (initial[i].src != initial[i].dest)
+        {
+            track(i, initial[i].src, initial[i].dest, initial[i].weight);
+        }
+    }
+
+    ReplayResult result;
+    long long timeDynamic = 0, timeRecompute = 0;
+    size_t next = 0;
+    for (int checkpoint = 1; checkpoint <= checkpoints; checkpoint++)
+    {
+        size_t last = updates.size() * checkpoint / checkpoints;
+        auto start = chrono::high_resolution_clock::now();
+        for (; next < last; next++)
+        {
+            const EdgeUpdate &update = updates[next];
+            if (update.insert)
+            {
+                insert(update.u, update.v, update.weight);
+            }
+            else
+            {
+                erase(dynamic.findEdge(update.u, update.v));
+            }
+        }
+        auto end = chrono::high_resolution_clock::now();
+        timeDynamic += chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+        Graph graph(verts);
+        for (const auto &edge : live)
+        {
+            graph.addEdge(edge.src, edge.dest, edge.weight);
+        }
+        start = chrono::high_resolution_clock::now();
+        MST expected = kruskal_mst(graph);
+        end = chrono::high_resolution_clock::now();
+        timeRecompute += chrono::duration_cast<chrono::microseconds>(end - start).count();
+        // Summed again, since the weight of a million vertex forest overflows the int total
+        long long expectedWeight = 0;
+        for (const auto &edge : expected.edges)
+        {
+            expectedWeight += edge.weight;
+        }
+        if (expectedWeight != dynamic.totalWeight())
+        {
+            result.mismatches++;
+        }
+    }
+    result.dynamicPerUpdate = updates.empty() ? 0 : static_cast<double>(timeDynamic) / updates.size();
+    result.recomputePerUpdate = static_cast<double>(timeRecompute) / checkpoints;
+    result.weight = dynamic.totalWeight();
+    result.promotions = dynamic.promotionCount();
+    result.rebuilt = dynamic.rebuiltEdges();
+    return result;
+}
+
+/**
+ * Compares keeping a minimum spanning forest up to date with `DynamicMSF` under insertions and deletions against
+ * recomputing it. Replays the log of a graph file if one is given, otherwise random logs on random graphs.
+ */
+void runDynamicBenchmark(const string &graphFile, const string &logFile, const string &outputFile)
+{
+    ofstream results(outputFile);
+    results << "Vertices,Edges,Updates,DeleteFraction,DynamicPerUpdate,RecomputePerUpdate,Weight,Promotions,Rebuilt,"
+               "Mismatches\n";
+    int mismatches = 0;
+    auto report = [&](int verts, size_t edges, const vector<EdgeUpdate> &updates, const ReplayResult &result)
+    {
+        mismatches += result.mismatches;
+        size_t deletes = count_if(updates.begin(), updates.end(), [](const EdgeUpdate &update)
+                                  { return !update.insert; });
+        double fraction = updates.empty() ? 0 : static_cast<double>(deletes) / updates.size();
+        results << verts << "," << edges << "," << updates.size() << "," << fraction << ","
+                << result.dynamicPerUpdate << "," << result.recomputePerUpdate << "," << result.weight << ","
+                << result.promotions << "," << result.rebuilt << "," << result.mismatches << "\n";
+    };
+
+    if (!logFile.empty())
+    {
+        Graph graph = loadGraphFromFile(graphFile);
+        vector<Graph::Edge> initial;
+        for (int u = 0; u < graph.vertNumber(); u++)
+        {
+            for (const auto &[v, w] : graph.adjList[u])
+            {
+                if (u < v)
+                {
+                    initial.emplace_back(u, v, w);
+                }
+            }
+        }
+        vector<EdgeUpdate> updates = loadUpdateLog(logFile);
+        ReplayResult result = replayUpdateLog(graph.vertNumber(), initial, updates);
+        cout << "Dynamic Replay - Updates: " << updates.size() << ", Weight: " << result.weight
+             << ", Dynamic: " << result.dynamicPerUpdate << "us per update, Recompute: " << result.recomputePerUpdate
+             << "us, Promotions: " << result.promotions << ", Rebuilt: " << result.rebuilt
+             << (result.mismatches == 0 ? " (matches)" : " (MISMATCH)") << endl;
+        report(graph.vertNumber(), initial.size(), updates, result);
+        cout << "Results written to: " << outputFile << endl;
+        return;
+    }
+
+    jms::Spinner s("Running Dynamic Benchmark (This may take some time)", jms::classic);
+    s.start();
+    const int updateCount = 100000;
+    for (int i = 10000; i <= 1000000; i *= 10)
+    {
+        int e = i * 4;
+        mt19937 random(i);
+        uniform_int_distribution<int> vertex(1, i - 1);
+        vector<Graph::Edge> initial;
+        for (int j = 0; j < e; j++)
+        {
+            int u = vertex(random), v = vertex(random);
+            if (u != v)
+            {
+                initial.emplace_back(u, v, vertex(random));
+            }
+        }
+        for (double deleteFraction : {0.1, 0.5})
+        {
+            // The deletions pick a live edge, so the log stays valid as the graph changes
+            vector<pair<int, int>> live;
+            for (const auto &edge : initial)
+            {
+                live.emplace_back(edge.src, edge.dest);
+            }
+            bernoulli_distribution deleting(deleteFraction);
+            vector<EdgeUpdate> updates;
+            for (int j = 0; j < updateCount; j++)
+            {
+                if (deleting(random) && !live.empty())
+                {
+                    size_t pick = random() % live.size();
+                    updates.push_back({false, live[pick].first, live[pick].second, 0});
+                    live[pick] = live.back();
+                    live.pop_back();
+                }
+                else
+                {
+                    int u = vertex(random), v = vertex(random);
+                    if (u != v)
+                    {
+                        updates.push_back({true, u, v, vertex(random)});
+                        live.emplace_back(u, v);
+                    }
+                }
+            }
+            report(i, initial.size(), updates, replayUpdateLog(i, initial, updates));
+        }
+    }
+    results.close();
+    if (mismatches != 0)
+    {
+        s.finish(jms::FinishedState::WARNING, "Finished Dynamic Benchmark, but " + to_string(mismatches) +
+                                                  " checkpoints did not match Kruskal's algorithm!");
+        return;
+    }
+    s.finish(jms::FinishedState::SUCCESS, "Finished Dynamic Benchmark!");
+}
+
+/**
+ * Streams edges through a `SlidingWindowMSF`, timing the edges from `warmup` on, and reruns Kruskal's algorithm on
+ * the edges of the window at evenly spaced checkpoints, which is what every edge would cost without it. The weights
+ * of the two are compared at every checkpoint.
+ */
+ReplayResult replayEdgeStream(int verts, long long window, const vector<EdgeUpdate> &stream, size_t warmup)
+{
+    const int checkpoints = 5;
+    SlidingWindowMSF sliding(verts, window);
+    size_t next = 0;
+    for (; next < min(warmup, stream.size()); next++)
+    {
+        sliding.addEdge(stream[next].time, stream[next].u, stream[next].v, stream[next].weight);
+    }
+
+    ReplayResult result;
+    long long timeSliding = 0, timeRecompute = 0;
+    size_t timed = stream.size() - next;
+    // The first edge of the stream still in the window
+    size_t first = 0;
+    for (int checkpoint = 1; checkpoint <= checkpoints; checkpoint++)
+    {
+        size_t last = warmup + timed * checkpoint / checkpoints;
+        auto start = chrono::high_resolution_clock::now();
+        for (; next < last; next++)
+        {
+            sliding.addEdge(stream[next].time, stream[next].u, stream[next].v, stream[next].weight);
+        }
+        auto end = chrono::high_resolution_clock::now();
+        timeSliding += chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+        Graph graph(verts);
+        while (first < next && stream[first].time <= sliding.time() - window)
+        {
+            first++;
+        }
+        for (size_t i = first; i < next; i++)
+        {
+            if (stream[i].u != stream[i].v && stream[i].u >= 0 && stream[i].v >= 0)
+            {
+                graph.addEdge(stream[i].u, stream[i].v, stream[i].weight);
+            }
+        }
+        start = chrono::high_resolution_clock::now();
+        MST expected = kruskal_mst(graph);
+        end = chrono::high_resolution_clock::now();
+        timeRecompute += chrono::duration_cast<chrono::microseconds>(end - start).count();
+        if (expected.totalWeight != sliding.totalWeight())
+        {
+            result.mismatches++;
+        }
+    }
+    result.dynamicPerUpdate = timed == 0 ? 0 : static_cast<double>(timeSliding) / timed;
+    result.recomputePerUpdate = static_cast<double>(timeRecompute) / checkpoints;
+    result.weight = sliding.totalWeight();
+    return result;
+}
+
+/**
+ * Compares keeping the MST of a sliding window of a timestamped edge stream with `SlidingWindowMSF` against
+ * recomputing it, and reports the throughput. Replays a stream file if one is given, otherwise random streams.
+ */
+void runWindowBenchmark(const string &streamFile, long long window, const string &outputFile)
+{
+    ofstream results(outputFile);
+    results << "Vertices,Window,StreamEdges,SlidingPerEdge,RecomputePerEdge,EdgesPerSecond,Weight,Mismatches\n";
+    int mismatches = 0;
+    auto report = [&](int verts, size_t edges, const ReplayResult &result)
+    {
+        mismatches += result.mismatches;
+        double throughput = result.dynamicPerUpdate > 0 ? 1e6 / result.dynamicPerUpdate : 0;
+        results << verts << "," << window << "," << edges << "," << result.dynamicPerUpdate << ","
+                << result.recomputePerUpdate << "," << static_cast<long long>(throughput) << "," << result.weight << ","
+                << result.mismatches << "\n";
+        return throughput;
+    };
+
+    if (!streamFile.empty())
+    {
+        vector<EdgeUpdate> stream = loadEdgeStream(streamFile);
+        int verts = 0;
+        for (const auto &edge : stream)
+        {
+            verts = max(verts, max(edge.u, edge.v) + 1);
+        }
+        ReplayResult result = replayEdgeStream(verts, window, stream, 0);
+        double throughput = report(verts, stream.size(), result);
+        cout << "Sliding Window - Edges: " << stream.size() << ", Weight: " << result.weight
+             << ", Sliding: " << result.dynamicPerUpdate << "us per edge (" << static_cast<long long>(throughput)
+             << " edges/s), Recompute: " << result.recomputePerUpdate << "us"
+             << (result.mismatches == 0 ? " (matches)" : " (MISMATCH)") << endl;
+        cout << "Results written to: " << outputFile << endl;
+        return;
+    }
+
+    jms::Spinner s("Running Sliding Window Benchmark (This may take some time)", jms::classic);
+    s.start();
+    for (int i = 10000; i <= 1000000; i *= 10)
+    {
+        // One edge per time unit, the window holds `2V` edges and the timing starts once it is full
+        window = 2LL * i;
+        mt19937 random(i);
+        uniform_int_distribution<int> vertex(0, i - 1);
+        vector<EdgeUpdate> stream;
+        for (long long t = 0; t < 3 * window; t++)
+        {
+            int u = vertex(random), v = vertex(random);
+            stream.push_back({true, u, v, vertex(random), t});
+        }
+        report(i, stream.size(), replayEdgeStream(i, window, stream, window));
+    }
+    results.close();
+    if (mismatches != 0)
+    {
+        s.finish(jms::FinishedState::WARNING, "Finished Sliding Window Benchmark, but " + to_string(mismatches) +
+                                                  " checkpoints did not match Kruskal's algorithm!");
+        return;
+    }
+    s.finish(jms::FinishedState::SUCCESS, "Finished Sliding Window Benchmark!");
+}
+
+/**
+ * Computes the minimum spanning forest after every step of an update log offline, and writes the timeline
+ */
+void runOfflineReplay(const string &graphFile, const string &logFile, const string &outputFile)
+{
+    vector<EdgeUpdate> updates = loadUpdateLog(logFile);
+    int verts = 0;
+    vector<Graph::Edge> initial;
+    if (!graphFile.empty())
+    {
+        Graph graph = loadGraphFromFile(graphFile);
+        verts = graph.vertNumber();
+        for (int u = 0; u < verts; u++)
+        {
+            for (const auto &[v, w] : graph.adjList[u])
+            {
+                if (u < v)
+                {
+                    initial.emplace_back(u, v, w);
+                }
+            }
+        }
+    }
+    // Without a graph, the log names every vertex
+    for (const auto &update : updates)
+    {
+        verts = max(verts, max(update.u, update.v) + 1);
+    }
+
+    auto start = chrono::high_resolution_clock::now();
+    ForestTimeline timeline = offline_msf(verts, initial, updates);
+    auto end = chrono::high_resolution_clock::now();
+    cout << "Offline Replay - Updates: " << updates.size() << ", Steps: " << timeline.steps.size()
+         << ", Final Weight: " << (timeline.steps.empty() ? 0 : timeline.steps.back().weight)
+         << ", Time: " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << "ms" << endl;
+
+    if (!outputFile.empty())
+    {
+        ofstream results(outputFile);
+        results << "Step,Time,Weight,Edges,Components\n";
+        for (size_t i = 0; i < timeline.steps.size(); i++)
+        {
+            const auto &step = timeline.steps[i];
+            results << i << "," << step.time << "," << step.weight << "," << step.edges << ","
+                    << timeline.vertices - step.edges << "\n";
+        }
+        cout << "Timeline written to: " << outputFile << endl;
+    }
+}
+
+/**
+ * Reads a tree written by `writeTree` in file order, a tree written by Kruskal's algorithm is already sorted by weight
+ *
+ * @return False if the file can't be read, has more vertices than `verts` or an edge outside of them
+ */
+bool loadTree(const string &treeFile, int verts, MST &tree)
+{
+    ifstream treeStream(treeFile);
+    string treeName;
+    int treeVerts = 0, src, dest, weight;
+    treeStream >> treeName >> treeVerts;
+    if (!treeStream || treeVerts > verts)
+    {
+        cerr << "Error loading the tree file, or it has more vertices than the graph." << endl;
+        return false;
+    }
+    while (treeStream >> src >> dest >> weight)
+    {
+        // The tree engines index arrays by vertex, so an edge to a vertex the graph lacks can not be let through
+        if (src < 0 || dest < 0 || src >= verts || dest >= verts)
+        {
+            cerr << "Tree edge " << src << " " << dest << " is out of range." << endl;
+            return false;
+        }
+        tree.edges.emplace_back(src, dest, weight);
+        tree.totalWeight += weight;
+    }
+    return true;
+}
+
+/**
+ * Applies a change set to a graph and its MST, and writes the new tree if an output is given
+ */
+void runDeltaUpdate(const string &graphFile, const string &treeFile, const string &deltaFile, const string &outputPath, bool check)
+{
+    Graph graph = loadGraphFromFile(graphFile);
+    MST tree;
+    if (!loadTree(treeFile, graph.vertNumber(), tree))
+    {
+        return;
+    }
+    vector<EdgeUpdate> delta = loadUpdateLog(deltaFile);
+
+    DeltaStats stats;
+    auto start = chrono::high_resolution_clock::now();
+    MST updated = apply_delta(graph, tree, delta, &stats);
+    auto end = chrono::high_resolution_clock::now();
+    cout << "Delta Update - Inserted: " << stats.inserted << ", Deleted: " << stats.deleted << ", Ignored: " << stats.ignored
+         << ", Tree Edges Cut: " << stats.cutEdges << ", Candidates: " << stats.candidates << endl;
+    cout << "Updated MST - Weight: " << updated.totalWeight << ", Edges: " << updated.edges.size()
+         << ", Time: " << chrono::duration_cast<chrono::microseconds>(end - start).count() << "us" << endl;
+
+    if (check)
+    {
+        start = chrono::high_resolution_clock::now();
+        MST expected = kruskal_mst(graph);
+        end = chrono::high_resolution_clock::now();
+        cout << "Kruskal - Weight: " << expected.totalWeight
+             << ", Time: " << chrono::duration_cast<chrono::microseconds>(end - start).count() << "us"
+             << (expected.totalWeight == updated.totalWeight ? " (matches)" : " (MISMATCH)") << endl;
+    }
+    if (!outputPath.empty())
+    {
+        writeTree(updated, graph.name, graph.vertNumber(), outputPath);
+    }
+}
+
+/**
+ * Checks a tree file, or the tree an algorithm computes, against a graph, and lists the edges that prove it is not
+ * minimal
+ *
+ * @return False if the tree is not a minimum spanning forest of the graph
+ */
+bool runVerify(const string &graphFile, const string &treeFile, const string &algorithm, int shown, const RunOptions &options)
+{
+    Graph graph = loadGraphFromFile(graphFile);
+    MST tree;
+    if (!treeFile.empty())
+    {
+        if (!loadTree(treeFile, graph.vertNumber(), tree))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        tree = computeMST(algorithm, graph, options);
+    }
+
+    auto start = chrono::high_resolution_clock::now();
+    VerifyReport report = verify_mst(graph, tree);
+    auto end = chrono::high_resolution_clock::now();
+    cout << "Verify - Tree Edges: " << report.treeEdges << ", Non-tree Edges Checked: " << report.checkedEdges
+         << ", Time: " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << "ms" << endl;
+    if (report.missingEdges > 0)
+    {
+        cout << "Tree edges not in the graph: " << report.missingEdges << endl;
+    }
+    if (report.cycleEdges > 0)
+    {
+        cout << "Tree edges closing a cycle: " << report.cycleEdges << endl;
+    }
+    if (report.unspannedEdges > 0)
+    {
+        cout << "Graph edges between two trees, so the tree does not span: " << report.unspannedEdges << endl;
+    }
+    if (!report.violations.empty())
+    {
+        cout << "Non-tree edges lighter than their tree path: " << report.violations.size() << endl;
+        for (size_t i = 0; i < report.violations.size() && static_cast<int>(i) < shown; i++)
+        {
+            const auto &violation = report.violations[i];
+            cout << "  Edge " << violation.edge.src << " " << violation.edge.dest << " with weight " << violation.edge.weight
+                 << " against a path max of " << violation.pathMax << endl;
+        }
+    }
+    cout << (report.valid() ? "The tree is a minimum spanning forest." : "The tree is NOT a minimum spanning forest.") << endl;
+    return report.valid();
+}
+
+/**
+ * Computes the replacement of every tree edge and the entry threshold of every other edge, and writes them as csv
+ */
+void runSensitivity(const string &graphFile, const string &treeFile, const string &algorithm, const string &outputPath,
+                    const RunOptions &options)
+{
+    Graph graph = loadGraphFromFile(graphFile);
+    MST tree;
+    if (!treeFile.empty())
+    {
+        if (!loadTree(treeFile, graph.vertNumber(), tree))
+        {
+            return;
+        }
+    }
+    else
+    {
+        tree = computeMST(algorithm, graph, options);
+    }
+
+    auto start = chrono::high_resolution_clock::now();
+    EdgeSensitivity sensitivity = edge_sensitivity(graph, tree);
+    auto end = chrono::high_resolution_clock::now();
+    // A replacement as heavy as the edge it replaces means another tree has the same weight
+    int ties = 0;
+    for (const auto &treeEdge : sensitivity.treeEdges)
+    {
+        if (treeEdge.replacement != -1 && sensitivity.nonTreeEdges[treeEdge.replacement].edge.weight == treeEdge.edge.weight)
+        {
+            ties++;
+        }
+    }
+    cout << "Sensitivity - Tree Edges: " << sensitivity.treeEdges.size() << ", Bridges: " << sensitivity.bridges()
+         << ", Non-tree Edges: " << sensitivity.nonTreeEdges.size()
+         << ", Time: " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << "ms" << endl;
+    cout << "Tree edges with an equally light replacement: " << ties
+         << (ties == 0 ? " (the MST is unique)" : " (the MST is not unique)") << endl;
+
+    if (!outputPath.empty())
+    {
+        // A tree edge stays in the tree up to the weight of its replacement, a non-tree edge joins it under its path max
+        ofstream results(outputPath);
+        results << "Kind,U,V,Weight,Threshold,ReplacementU,ReplacementV\n";
+        for (const auto &treeEdge : sensitivity.treeEdges)
+        {
+            const Graph::Edge &edge = treeEdge.edge;
+            results << "tree," << edge.src << "," << edge.dest << "," << edge.weight << ",";
+            if (treeEdge.replacement == -1)
+            {
+                results << "none,,\n";
+                continue;
+            }
+            const Graph::Edge &replacement = sensitivity.nonTreeEdges[treeEdge.replacement].edge;
+            results << replacement.weight << "," << replacement.src << "," << replacement.dest << "\n";
+        }
+        for (const auto &nonTree : sensitivity.nonTreeEdges)
+        {
+            const Graph::Edge &edge = nonTree.edge;
+            results << "nontree," << edge.src << "," << edge.dest << "," << edge.weight << ",";
+            results << (nonTree.pathMax == BoruvkaTree::NO_PATH ? string("none") : to_string(nonTree.pathMax)) << ",,\n";
+        }
+        cout << "Report written to: " << outputPath << endl;
+    }
+}
+
+/**
+ * Enumerates the k cheapest spanning trees of a graph, printing each one as soon as it is found
+ */
+void runTopK(const string &graphFile, int k, const string &outputPath)
+{
+    Graph graph = loadGraphFromFile(graphFile);
+    auto start = chrono::high_resolution_clock::now();
+    SpanningTreeEnumerator enumerator(graph);
+    ofstream results;
+    if (!outputPath.empty())
+    {
+        results.open(outputPath);
+        results << "Rank,Parent,Weight,RemovedU,RemovedV,RemovedWeight,AddedU,AddedV,AddedWeight\n";
+    }
+
+    // Every tree after the first is its parent with one edge swapped
+    RankedTree tree;
+    while (enumerator.foundCount() < k && enumerator.next(tree))
+    {
+        auto now = chrono::high_resolution_clock::now();
+        cout << "Tree " << tree.rank << " - Weight: " << tree.weight;
+        if (tree.parent != -1)
+        {
+            cout << ", Parent: " << tree.parent << ", Removed: " << tree.removed.src << " " << tree.removed.dest << " "
+                 << tree.removed.weight << ", Added: " << tree.added.src << " " << tree.added.dest << " " << tree.added.weight;
+        }
+        cout << ", Time: " << chrono::duration_cast<chrono::milliseconds>(now - start).count() << "ms" << endl;
+        if (results.is_open())
+        {
+            results << tree.rank << "," << tree.parent << "," << tree.weight;
+            if (tree.parent != -1)
+            {
+                results << "," << tree.removed.src << "," << tree.removed.dest << "," << tree.removed.weight
+                        << "," << tree.added.src << "," << tree.added.dest << "," << tree.added.weight << "\n";
+            }
+            else
+            {
+                results << ",,,,,,\n";
+            }
+            results.flush();
+        }
+    }
+    if (enumerator.foundCount() < k)
+    {
+        cout << "The graph has only " << enumerator.foundCount() << " spanning trees." << endl;
+    }
+    if (results.is_open())
+    {
+        cout << "Trees written to: " << outputPath << endl;
+    }
+}
+
+/**
+ * Roots the MST of a graph, prints its diameter and centers, and writes the per-vertex arrays as csv
+ */
+void runRootedTree(const string &graphFile, const string &algorithm, int root, const string &outputPath,
+                   const RunOptions &options)
+{
+    Graph graph = loadGraphFromFile(graphFile);
+    if (root >= graph.vertNumber())
+    {
+        cerr << "Root " << root << " is out of range." << endl;
+        return;
+    }
+    MST tree = computeMST(algorithm, graph, options);
+
+    auto start = chrono::high_resolution_clock::now();
+    RootedTree rooted = rootTree(graph.vertNumber(), tree, root);
+    TreePath diameter = treeDiameter(rooted);
+    vector<int> centers = treeCenters(rooted);
+    auto end = chrono::high_resolution_clock::now();
+    int height = rooted.depth.empty() ? 0 : *max_element(rooted.depth.begin(), rooted.depth.end());
+    cout << "Rooted Tree - Vertices: " << rooted.vertices << ", Trees: " << rooted.roots.size() << ", Height: " << height
+         << ", Time: " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << "ms" << endl;
+    if (diameter.from != -1)
+    {
+        cout << "Diameter: " << diameter.length << " between " << diameter.from << " and " << diameter.to << endl;
+    }
+    // A forest has a center per tree, so only the one of the chosen root is printed
+    if (!centers.empty())
+    {
+        cout << "Center of the tree of " << rooted.roots[0] << ": " << centers[0] << endl;
+    }
+
+    if (!outputPath.empty())
+    {
+        ofstream results(outputPath);
+        results << "Vertex,Parent,ParentWeight,Depth,Distance,Preorder,Postorder,SubtreeSize\n";
+        for (int v = 0; v < rooted.vertices; v++)
+        {
+            results << v << "," << rooted.parent[v] << "," << rooted.parentWeight[v] << "," << rooted.depth[v] << ","
+                    << rooted.distance[v] << "," << rooted.preorder[v] << "," << rooted.postorder[v] << ","
+                    << rooted.subtreeSize[v] << "\n";
+        }
+        cout << "Rooted tree written to: " << outputPath << endl;
+    }
+}
+
+/**
+ * Builds the path-max index of a graph's MST and answers bottleneck queries from a file, or random ones, in parallel
+ */
+void runBottleneckQueries(const string &graphFile, const string &algorithm, const string &queryFile, int randomQueries,
+                          const string &outputPath, const RunOptions &options)
+{
+    Graph graph = loadGraphFromFile(graphFile);
+    MST mst = computeMST(algorithm, graph, options);
+    auto start = chrono::high_resolution_clock::now();
+    PathMaxIndex index(graph.vertNumber(), mst);
+    auto end = chrono::high_resolution_clock::now();
+    cout << "Path Max Index - Vertices: " << graph.vertNumber()
+         << ", Build Time: " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << "ms" << endl;
+
+    vector<pair<int, int>> queries;
+    if (!queryFile.empty())
+    {
+        queries = loadQueries(queryFile);
+    }
+    else
+    {
+        mt19937 random(options.seed);
+        uniform_int_distribution<int> vertex(0, max(0, graph.vertNumber() - 1));
+        for (int i = 0; i < randomQueries; i++)
+        {
+            queries.emplace_back(vertex(random), vertex(random));
+        }
+    }
+    start = chrono::high_resolution_clock::now();
+    vector<int> answers = index.queryBatch(queries);
+    end = chrono::high_resolution_clock::now();
+    long long micros = chrono::duration_cast<chrono::microseconds>(end - start).count();
+    cout << "Queries: " << queries.size() << ", Time: " << micros / 1000 << "ms";
+    if (micros > 0)
+    {
+        cout << ", " << static_cast<long long>(queries.size() * 1e6 / micros) << " queries/s";
+    }
+    cout << endl;
+
+    // One line per query, `-` for a vertex and itself and `none` for vertices that are not connected
+    auto answerText = [](int answer)
+    {
+        return answer == PathMaxIndex::NO_EDGE ? string("-") : answer == PathMaxIndex::NO_PATH ? string("none") : to_string(answer);
+    };
+    if (!outputPath.empty())
+    {
+        ofstream results(outputPath);
+        for (size_t i = 0; i < queries.size(); i++)
+        {
+            results << queries[i].first << " " << queries[i].second << " " << answerText(answers[i]) << "\n";
+        }
+        cout << "Answers written to: " << outputPath << endl;
+    }
+    else if (!queryFile.empty())
+    {
+        for (size_t i = 0; i < queries.size(); i++)
+        {
+            cout << queries[i].first << " " << queries[i].second << " " << answerText(answers[i]) << "\n";
+        }
+    }
+}
+
+/**
+ * Computes the Euclidean MST of a point cloud file, and writes the tree as a .graph file if an output is given
+ */
+void runEuclideanMST(const string &pointsFile, const string &outputPath)
+{
+    PointCloud points = loadPointCloud(pointsFile);
+    auto start = chrono::high_resolution_clock::now();
+    MST mst = euclidean_mst(points);
+    auto end = chrono::high_resolution_clock::now();
+
+    cout << "Euclidean MST - Points: " << points.size() << ", Dimensions: " << points.dims
+         << ", Edges: " << mst.edges.size() << ", Length: " << fixed << setprecision(6) << treeLength(points, mst)
+         << ", Time: " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << "ms" << endl;
+
+    if (!outputPath.empty())
+    {
+        writeTree(mst, points.name.empty() ? "EMST" : points.name, points.size(), outputPath);
+    }
+}
+
+/**
+ * Builds the k-NN graph of a vector file and hands it straight to an MST engine
+ */
+void runKnnMST(const string &vectorsFile, int k, bool exact, double scale, bool recall, const string &algorithm,
+               const string &outputPath, const RunOptions &options)
+{
+    PointCloud points = loadVectors(vectorsFile);
+    auto start = chrono::high_resolution_clock::now();
+    KnnLists lists = exact ? knn_brute_force(points, k) : knn_descent(points, k, options.seed);
+    auto built = chrono::high_resolution_clock::now();
+    Graph graph = knnGraph(lists, scale);
+    MST mst = computeMST(algorithm, graph, options);
+    auto end = chrono::high_resolution_clock::now();
+
+    cout << "k-NN Graph - Points: " << points.size() << ", Dimensions: " << points.dims << ", k: " << k
+         << ", Edges: " << graph.edgeCount() << ", Mode: " << (exact ? "brute force" : "NN-descent")
+         << ", Time: " << chrono::duration_cast<chrono::milliseconds>(built - start).count() << "ms" << endl;
+    if (recall && !exact)
+    {
+        KnnLists truth = knn_brute_force(points, k);
+        cout << "Recall against brute force: " << fixed << setprecision(4) << knnRecall(lists, truth) << endl;
+    }
+    cout << "MST - Edges: " << mst.edges.size() << ", Total Weight: " << mst.totalWeight
+         << ", Time: " << chrono::duration_cast<chrono::milliseconds>(end - built).count() << "ms" << endl;
+
+    if (!outputPath.empty())
+    {
+        writeTree(mst, points.name.empty() ? "KNN" : points.name, points.size(), outputPath);
+    }
+}
+
+/**
+ * Times every engine on this machine and stores the fitted cost model for `-a auto`
+ */
+void runCalibration(const RunOptions &options, double scale)
+{
+    jms::Spinner s("Calibrating (This may take some time)", jms::classic);
+    s.start();
+    CostProfile profile = calibrateProfile([&](const string &engine, Graph &graph)
+                                           { return computeMST(engine, graph, options); },
+                                           sharedPool().size(), options.seed, scale);
+    if (!profile.save(options.profile))
+    {
+        s.finish(jms::FinishedState::FAILURE, "Could not write the profile!");
+        return;
+    }
+    s.finish(jms::FinishedState::SUCCESS, "Finished Calibration!");
+    cout << "Profile written to: " << options.profile << endl;
+}
+
 int main(int argc, char *argv[])
 {
     // Initialize CLI app
@@ -130,6 +1321,8 @@ int main(int argc, char *argv[])
 
     // One of the sub commands should be used
     app.require_subcommand(1);
+    // Let the global options come after the subcommand too, the subcommands inherit this when they are added
+    app.fallthrough();
 
     // The MST image generator subcommand
     CLI::App *mstGenApp = app.add_subcommand("mst", "REQUIRES GRAPHVIZ - Create an image of a graph file's MST");
@@ -137,31 +1330,269 @@ int main(int argc, char *argv[])
     CLI::App *graphGenApp = app.add_subcommand("graph", "REQUIRES GRAPHVIZ - Create an image of a graph file");
     // The benchmark subcommand
     CLI::App *benchmarkApp = app.add_subcommand("benchmark", "Run the benchmarking analysis for the algorithms");
+    // The spanning forest subcommand
+    CLI::App *forestApp = app.add_subcommand("forest", "Print the minimum spanning forest of a graph file, per connected component");
+    // The priority queue benchmark subcommand
+    CLI::App *heapBenchApp = app.add_subcommand("heaps", "Benchmark Prim's algorithm with every priority queue");
+    // The edge scaling benchmark subcommand
+    CLI::App *scalingBenchApp = app.add_subcommand("scaling", "Benchmark the sparse graph algorithms as the edge count grows");
+    // The approximate MST weight subcommand
+    CLI::App *approxApp = app.add_subcommand("approx", "Estimate the MST weight of a graph file in sublinear time");
+    // The approximation benchmark subcommand
+    CLI::App *approxBenchApp = app.add_subcommand("approx-benchmark", "Benchmark the speed and accuracy of the approximations against Kruskal's algorithm");
+    // The Euclidean MST subcommand
+    CLI::App *emstApp = app.add_subcommand("emst", "Compute the Euclidean MST of a point cloud file without building the complete graph");
+    // The k-NN graph subcommand
+    CLI::App *knnApp = app.add_subcommand("knn", "Build the k-nearest-neighbor graph of a vector file and compute its MST");
+    // The single-linkage clustering subcommand
+    CLI::App *clusterApp = app.add_subcommand("cluster", "Single-linkage clustering of a graph file from the merge order of its MST");
+    // The threshold sweep subcommand
+    CLI::App *sweepApp = app.add_subcommand("threshold-sweep", "Record how the connected components of a graph file change as the weight threshold rises");
+    // The incremental MST benchmark subcommand
+    CLI::App *incrementalBenchApp = app.add_subcommand("incremental-benchmark", "Benchmark inserting edge batches into a live MST against rerunning Kruskal's algorithm");
+    // The dynamic MST benchmark subcommand
+    CLI::App *dynamicBenchApp = app.add_subcommand("dynamic-benchmark", "Benchmark inserting and deleting edges in a live minimum spanning forest against recomputing it");
+    // The sliding window benchmark subcommand
+    CLI::App *windowBenchApp = app.add_subcommand("window-benchmark", "Benchmark the MST of a sliding window over a timestamped edge stream against recomputing it");
+    // The offline update log subcommand
+    CLI::App *offlineApp = app.add_subcommand("offline", "Compute the MST weight after every step of an update log, offline");
+    // The change set subcommand
+    CLI::App *updateApp = app.add_subcommand("update", "Apply a change set to a graph and bring its precomputed MST up to date");
+    // The bottleneck query subcommand
+    CLI::App *bottleneckApp = app.add_subcommand("bottleneck", "Answer the heaviest edge on the MST path between pairs of vertices, the bottleneck distance");
+    // The verification subcommand
+    CLI::App *verifyApp = app.add_subcommand("verify", "Check that a tree is a minimum spanning forest of a graph, in near-linear time");
+    // The edge sensitivity subcommand
+    CLI::App *sensitivityApp = app.add_subcommand("sensitivity", "Report the replacement of every MST edge and how light every other edge must get to enter the MST");
+    // The k best spanning trees subcommand
+    CLI::App *topkApp = app.add_subcommand("topk", "Enumerate the k cheapest spanning trees of a graph file, in increasing weight");
+    // The rooted tree subcommand
+    CLI::App *rootedApp = app.add_subcommand("rooted-tree", "Root the MST of a graph file and report its diameter, center and per-vertex tree arrays");
+    // The machine calibration subcommand
+    CLI::App *calibrateApp = app.add_subcommand("calibrate", "Time the algorithms on this machine and store the cost profile used by '-a auto'");
 
     // SECTION - CLI Options
+    // Global, shared by every parallel stage
+    app.add_option("-t,--threads", sharedPoolThreads(), "The number of worker threads for the parallel engines, 0 uses every core")->default_str("0");
+    RunOptions options;
+    app.add_option("-s,--seed", options.seed, "The seed of the randomized algorithms, the same seed gives the same result")->default_str("1");
+    app.add_option("-p,--profile", options.profile, "The cost profile used by '-a auto' and written by 'calibrate'")->default_str("mst_profile.txt");
+
     string algorithm = "kruskal";
-    mstGenApp->add_option("-a,--algo,algo", algorithm, "The algorithm can be 'kruskal' or 'prim'")->default_str("kruskal");
-    graphGenApp->add_option("-a,--algo,algo", algorithm, "The algorithm can be 'kruskal' or 'prim'")->default_str("kruskal");
+    const vector<string> algorithms{"auto", "kruskal", "prim", "prim-bucket", "prim-dense", "prim-parallel", "boruvka", "boruvka-parallel", "kkt"};
+    // Every subcommand that builds an MST takes the same engine choice
+    auto addAlgorithmOption = [&](CLI::App *subApp) -> CLI::Option *
+    {
+        return subApp->add_option("-a,--algo,algo", algorithm, "The algorithm can be 'auto', 'kruskal', 'prim', 'prim-bucket', 'prim-dense', 'prim-parallel', 'boruvka', 'boruvka-parallel' or 'kkt'")->default_str("kruskal")->check(CLI::IsMember(algorithms));
+    };
+    addAlgorithmOption(mstGenApp);
+    addAlgorithmOption(graphGenApp);
+    addAlgorithmOption(knnApp);
+    addAlgorithmOption(clusterApp);
+    addAlgorithmOption(bottleneckApp);
+    CLI::Option *verifyAlgoOption = addAlgorithmOption(verifyApp);
+    CLI::Option *sensitivityAlgoOption = addAlgorithmOption(sensitivityApp);
+    addAlgorithmOption(rootedApp);
+    forestApp->add_option("-a,--algo,algo", algorithm, "The algorithm can be 'kruskal', 'prim' or 'boruvka'")->default_str("kruskal")->check(CLI::IsMember({"kruskal", "prim", "boruvka"}));
 
     string inputGraph;
     mstGenApp->add_option("-g,--graph,graphP", inputGraph, "The path to the input .graph file")->required();
     graphGenApp->add_option("-g,--graph,graphP", inputGraph, "The path to the input .graph file")->required();
+    forestApp->add_option("-g,--graph,graphP", inputGraph, "The path to the input .graph file")->required();
 
     string outputFile = "output.csv";
     mstGenApp->add_option("-o,--output,output", outputFile, "The image file to output (should end with .png)")->required();
     graphGenApp->add_option("-o,--output,output", outputFile, "The image file to output (should end with .png)")->required();
     benchmarkApp->add_option("-o,--output,output", outputFile, "The csv file that should be created")->default_str("output.csv");
+    heapBenchApp->add_option("-o,--output,output", outputFile, "The csv file that should be created")->default_str("output.csv");
+    scalingBenchApp->add_option("-o,--output,output", outputFile, "The csv file that should be created")->default_str("output.csv");
+    incrementalBenchApp->add_option("-o,--output,output", outputFile, "The csv file that should be created")->default_str("output.csv");
+
+    approxApp->add_option("-g,--graph,graphP", inputGraph, "The path to the input .graph file")->required();
+    double epsilon = 0.1;
+    approxApp->add_option("-e,--epsilon", epsilon, "The target relative error")->default_str("0.1")->check(CLI::Range(0.001, 1.0));
+    bool approxTree = false;
+    approxApp->add_flag("--tree", approxTree, "Also build a tree within 1 + epsilon of the minimum, by rounding the weights into geometric buckets");
+    approxBenchApp->add_option("-o,--output,output", outputFile, "The csv file that should be created")->default_str("output.csv");
+
+    string inputPoints;
+    string treeOutput;
+    emstApp->add_option("-i,--points,points", inputPoints, "The path to the input .points file")->required();
+    emstApp->add_option("-o,--output", treeOutput, "The .graph file to write the tree to");
+
+    knnApp->add_option("-i,--vectors,vectors", inputPoints, "The path to the input .fvecs or .points file")->required();
+    knnApp->add_option("-o,--output", treeOutput, "The .graph file to write the tree to");
+    int neighbors = 10;
+    knnApp->add_option("-k,--neighbors", neighbors, "The number of neighbors of every point")->default_str("10")->check(CLI::Range(1, 1024));
+    bool exactKnn = false;
+    knnApp->add_flag("--exact", exactKnn, "Compare every pair instead of running NN-descent");
+    double weightScale = 1.0;
+    knnApp->add_option("--scale", weightScale, "Multiplies the distances before they are rounded to integer weights")->default_str("1.0")->check(CLI::PositiveNumber);
+    bool knnRecallCheck = false;
+    knnApp->add_flag("--recall", knnRecallCheck, "Also run brute force and report the recall of NN-descent");
+
+    clusterApp->add_option("-g,--graph,graphP", inputGraph, "The path to the input .graph file")->required();
+    int clusterCount = 0;
+    int clusterThreshold = 0;
+    string labelsOutput;
+    string linkageOutput;
+    CLI::Option *countOption = clusterApp->add_option("-k,--clusters", clusterCount, "Cut the dendrogram into this many clusters")->check(CLI::PositiveNumber);
+    CLI::Option *thresholdOption = clusterApp->add_option("--threshold", clusterThreshold, "Cut the dendrogram at this edge weight, joining the clusters of the edges up to it");
+    countOption->excludes(thresholdOption);
+    clusterApp->add_option("-l,--labels", labelsOutput, "The binary file to write the cluster labels to");
+    clusterApp->add_option("--linkage", linkageOutput, "The binary file to write the linkage matrix to");
+
+    sweepApp->add_option("-g,--graph,graphP", inputGraph, "The path to the input .graph file")->required();
+    string curveOutput;
+    sweepApp->add_option("-o,--output", curveOutput, "The csv file to write the curve to");
+    vector<int> sweepQueries;
+    sweepApp->add_option("-q,--query", sweepQueries, "Thresholds to report the components and the largest component at");
+
+    dynamicBenchApp->add_option("-o,--output,output", outputFile, "The csv file that should be created")->default_str("output.csv");
+    string updateLog;
+    CLI::Option *dynamicGraphOption = dynamicBenchApp->add_option("-g,--graph,graphP", inputGraph, "The path to the initial .graph file of the log");
+    CLI::Option *logOption = dynamicBenchApp->add_option("-l,--log", updateLog, "The update log to replay, '+ u v w' inserts an edge and '- u v' deletes one");
+    logOption->needs(dynamicGraphOption);
+    dynamicGraphOption->needs(logOption);
+
+    windowBenchApp->add_option("-o,--output,output", outputFile, "The csv file that should be created")->default_str("output.csv");
+    string edgeStream;
+    long long windowLength = 0;
+    CLI::Option *streamOption = windowBenchApp->add_option("-i,--stream", edgeStream, "The edge stream to replay, one 'time u v w' line per edge, in time order");
+    CLI::Option *windowOption = windowBenchApp->add_option("-w,--window", windowLength, "The length of the window, in the units of the timestamps")->check(CLI::PositiveNumber);
+    streamOption->needs(windowOption);
+    windowOption->needs(streamOption);
+
+    offlineApp->add_option("-l,--log", updateLog, "The update log, '[time] + u v w' inserts an edge and '[time] - u v' deletes one")->required();
+    offlineApp->add_option("-g,--graph,graphP", inputGraph, "The path to the .graph file of the edges present before the log");
+    string timelineOutput;
+    offlineApp->add_option("-o,--output", timelineOutput, "The csv file to write the weight after every step to");
+
+    updateApp->add_option("-g,--graph,graphP", inputGraph, "The path to the .graph file before the changes")->required();
+    string treeInput;
+    updateApp->add_option("-m,--mst", treeInput, "The path to the .graph file of its MST")->required();
+    string deltaInput;
+    updateApp->add_option("-d,--delta", deltaInput, "The change set, '+ u v w' inserts an edge, '- u v' deletes one and '= u v w' reweights it")->required();
+    updateApp->add_option("-o,--output", treeOutput, "The .graph file to write the new tree to");
+    bool checkUpdate = false;
+    updateApp->add_flag("--check", checkUpdate, "Also rerun Kruskal's algorithm on the changed graph and compare");
+
+    bottleneckApp->add_option("-g,--graph,graphP", inputGraph, "The path to the input .graph file")->required();
+    string queryInput;
+    CLI::Option *queryOption = bottleneckApp->add_option("-q,--queries", queryInput, "The query file, one 'u v' pair per line");
+    int randomQueries = 0;
+    CLI::Option *randomOption = bottleneckApp->add_option("--random", randomQueries, "Answer this many random queries instead, to measure the throughput")->check(CLI::PositiveNumber);
+    queryOption->excludes(randomOption);
+    string answersOutput;
+    bottleneckApp->add_option("-o,--output", answersOutput, "The file to write 'u v weight' answers to");
+
+    verifyApp->add_option("-g,--graph,graphP", inputGraph, "The path to the input .graph file")->required();
+    CLI::Option *verifyTreeOption = verifyApp->add_option("-m,--mst", treeInput, "The path to the .graph file of the tree to check, instead of running an algorithm");
+    verifyTreeOption->excludes(verifyAlgoOption);
+    int shownViolations = 10;
+    verifyApp->add_option("--show", shownViolations, "The number of offending edges to list")->default_str("10")->check(CLI::NonNegativeNumber);
+
+    sensitivityApp->add_option("-g,--graph,graphP", inputGraph, "The path to the input .graph file")->required();
+    CLI::Option *sensitivityTreeOption = sensitivityApp->add_option("-m,--mst", treeInput, "The path to the .graph file of its MST, instead of running an algorithm");
+    sensitivityTreeOption->excludes(sensitivityAlgoOption);
+    string reportOutput;
+    sensitivityApp->add_option("-o,--output", reportOutput, "The csv file to write the per-edge report to");
+
+    topkApp->add_option("-g,--graph,graphP", inputGraph, "The path to the input .graph file")->required();
+    int treeCount = 10;
+    topkApp->add_option("-k,--trees", treeCount, "The number of trees to find")->default_str("10")->check(CLI::PositiveNumber);
+    string rankingOutput;
+    topkApp->add_option("-o,--output", rankingOutput, "The csv file to write every tree to, as a swap from an earlier one");
+
+    rootedApp->add_option("-g,--graph,graphP", inputGraph, "The path to the input .graph file")->required();
+    int treeRootVertex = 0;
+    rootedApp->add_option("-r,--root", treeRootVertex, "The vertex to root the tree at, the other trees of a forest are rooted at their lowest vertex")->default_str("0")->check(CLI::NonNegativeNumber);
+    string rootedOutput;
+    rootedApp->add_option("-o,--output", rootedOutput, "The csv file to write the parent, depth, orders and subtree size of every vertex to");
+
+    double calibrationScale = 1.0;
+    calibrateApp->add_option("--scale", calibrationScale, "Multiplies the size of the calibration graphs, smaller is faster but noisier")->default_str("1.0")->check(CLI::Range(0.01, 10.0));
+
+    int scalingVertices = 100000;
+    scalingBenchApp->add_option("-v,--vertices", scalingVertices, "The number of vertices, the edge count grows from 1 to 64 times this")->default_str("100000")->check(CLI::Range(2, 1 << 24));
 
     // SECTION - Subcommand Callbacks
     mstGenApp->callback([&]()
-                        { createImage("mst", algorithm, inputGraph, outputFile); });
+                        { createImage("mst", algorithm, inputGraph, outputFile, options); });
 
     graphGenApp->callback([&]()
-                          { createImage("graph", algorithm, inputGraph, outputFile); });
+                          { createImage("graph", algorithm, inputGraph, outputFile, options); });
 
     benchmarkApp->callback([&]()
                            { runBenchmark(outputFile); });
 
+    forestApp->callback([&]()
+                        { printForest(algorithm, inputGraph); });
+
+    heapBenchApp->callback([&]()
+                           { runHeapBenchmark(outputFile); });
+
+    scalingBenchApp->callback([&]()
+                              { runScalingBenchmark(outputFile, scalingVertices); });
+
+    approxApp->callback([&]()
+                        { runApproximation(inputGraph, epsilon, approxTree, options.seed); });
+
+    approxBenchApp->callback([&]()
+                             { runApproxBenchmark(outputFile); });
+
+    emstApp->callback([&]()
+                      { runEuclideanMST(inputPoints, treeOutput); });
+
+    knnApp->callback([&]()
+                     { runKnnMST(inputPoints, neighbors, exactKnn, weightScale, knnRecallCheck, algorithm, treeOutput, options); });
+
+    clusterApp->callback([&]()
+                         { runClustering(inputGraph, algorithm, clusterCount, clusterThreshold, thresholdOption->count() > 0,
+                                         labelsOutput, linkageOutput, options); });
+
+    sweepApp->callback([&]()
+                       { runThresholdSweep(inputGraph, curveOutput, sweepQueries); });
+
+    incrementalBenchApp->callback([&]()
+                                  { runIncrementalBenchmark(outputFile); });
+
+    dynamicBenchApp->callback([&]()
+                              { runDynamicBenchmark(inputGraph, updateLog, outputFile); });
+
+    windowBenchApp->callback([&]()
+                             { runWindowBenchmark(edgeStream, windowLength, outputFile); });
+
+    offlineApp->callback([&]()
+                         { runOfflineReplay(inputGraph, updateLog, timelineOutput); });
+
+    updateApp->callback([&]()
+                        { runDeltaUpdate(inputGraph, treeInput, deltaInput, treeOutput, checkUpdate); });
+
+    bottleneckApp->callback([&]()
+                            { runBottleneckQueries(inputGraph, algorithm, queryInput, randomQueries, answersOutput, options); });
+
+    verifyApp->callback([&]()
+                        {
+                            // A nonzero exit status, so scripts can use it as an oracle
+                            if (!runVerify(inputGraph, treeInput, algorithm, shownViolations, options))
+                            {
+                                throw CLI::RuntimeError(1);
+                            }
+                        });
+
+    sensitivityApp->callback([&]()
+                             { runSensitivity(inputGraph, treeInput, algorithm, reportOutput, options); });
+
+    topkApp->callback([&]()
+                      { runTopK(inputGraph, treeCount, rankingOutput); });
+
+    rootedApp->callback([&]()
+                        { runRootedTree(inputGraph, algorithm, treeRootVertex, rootedOutput, options); });
+
+    calibrateApp->callback([&]()
+                           { runCalibration(options, calibrationScale); });
+
     CLI11_PARSE(app, argc, argv);
     return 0;
 }
@@ -0,0 +1,263 @@
+#include "graph.hpp"
+#include "offline_msf.hpp"
+#include <vector>
+#include <numeric>
+#include <iostream>
+#include <algorithm>
+#include <unordered_map>
+
+using namespace std;
+
+namespace
+{
+    /**
+     * An edge and the steps [begin, end) it is alive over
+     */
+    struct Lifetime
+    {
+        int u;
+        int v;
+        int weight;
+        int begin;
+        int end;
+    };
+}
+
+/**
+ * Divide and conquer over the steps of a log, after Eppstein's offline dynamic MST.
+ *
+ * A call for the steps [l, r) gets the edges alive over all of them, which are fixed there, and the edges alive
+ * over only some of them, which change. With the changing edges forced in first, the fixed edges Kruskal's
+ * algorithm still takes are in the forest at every step of the interval, so they are contracted. Without the
+ * changing edges, the fixed edges it rejects close a cycle of lighter fixed edges, so they are in none of the
+ * forests and are dropped. What is left of the fixed edges is no more than the changing edges, so every level of
+ * the recursion handles O(U) edges, and the contractions are undone on the way back up.
+ */
+class OfflineSolver
+{
+private:
+    // The edges sorted by weight, so sorted lists of ids are in Kruskal's order
+    const vector<Lifetime> &lives;
+    ForestTimeline &timeline;
+    RollbackUnionFind components;
+    // A union-find over the roots of `components`, for one pass of Kruskal's algorithm at a time
+    vector<int> scratch;
+    vector<int> touched;
+    long long weight = 0;
+    int forestEdges = 0;
+
+    int scratchFind(int x)
+    {
+        while (scratch[x] != x)
+        {
+            scratch[x] = scratch[scratch[x]];
+            x = scratch[x];
+        }
+        return x;
+    }
+
+    /**
+     * Joins the components of an edge in the scratch union-find
+     *
+     * @return True if the edge joined two components
+     */
+    bool scratchMerge(int id)
+    {
+        int x = scratchFind(components.find(lives[id].u));
+        int y = scratchFind(components.find(lives[id].v));
+        if (x == y)
+        {
+            return false;
+        }
+        scratch[y] = x;
+        touched.push_back(y);
+        return true;
+    }
+
+    void resetScratch()
+    {
+        for (int x : touched)
+        {
+            scratch[x] = x;
+        }
+        touched.clear();
+    }
+
+    void contract(int id)
+    {
+        components.merge(lives[id].u, lives[id].v);
+        weight += lives[id].weight;
+        forestEdges++;
+    }
+
+public:
+    OfflineSolver(int vertices, const vector<Lifetime> &lives, ForestTimeline &timeline)
+        : lives(lives), timeline(timeline), components(vertices), scratch(vertices)
+    {
+        iota(scratch.begin(), scratch.end(), 0);
+    }
+
+    void solve(int l, int r, const vector<int> &fixed, const vector<int> &changing)
+    {
+        // The changing edges alive over all of [l, r) are fixed here, the ones that miss it or became loops are gone
+        vector<int> covering, partial;
+        for (int id : changing)
+        {
+            const Lifetime &edge = lives[id];
+            if (edge.end <= l || edge.begin >= r || components.find(edge.u) == components.find(edge.v))
+            {
+                continue;
+            }
+            if (edge.begin <= l && edge.end >= r)
+            {
+                covering.push_back(id);
+            }
+            else
+            {
+                partial.push_back(id);
+            }
+        }
+        vector<int> all;
+        all.reserve(fixed.size() + covering.size());
+        merge(fixed.begin(), fixed.end(), covering.begin(), covering.end(), back_inserter(all));
+
+        size_t point = components.checkpoint();
+        long long savedWeight = weight;
+        int savedEdges = forestEdges;
+
+        if (r - l == 1)
+        {
+            for (int id : all)
+            {
+                if (components.find(lives[id].u) != components.find(lives[id].v))
+                {
+                    contract(id);
+                }
+            }
+            timeline.steps[l].weight = weight;
+            timeline.steps[l].edges = forestEdges;
+        }
+        else
+        {
+            // Contraction, with every changing edge in the forest first
+            for (int id : partial)
+            {
+                scratchMerge(id);
+            }
+            vector<int> contracted, kept;
+            for (int id : all)
+            {
+                (scratchMerge(id) ? contracted : kept).push_back(id);
+            }
+            resetScratch();
+            for (int id : contracted)
+            {
+                contract(id);
+            }
+
+            // Reduction, with none of the changing edges
+            vector<int> reduced;
+            for (int id : kept)
+            {
+                if (scratchMerge(id))
+                {
+                    reduced.push_back(id);
+                }
+            }
+            resetScratch();
+
+            int m = l + (r - l) / 2;
+            solve(l, m, reduced, partial);
+            solve(m, r, reduced, partial);
+        }
+
+        components.rollback(point);
+        weight = savedWeight;
+        forestEdges = savedEdges;
+    }
+};
+
+/**
+ * Computes the minimum spanning forest after every step of an update log, offline.
+ *
+ * Consecutive updates with the same time form one step. A deletion removes the last inserted live edge between its
+ * endpoints, and is ignored if there is none. Runs in O(U log U log V) for U updates.
+ *
+ * @param vertices The number of vertices
+ * @param initial The edges present before the first step
+ * @param updates The log
+ * @return The weight and the edge count of the forest after every step
+ */
+ForestTimeline offline_msf(int vertices, const vector<Graph::Edge> &initial, const vector<EdgeUpdate> &updates)
+{
+    ForestTimeline timeline;
+    timeline.vertices = vertices;
+    vector<int> stepOf(updates.size());
+    for (size_t i = 0; i < updates.size(); i++)
+    {
+        if (i == 0 || updates[i].time != updates[i - 1].time)
+        {
+            timeline.steps.push_back({updates[i].time, 0, 0});
+        }
+        stepOf[i] = timeline.steps.size() - 1;
+    }
+    int steps = timeline.steps.size();
+    if (steps == 0)
+    {
+        return timeline;
+    }
+
+    vector<Lifetime> lives;
+    // The live edges between every pair of endpoints, the last inserted at the back
+    unordered_map<uint64_t, vector<int>> open;
+    auto valid = [&](int u, int v)
+    {
+        if (u < 0 || v < 0 || u >= vertices || v >= vertices)
+        {
+            cerr << "Edge " << u << " " << v << " is out of range." << endl;
+            return false;
+        }
+        return u != v;
+    };
+    for (const auto &edge : initial)
+    {
+        if (valid(edge.src, edge.dest))
+        {
+            open[endpointKey(edge.src, edge.dest)].push_back(lives.size());
+            lives.push_back({edge.src, edge.dest, edge.weight, 0, steps});
+        }
+    }
+    for (size_t i = 0; i < updates.size(); i++)
+    {
+        const EdgeUpdate &update = updates[i];
+        if (!valid(update.u, update.v))
+        {
+            continue;
+        }
+        if (update.insert)
+        {
+            open[endpointKey(update.u, update.v)].push_back(lives.size());
+            lives.push_back({update.u, update.v, update.weight, stepOf[i], steps});
+            continue;
+        }
+        auto parallel = open.find(endpointKey(update.u, update.v));
+        if (parallel != open.end() && !parallel->second.empty())
+        {
+            lives[parallel->second.back()].end = stepOf[i];
+            parallel->second.pop_back();
+        }
+    }
+
+    // An edge inserted and deleted within one step is never seen
+    lives.erase(remove_if(lives.begin(), lives.end(), [](const Lifetime &edge)
+                          { return edge.begin >= edge.end; }),
+                lives.end());
+    stable_sort(lives.begin(), lives.end(), [](const Lifetime &a, const Lifetime &b)
+                { return a.weight < b.weight; });
+    vector<int> ids(lives.size());
+    iota(ids.begin(), ids.end(), 0);
+
+    OfflineSolver solver(vertices, lives, timeline);
+    solver.solve(0, steps, {}, ids);
+    return timeline;
+}
@@ -0,0 +1,113 @@
+#ifndef OFFLINE_MSF_HPP
+#define OFFLINE_MSF_HPP
+
+#include "graph.hpp"
+#include <vector>
+#include <utility>
+
+/**
+ * @brief A union-find that can undo its merges, most recent first.
+ *
+ * Union by size without path compression keeps every `find` at O(log n), and leaves each merge as a single parent
+ * change, so undoing it only needs the root that was hung under the other.
+ */
+class RollbackUnionFind
+{
+private:
+    // The parent vector
+    std::vector<int> parent;
+    // The size of the set of every root
+    std::vector<int> size;
+    // The roots that were hung under another root, in order
+    std::vector<int> history;
+
+public:
+    // Constructor
+    explicit RollbackUnionFind(int numElements) : parent(numElements), size(numElements, 1)
+    {
+        for (int i = 0; i < numElements; i++)
+        {
+            parent[i] = i;
+        }
+    }
+
+    /**
+     * Find without path compression
+     */
+    int find(int x) const
+    {
+        while (parent[x] != x)
+        {
+            x = parent[x];
+        }
+        return x;
+    }
+
+    /**
+     * Size based set union
+     *
+     * @return True if `x` and `y` were in different sets
+     */
+    bool merge(int x, int y)
+    {
+        int xRoot = find(x);
+        int yRoot = find(y);
+        if (xRoot == yRoot)
+        {
+            return false;
+        }
+        if (size[xRoot] < size[yRoot])
+        {
+            std::swap(xRoot, yRoot);
+        }
+        parent[yRoot] = xRoot;
+        size[xRoot] += size[yRoot];
+        history.push_back(yRoot);
+        return true;
+    }
+
+    /**
+     * @return A point to roll back to, the number of merges so far
+     */
+    size_t checkpoint() const
+    {
+        return history.size();
+    }
+
+    /**
+     * Undoes the merges made since `point`, most recent first
+     */
+    void rollback(size_t point)
+    {
+        while (history.size() > point)
+        {
+            int child = history.back();
+            history.pop_back();
+            size[parent[child]] -= size[child];
+            parent[child] = child;
+        }
+    }
+};
+
+/**
+ * @brief The minimum spanning forest after every step of an update log.
+ */
+struct ForestTimeline
+{
+    /**
+     * @brief The forest once every update of a step is applied.
+     */
+    struct Step
+    {
+        long long time;   /**< The time of the updates of the step. */
+        long long weight; /**< The total weight of the forest. */
+        int edges;        /**< The number of edges in the forest. */
+    };
+
+    int vertices = 0;        /**< The number of vertices. */
+    std::vector<Step> steps; /**< One entry per step, in the order of the log. */
+};
+
+ForestTimeline offline_msf(int vertices, const std::vector<Graph::Edge> &initial, const std::vector<EdgeUpdate> &updates);
+
+#endif
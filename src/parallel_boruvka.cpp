@@ -0,0 +1,137 @@
+#include "graph.hpp"
+#include "parallel_boruvka.hpp"
+#include "kruskal.hpp"
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * An edge between two current components, `id` is the index of the original edge.
+ */
+struct ContractedEdge
+{
+    int u;
+    int v;
+    int weight;
+    int id;
+};
+
+/**
+ * Implementation of parallel Borůvka's Algorithm
+ *
+ * Every round runs on the work-stealing pool in four parallel steps:
+ *  1. Each edge offers itself to both of its components with an atomic min, ties broken by position.
+ *  2. Each component hooks onto its lightest edge through a `ConcurrentUnionFind`. Only the first merge of a
+ *     pair succeeds, so an edge picked by both sides is added once.
+ *  3. The surviving roots are numbered with a parallel prefix sum.
+ *  4. The edges are relabelled to the new numbers, and the ones inside a component are filtered out with a
+ *     second prefix sum.
+ * Every round at least halves the number of components, so there are O(log V) rounds.
+ *
+ * @param graph The graph to perform the algorithm on
+ * @param pool The pool the rounds run on
+ * @return A `MST` object with the minimum spanning tree of the graph
+ */
+MST parallel_boruvka_mst(Graph &graph, ThreadPool &pool)
+{
+    MST mst;
+
+    // The original edges, each one only once
+    vector<Graph::Edge> original;
+    vector<ContractedEdge> edges;
+    for (int u = 0; u < graph.vertNumber(); u++)
+    {
+        for (const auto &[dest, weight] : graph.adjList[u])
+        {
+            if (u < dest)
+            {
+                edges.push_back({u, dest, weight, static_cast<int>(original.size())});
+                original.emplace_back(u, dest, weight);
+            }
+        }
+    }
+
+    int grain = 2048;
+    int verts = graph.vertNumber();
+    vector<int> treeEdges;
+    while (!edges.empty())
+    {
+        int edgeCount = edges.size();
+
+        // Step 1, the lightest edge of every component
+        vector<atomic<uint64_t>> lightest(verts);
+        pool.parallelFor(0, verts, [&](int v)
+                         { lightest[v].store(UINT64_MAX, memory_order_relaxed); }, grain);
+        pool.parallelFor(0, edgeCount, [&](int i)
+                         {
+                             uint64_t rank = edgeRank(edges[i].weight, i);
+                             for (int side : {edges[i].u, edges[i].v})
+                             {
+                                 uint64_t current = lightest[side].load(memory_order_relaxed);
+                                 while (rank < current && !lightest[side].compare_exchange_weak(current, rank, memory_order_relaxed))
+                                 {
+                                 }
+                             } }, grain);
+
+        // Step 2, hook the components together
+        ConcurrentUnionFind components(verts);
+        vector<int> picked(verts, -1);
+        pool.parallelFor(0, verts, [&](int v)
+                         {
+                             uint64_t rank = lightest[v].load(memory_order_relaxed);
+                             if (rank == UINT64_MAX)
+                             {
+                                 return;
+                             }
+                             const ContractedEdge &edge = edges[static_cast<uint32_t>(rank)];
+                             if (components.merge(edge.u, edge.v))
+                             {
+                                 picked[v] = edge.id;
+                             } }, grain);
+        for (int id : picked)
+        {
+            if (id != -1)
+            {
+                treeEdges.push_back(id);
+            }
+        }
+
+        // Step 3, number the roots with a prefix sum
+        vector<int> label(verts);
+        pool.parallelFor(0, verts, [&](int v)
+                         { label[v] = components.find(v) == v ? 1 : 0; }, grain);
+        vector<int> rootIndex = label;
+        int next = exclusiveScan(pool, rootIndex);
+        pool.parallelFor(0, verts, [&](int v)
+                         { label[v] = rootIndex[components.find(v)]; }, grain);
+
+        // Step 4, relabel the edges and filter out the ones that are now inside a component
+        vector<int> keep(edgeCount);
+        pool.parallelFor(0, edgeCount, [&](int i)
+                         {
+                             edges[i].u = label[edges[i].u];
+                             edges[i].v = label[edges[i].v];
+                             keep[i] = edges[i].u != edges[i].v ? 1 : 0; }, grain);
+        vector<int> position = keep;
+        int kept = exclusiveScan(pool, position);
+        vector<ContractedEdge> remaining(kept);
+        pool.parallelFor(0, edgeCount, [&](int i)
+                         {
+                             if (keep[i])
+                             {
+                                 remaining[position[i]] = edges[i];
+                             } }, grain);
+        edges.swap(remaining);
+        verts = next;
+    }
+
+    for (int id : treeEdges)
+    {
+        mst.edges.push_back(original[id]);
+        mst.totalWeight += original[id].weight;
+    }
+    return mst;
+}
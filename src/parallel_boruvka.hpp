@@ -0,0 +1,9 @@
+#ifndef PARALLEL_BORUVKA_HPP
+#define PARALLEL_BORUVKA_HPP
+
+#include "graph.hpp"
+#include "thread_pool.hpp"
+
+MST parallel_boruvka_mst(Graph &graph, ThreadPool &pool = sharedPool());
+
+#endif
@@ -0,0 +1,265 @@
+#include "graph.hpp"
+#include "parallel_prim.hpp"
+#include "heap.hpp"
+#include "kruskal.hpp"
+#include <vector>
+#include <atomic>
+#include <random>
+#include <numeric>
+#include <cstdint>
+#include <cstdlib>
+#include <climits>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * An edge of the current contracted graph, `id` is the index of the original edge.
+ */
+struct LevelEdge
+{
+    int u;
+    int v;
+    int weight;
+    int id;
+};
+
+/**
+ * The current contracted graph in CSR form, the neighbours of `u` are `adjacency[offsets[u]]` onwards.
+ */
+struct LevelGraph
+{
+    int verts = 0;
+    vector<int> offsets;
+    vector<LevelEdge> adjacency; // Stored as seen from `u`, so `v` is always the neighbour
+
+    LevelGraph(int n, const vector<LevelEdge> &edges) : verts(n), offsets(n + 1, 0)
+    {
+        for (const auto &edge : edges)
+        {
+            offsets[edge.u + 1]++;
+            offsets[edge.v + 1]++;
+        }
+        partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        adjacency.resize(offsets[n]);
+        vector<int> fill(offsets.begin(), offsets.end() - 1);
+        for (const auto &edge : edges)
+        {
+            adjacency[fill[edge.u]++] = edge;
+            adjacency[fill[edge.v]++] = {edge.v, edge.u, edge.weight, edge.id};
+        }
+    }
+};
+
+/**
+ * Grows Prim fragments from many seeds at once, each worker with its own heap
+ *
+ * A worker claims the vertices of its fragment with a compare-and-swap on `owner`. When the lightest edge out of
+ * the fragment leads to a vertex that another fragment owns, or that is claimed first by someone else, the
+ * fragment stops and the worker moves on to the next unclaimed seed. Every edge added is the lightest edge
+ * leaving its fragment, so the fragments are all pieces of a minimum spanning forest.
+ *
+ * @return The label of the fragment of each vertex
+ */
+static vector<int> growFragments(const LevelGraph &graph, ThreadPool &pool, vector<int> &treeEdges)
+{
+    int n = graph.verts;
+    vector<atomic<int>> owner(n);
+    for (auto &slot : owner)
+    {
+        slot.store(-1, memory_order_relaxed);
+    }
+
+    // Seeds are taken in a random order so the workers start far apart
+    vector<int> seeds(n);
+    iota(seeds.begin(), seeds.end(), 0);
+    shuffle(seeds.begin(), seeds.end(), mt19937(rand()));
+    atomic<int> nextSeed(0);
+
+    int workers = pool.size();
+    vector<vector<int>> found(workers);
+    pool.parallelFor(0, workers, [&](int worker)
+                     {
+                         IndexedDaryHeap<4> heap(n);
+                         vector<int> via(n, -1);
+                         vector<int> &edges = found[worker];
+
+                         auto relax = [&](int u, int fragment)
+                         {
+                             for (int i = graph.offsets[u]; i < graph.offsets[u + 1]; i++)
+                             {
+                                 const LevelEdge &edge = graph.adjacency[i];
+                                 if (owner[edge.v].load(memory_order_relaxed) == fragment)
+                                 {
+                                     continue;
+                                 }
+                                 if (!heap.contains(edge.v))
+                                 {
+                                     heap.push(edge.v, edge.weight);
+                                     via[edge.v] = i;
+                                 }
+                                 else if (edge.weight < heap.key(edge.v))
+                                 {
+                                     heap.decreaseKey(edge.v, edge.weight);
+                                     via[edge.v] = i;
+                                 }
+                             }
+                         };
+
+                         while (true)
+                         {
+                             int index = nextSeed.fetch_add(1);
+                             if (index >= n)
+                             {
+                                 return;
+                             }
+                             int seed = seeds[index];
+                             int expected = -1;
+                             if (!owner[seed].compare_exchange_strong(expected, seed))
+                             {
+                                 continue;
+                             }
+
+                             // The fragment is named after its seed
+                             relax(seed, seed);
+                             while (!heap.empty())
+                             {
+                                 int v = heap.popMin();
+                                 expected = -1;
+                                 if (!owner[v].compare_exchange_strong(expected, seed))
+                                 {
+                                     // Collision, the lightest way out leads into another fragment
+                                     break;
+                                 }
+                                 edges.push_back(graph.adjacency[via[v]].id);
+                                 relax(v, seed);
+                             }
+                             heap.clear();
+                         } });
+
+    for (const auto &edges : found)
+    {
+        treeEdges.insert(treeEdges.end(), edges.begin(), edges.end());
+    }
+    vector<int> fragment(n);
+    for (int v = 0; v < n; v++)
+    {
+        fragment[v] = owner[v].load(memory_order_relaxed);
+    }
+    return fragment;
+}
+
+/**
+ * Implementation of parallel multi-seed Prim's Algorithm
+ *
+ * Each round grows Prim fragments from many seeds in parallel (see `growFragments`). The fragments are then
+ * merged Borůvka style, every fragment hooks onto its lightest outgoing edge, and the merged fragments are
+ * contracted into the vertices of the next round. The hooking step at least halves the number of vertices, so
+ * there are O(log V) rounds, and a disconnected graph gives a minimum spanning forest.
+ *
+ * @param graph The graph to perform the algorithm on
+ * @param pool The pool the fragments are grown on
+ * @return A `MST` object with the minimum spanning tree of the graph
+ */
+MST parallel_prim_mst(Graph &graph, ThreadPool &pool)
+{
+    MST mst;
+
+    // The original edges, each one only once
+    vector<Graph::Edge> original;
+    vector<LevelEdge> edges;
+    for (int u = 0; u < graph.vertNumber(); u++)
+    {
+        for (const auto &[dest, weight] : graph.adjList[u])
+        {
+            if (u < dest)
+            {
+                edges.push_back({u, dest, weight, static_cast<int>(original.size())});
+                original.emplace_back(u, dest, weight);
+            }
+        }
+    }
+
+    vector<int> treeEdges;
+    int verts = graph.vertNumber();
+    while (verts > 1 && !edges.empty())
+    {
+        LevelGraph level(verts, edges);
+        vector<int> fragment = growFragments(level, pool, treeEdges);
+
+        // Borůvka step, find the lightest edge leaving each fragment with an atomic min
+        vector<atomic<uint64_t>> lightest(verts);
+        for (auto &slot : lightest)
+        {
+            slot.store(UINT64_MAX, memory_order_relaxed);
+        }
+        int grain = max(1024, static_cast<int>(edges.size() / (pool.size() * 8)));
+        pool.parallelFor(0, edges.size(), [&](int i)
+                         {
+                             const LevelEdge &edge = edges[i];
+                             int a = fragment[edge.u], b = fragment[edge.v];
+                             if (a == b)
+                             {
+                                 return;
+                             }
+                             uint64_t rank = edgeRank(edge.weight, i);
+                             for (int side : {a, b})
+                             {
+                                 uint64_t current = lightest[side].load(memory_order_relaxed);
+                                 while (rank < current && !lightest[side].compare_exchange_weak(current, rank))
+                                 {
+                                 }
+                             } }, grain);
+
+        // Hook the fragments together, an edge picked from both sides is only added once
+        UnionFind merged(verts);
+        for (int v = 0; v < verts; v++)
+        {
+            merged.merge(v, fragment[v]);
+        }
+        for (int v = 0; v < verts; v++)
+        {
+            uint64_t rank = lightest[v].load(memory_order_relaxed);
+            if (rank == UINT64_MAX)
+            {
+                continue;
+            }
+            const LevelEdge &edge = edges[static_cast<uint32_t>(rank)];
+            if (merged.find(edge.u) != merged.find(edge.v))
+            {
+                merged.merge(edge.u, edge.v);
+                treeEdges.push_back(edge.id);
+            }
+        }
+
+        // Contract, every merged group becomes one vertex and the edges inside a group are dropped
+        vector<int> label(verts, -1);
+        int next = 0;
+        for (int v = 0; v < verts; v++)
+        {
+            int root = merged.find(v);
+            if (label[root] == -1)
+            {
+                label[root] = next++;
+            }
+            label[v] = label[root];
+        }
+        vector<LevelEdge> remaining;
+        for (const auto &edge : edges)
+        {
+            if (label[edge.u] != label[edge.v])
+            {
+                remaining.push_back({label[edge.u], label[edge.v], edge.weight, edge.id});
+            }
+        }
+        edges.swap(remaining);
+        verts = next;
+    }
+
+    for (int id : treeEdges)
+    {
+        mst.edges.push_back(original[id]);
+        mst.totalWeight += original[id].weight;
+    }
+    return mst;
+}
@@ -0,0 +1,9 @@
+#ifndef PARALLEL_PRIM_HPP
+#define PARALLEL_PRIM_HPP
+
+#include "graph.hpp"
+#include "thread_pool.hpp"
+
+MST parallel_prim_mst(Graph &graph, ThreadPool &pool = sharedPool());
+
+#endif
@@ -2,7 +2,188 @@
 #define PRIM_HPP
 
 #include "graph.hpp"
+#include "heap.hpp"
+#include <vector>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+#include <type_traits>
+
+// The heap arity used by `prim_mst`, can be overridden at compile time with -DPRIM_HEAP_ARITY=8
+#ifndef PRIM_HEAP_ARITY
+#define PRIM_HEAP_ARITY 4
+#endif
 
 MST prim_mst(Graph &graph);
 
-#endif
\ No newline at end of file
+/**
+ * Builds a priority queue policy for `prim_mst_queue`, passing the largest key to the queues that need it.
+ */
+template <typename Queue>
+Queue makeQueue(int verts, int maxKey)
+{
+    if constexpr (std::is_constructible_v<Queue, int, int>)
+        return Queue(verts, maxKey);
+    else
+        return Queue(verts);
+}
+
+/**
+ * Checks that a priority queue policy can hold every key in `[minKey, maxKey]`. The bucket based queues say so with
+ * a static `acceptsKeys`, the comparison based ones take any key.
+ */
+template <typename Queue, typename = void>
+struct HasKeyRange : std::false_type
+{
+};
+
+template <typename Queue>
+struct HasKeyRange<Queue, std::void_t<decltype(Queue::acceptsKeys(0, 0))>> : std::true_type
+{
+};
+
+template <typename Queue>
+bool queueAcceptsKeys(int minKey, int maxKey)
+{
+    if constexpr (HasKeyRange<Queue>::value)
+        return Queue::acceptsKeys(minKey, maxKey);
+    else
+        return true;
+}
+
+/**
+ * Prim's Algorithm over a subset of the vertices, growing one tree per connected component
+ *
+ * The key, parent and visited arrays are indexed by local ids `0..verts-1`, so a single component can be
+ * processed with arrays and a queue the size of that component. When the first tree is done, the next one
+ * starts from the lowest local id that is still unvisited.
+ *
+ * @param graph The graph to perform the algorithm on
+ * @param start The local id of the first vertex
+ * @param verts The number of vertices in the subset
+ * @param queue An empty priority queue over the local ids
+ * @param toLocal Maps a vertex id to its local id
+ * @param toGlobal Maps a local id back to its vertex id
+ * @return A `MST` object with the minimum spanning forest of the subset
+ */
+template <typename Queue, typename ToLocal, typename ToGlobal>
+MST prim_grow(const Graph &graph, int start, int verts, Queue &queue, ToLocal toLocal, ToGlobal toGlobal)
+{
+    MST mst;
+
+    // Flat arrays indexed by local id, the visited flag, the cheapest known edge weight and where it comes from
+    std::vector<char> visited(verts, 0);
+    std::vector<int> key(verts, INT_MAX);
+    std::vector<int> parent(verts, -1);
+
+    int nextStart = 0;
+    while (start != -1)
+    {
+        key[start] = 0;
+        queue.push(start, 0);
+
+        // Loop until the queue is empty, which means everything reachable from the start is in the tree
+        while (!queue.empty())
+        {
+            int u = queue.popMin();
+            int vertex = toGlobal(u);
+            visited[u] = 1;
+
+            // Add the edge to our MST, per our spec the edge should go from the lower vertex to the higher vertex.
+            if (parent[u] != -1)
+            {
+                if (parent[u] > vertex)
+                    mst.edges.push_back(Graph::Edge(vertex, parent[u], key[u]));
+                else
+                    mst.edges.push_back(Graph::Edge(parent[u], vertex, key[u]));
+                mst.totalWeight += key[u];
+            }
+
+            // For all adjacent edges from the new vertex
+            for (const auto &[dest, weight] : graph.adjList[vertex])
+            {
+                int v = toLocal(dest);
+                if (!visited[v] && weight < key[v])
+                {
+                    // We have a new minimum weight to reach the vertex, either lower its key or add it to the queue
+                    key[v] = weight;
+                    parent[v] = vertex;
+                    if (queue.contains(v))
+                        queue.decreaseKey(v, weight);
+                    else
+                        queue.push(v, weight);
+                }
+            }
+        }
+
+        // Start the next tree from the first vertex the previous ones did not reach
+        while (nextStart < verts && visited[nextStart])
+        {
+            nextStart++;
+        }
+        start = nextStart < verts ? nextStart : -1;
+    }
+    return mst;
+}
+
+/**
+ * Implementation of Prim's Algorithm over a priority queue policy
+ *
+ * Each vertex is in the queue at most once, and its key is lowered in place when a cheaper edge is found,
+ * so the queue never holds more than V entries. See `heap.hpp` for the available policies. A bucket based policy
+ * that can not hold the graph's weights, negative ones or too wide a range, falls back to `prim_mst`.
+ * A disconnected graph gives a minimum spanning forest, like `kruskal_mst`.
+ *
+ * @tparam Queue The priority queue policy
+ * @param graph The graph to perform the algorithm on
+ * @return A `MST` object with the minimum spanning tree of the graph
+ */
+template <typename Queue>
+MST prim_mst_queue(Graph &graph)
+{
+    int verts = graph.vertNumber();
+    if (verts == 0)
+    {
+        return MST();
+    }
+
+    // The bucket based queues need to know the key range up front
+    int minWeight = 0, maxWeight = 0;
+    for (const auto &neighbors : graph.adjList)
+    {
+        for (const auto &[dest, weight] : neighbors)
+        {
+            minWeight = std::min(minWeight, weight);
+            maxWeight = std::max(maxWeight, weight);
+        }
+    }
+    if (!queueAcceptsKeys<Queue>(minWeight, maxWeight))
+    {
+        std::cerr << "The edge weights " << minWeight << " to " << maxWeight
+                  << " do not fit this priority queue, falling back to the d-ary heap." << std::endl;
+        return prim_mst(graph);
+    }
+
+    Queue queue = makeQueue<Queue>(verts, maxWeight);
+    auto identity = [](int v)
+    { return v; };
+
+    // Pick random vertex to Start
+    return prim_grow(graph, rand() % verts, verts, queue, identity, identity);
+}
+
+/**
+ * Implementation of Prim's Algorithm on an indexed d-ary heap
+ *
+ * @tparam Arity The arity of the heap
+ * @param graph The graph to perform the algorithm on
+ * @return A `MST` object with the minimum spanning tree of the graph
+ */
+template <int Arity>
+MST prim_mst_dary(Graph &graph)
+{
+    return prim_mst_queue<IndexedDaryHeap<Arity>>(graph);
+}
+
+#endif
@@ -0,0 +1,382 @@
+#include "graph.hpp"
+#include "rooted_tree.hpp"
+#include <vector>
+#include <utility>
+#include <iostream>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * Roots every tree of a forest and lays it out as flat arrays, in O(V). The forest is walked breadth first, and the
+ * depth-first preorder is placed from the subtree sizes afterwards.
+ *
+ * @param verts The number of vertices
+ * @param tree A spanning forest, an edge that would close a cycle is left out
+ * @param root The root of its tree, the other trees are rooted at their lowest vertex
+ * @param orders False to leave `distance`, `order`, `preorder`, `postorder`, `euler` and `firstVisit` empty, for a
+ * caller that only climbs parents and walks children
+ * @return The rooted forest
+ */
+RootedTree rootTree(int verts, const MST &tree, int root, bool orders)
+{
+    RootedTree rooted;
+    rooted.vertices = verts;
+
+    // The forest in CSR form, with the edge and its weight next to the neighbor so the walk reads one place
+    struct Arc
+    {
+        int to;
+        int edge;
+        int weight;
+    };
+    vector<int> offset(verts + 1, 0);
+    for (const auto &edge : tree.edges)
+    {
+        if (edge.src < 0 || edge.dest < 0 || edge.src >= verts || edge.dest >= verts)
+        {
+            cerr << "Edge " << edge.src << " " << edge.dest << " is out of range." << endl;
+            continue;
+        }
+        offset[edge.src + 1]++;
+        offset[edge.dest + 1]++;
+    }
+    for (int v = 0; v < verts; v++)
+    {
+        offset[v + 1] += offset[v];
+    }
+    vector<Arc> arcs(offset[verts]);
+    {
+        vector<int> fill(offset.begin(), offset.end() - 1);
+        for (int i = 0; i < static_cast<int>(tree.edges.size()); i++)
+        {
+            const auto &edge = tree.edges[i];
+            if (edge.src >= 0 && edge.dest >= 0 && edge.src < verts && edge.dest < verts)
+            {
+                arcs[fill[edge.src]++] = {edge.dest, i, edge.weight};
+                arcs[fill[edge.dest]++] = {edge.src, i, edge.weight};
+            }
+        }
+    }
+
+    // A breadth-first walk, since the vertices to expand next are already known and their cache misses overlap,
+    // where a depth-first walk waits on every one. Everything is recorded by breadth-first position, where a parent
+    // comes before its children and the parents of neighboring positions are neighbors too.
+    struct Step
+    {
+        int up;     // The position of the parent, -1 at a root
+        int edge;   // The edge to the parent
+        int weight; // Its weight
+        int depth;
+        int size;
+        int tree; // The index of the tree in `roots`
+    };
+    vector<int> bfs;
+    vector<Step> steps;
+    bfs.reserve(verts);
+    steps.reserve(verts);
+    vector<char> visited(verts, 0);
+    auto walk = [&](int top)
+    {
+        visited[top] = 1;
+        bfs.push_back(top);
+        steps.push_back({-1, -1, 0, 0, 1, static_cast<int>(rooted.roots.size())});
+        rooted.roots.push_back(top);
+        for (size_t next = bfs.size() - 1; next < bfs.size(); next++)
+        {
+            int x = bfs[next];
+            for (int k = offset[x]; k < offset[x + 1]; k++)
+            {
+                const Arc &arc = arcs[k];
+                // The parent, or a vertex reached another way when the edges have a cycle
+                if (visited[arc.to])
+                {
+                    continue;
+                }
+                visited[arc.to] = 1;
+                bfs.push_back(arc.to);
+                steps.push_back({static_cast<int>(next), arc.edge, arc.weight, 0, 1, 0});
+            }
+        }
+    };
+    if (root >= 0 && root < verts)
+    {
+        walk(root);
+    }
+    for (int v = 0; v < verts; v++)
+    {
+        if (!visited[v])
+        {
+            walk(v);
+        }
+    }
+
+    // Depths fill forwards and subtree sizes backwards
+    for (auto &step : steps)
+    {
+        if (step.up != -1)
+        {
+            const Step &above = steps[step.up];
+            step.depth = above.depth + 1;
+            step.tree = above.tree;
+        }
+    }
+    for (int b = verts - 1; b > 0; b--)
+    {
+        if (steps[b].up != -1)
+        {
+            steps[steps[b].up].size += steps[b].size;
+        }
+    }
+
+    vector<int> bfsAt(verts);
+    for (int b = 0; b < verts; b++)
+    {
+        bfsAt[bfs[b]] = b;
+    }
+
+    // The depth-first preorder that visits children in edge order, as the breadth-first walk meets them: a child
+    // starts right after its parent and the subtrees of its earlier siblings. The distances fill forwards too.
+    vector<int> pre, upAt;
+    vector<long long> distance;
+    if (orders)
+    {
+        pre.resize(verts);
+        distance.resize(verts);
+        vector<int> slot(verts);
+        int nextTree = 0;
+        for (int b = 0; b < verts; b++)
+        {
+            const Step &step = steps[b];
+            if (step.up == -1)
+            {
+                pre[b] = nextTree;
+                nextTree += step.size;
+                distance[b] = 0;
+            }
+            else
+            {
+                pre[b] = slot[step.up];
+                slot[step.up] += step.size;
+                distance[b] = distance[step.up] + step.weight;
+            }
+            slot[b] = pre[b] + 1;
+        }
+
+        rooted.order.resize(verts);
+        upAt.resize(verts);
+        for (int b = 0; b < verts; b++)
+        {
+            rooted.order[pre[b]] = bfs[b];
+            upAt[pre[b]] = steps[b].up == -1 ? -1 : pre[steps[b].up];
+        }
+    }
+
+    // Filled vertex by vertex, so the stores are in order and only the steps are read at random
+    rooted.treeRoot.resize(verts);
+    rooted.parent.resize(verts);
+    rooted.parentWeight.resize(verts);
+    rooted.parentEdge.resize(verts);
+    rooted.depth.resize(verts);
+    rooted.subtreeSize.resize(verts);
+    for (int v = 0; v < verts; v++)
+    {
+        const Step &step = steps[bfsAt[v]];
+        rooted.treeRoot[v] = rooted.roots[step.tree];
+        rooted.parent[v] = step.up == -1 ? -1 : bfs[step.up];
+        rooted.parentWeight[v] = step.weight;
+        rooted.parentEdge[v] = step.edge;
+        rooted.depth[v] = step.depth;
+        rooted.subtreeSize[v] = step.size;
+    }
+
+    if (orders)
+    {
+        // Before a vertex is finished, every earlier vertex but its ancestors is, and so are its descendants. Before
+        // it is first reached, the tour has visited every earlier vertex and returned over every finished edge of
+        // its tree.
+        rooted.distance.resize(verts);
+        rooted.preorder.resize(verts);
+        rooted.postorder.resize(verts);
+        rooted.firstVisit.resize(verts);
+        for (int v = 0; v < verts; v++)
+        {
+            int b = bfsAt[v];
+            const Step &step = steps[b];
+            rooted.distance[v] = distance[b];
+            rooted.preorder[v] = pre[b];
+            rooted.postorder[v] = pre[b] - step.depth + step.size - 1;
+            rooted.firstVisit[v] = 2 * pre[b] - step.depth - step.tree;
+        }
+
+        // The tour climbs back from the previous vertex to the parent of the next one, or to its root between trees
+        rooted.euler.reserve(max(0, 2 * verts - static_cast<int>(rooted.roots.size())));
+        for (int p = 0; p <= verts; p++)
+        {
+            int target = p < verts ? upAt[p] : -1;
+            for (int x = p - 1; x >= 0 && x != target && upAt[x] != -1;)
+            {
+                x = upAt[x];
+                rooted.euler.push_back(rooted.order[x]);
+            }
+            if (p < verts)
+            {
+                rooted.euler.push_back(rooted.order[p]);
+            }
+        }
+    }
+
+    // Filled in breadth-first order, where the siblings come in the order the preorder visits them
+    rooted.childStart.assign(verts + 1, 0);
+    for (int v = 0; v < verts; v++)
+    {
+        if (rooted.parent[v] != -1)
+        {
+            rooted.childStart[rooted.parent[v] + 1]++;
+        }
+    }
+    for (int v = 0; v < verts; v++)
+    {
+        rooted.childStart[v + 1] += rooted.childStart[v];
+    }
+    rooted.children.resize(rooted.childStart[verts]);
+    vector<int> fill(rooted.childStart.begin(), rooted.childStart.end() - 1);
+    for (int b = 0; b < verts; b++)
+    {
+        if (steps[b].up != -1)
+        {
+            rooted.children[fill[bfs[steps[b].up]]++] = bfs[b];
+        }
+    }
+    return rooted;
+}
+
+TreePath treeDiameter(const RootedTree &rooted)
+{
+    TreePath best;
+    // The longest path from every vertex down into its subtree, and where it ends
+    vector<long long> down(rooted.vertices, 0);
+    vector<int> downEnd(rooted.vertices);
+    for (int i = rooted.vertices - 1; i >= 0; i--)
+    {
+        int v = rooted.order[i];
+        // The two longest paths down through different children, the vertex itself counts as a path of length 0
+        long long first = 0, second = 0;
+        int firstEnd = v, secondEnd = v;
+        for (int k = rooted.childStart[v]; k < rooted.childStart[v + 1]; k++)
+        {
+            int c = rooted.children[k];
+            long long length = down[c] + rooted.parentWeight[c];
+            if (length > first)
+            {
+                second = first;
+                secondEnd = firstEnd;
+                first = length;
+                firstEnd = downEnd[c];
+            }
+            else if (length > second)
+            {
+                second = length;
+                secondEnd = downEnd[c];
+            }
+        }
+        down[v] = first;
+        downEnd[v] = firstEnd;
+        if (best.from == -1 || first + second > best.length)
+        {
+            best = {firstEnd, secondEnd, first + second};
+        }
+    }
+    return best;
+}
+
+vector<long long> eccentricities(const RootedTree &rooted)
+{
+    int verts = rooted.vertices;
+    vector<long long> down(verts, 0), up(verts, 0);
+    for (int i = verts - 1; i >= 0; i--)
+    {
+        int v = rooted.order[i];
+        for (int k = rooted.childStart[v]; k < rooted.childStart[v + 1]; k++)
+        {
+            int c = rooted.children[k];
+            down[v] = max(down[v], down[c] + rooted.parentWeight[c]);
+        }
+    }
+
+    // `up[v]` is the longest path from `v` that leaves its subtree through its parent, 0 at a root for itself
+    for (int v : rooted.order)
+    {
+        // The two longest paths down through different children, the vertex itself counts as a path of length 0
+        long long first = 0, second = 0;
+        int firstChild = -1;
+        for (int k = rooted.childStart[v]; k < rooted.childStart[v + 1]; k++)
+        {
+            int c = rooted.children[k];
+            long long length = down[c] + rooted.parentWeight[c];
+            if (length > first)
+            {
+                second = first;
+                first = length;
+                firstChild = c;
+            }
+            else if (length > second)
+            {
+                second = length;
+            }
+        }
+        for (int k = rooted.childStart[v]; k < rooted.childStart[v + 1]; k++)
+        {
+            int c = rooted.children[k];
+            up[c] = rooted.parentWeight[c] + max(up[v], c == firstChild ? second : first);
+        }
+    }
+
+    vector<long long> result(verts);
+    for (int v = 0; v < verts; v++)
+    {
+        result[v] = max(down[v], up[v]);
+    }
+    return result;
+}
+
+vector<int> treeCenters(const RootedTree &rooted)
+{
+    vector<long long> eccentricity = eccentricities(rooted);
+    vector<int> centers;
+    for (int root : rooted.roots)
+    {
+        // A tree is a contiguous run of the preorder
+        int center = root;
+        for (int i = rooted.preorder[root]; i < rooted.preorder[root] + rooted.subtreeSize[root]; i++)
+        {
+            int v = rooted.order[i];
+            if (eccentricity[v] < eccentricity[center] || (eccentricity[v] == eccentricity[center] && v < center))
+            {
+                center = v;
+            }
+        }
+        centers.push_back(center);
+    }
+    return centers;
+}
+
+vector<long long> subtreeSums(const RootedTree &rooted, const vector<long long> &values)
+{
+    vector<long long> sums(values);
+    if (static_cast<int>(sums.size()) != rooted.vertices)
+    {
+        cerr << "There are " << sums.size() << " values for " << rooted.vertices << " vertices." << endl;
+        return {};
+    }
+    // Backwards through the preorder, every child is done before its parent
+    for (int i = rooted.vertices - 1; i >= 0; i--)
+    {
+        int v = rooted.order[i];
+        if (rooted.parent[v] != -1)
+        {
+            sums[rooted.parent[v]] += sums[v];
+        }
+    }
+    return sums;
+}
@@ -0,0 +1,89 @@
+#ifndef ROOTED_TREE_HPP
+#define ROOTED_TREE_HPP
+
+#include "graph.hpp"
+#include <vector>
+
+/**
+ * @brief A spanning forest rooted in every tree, as flat arrays indexed by vertex.
+ *
+ * The vertices are numbered in a depth-first preorder, so the subtree of `v` is the `subtreeSize[v]` vertices of
+ * `order` from `preorder[v]` on, and the children of `v` are `children[childStart[v]]` to
+ * `children[childStart[v + 1] - 1]`, in that same order. The Euler tour lists a vertex when it is first reached
+ * and again every time the walk comes back to it from a child, `2 n - 1` entries for a tree of `n` vertices.
+ */
+struct RootedTree
+{
+    int vertices = 0;                /**< The number of vertices. */
+    std::vector<int> roots;          /**< The root of every tree, in the order they were walked. */
+    std::vector<int> treeRoot;       /**< The root of the tree of every vertex. */
+    std::vector<int> parent;         /**< The parent of every vertex, -1 at a root. */
+    std::vector<int> parentWeight;   /**< The weight of the edge to the parent, 0 at a root. */
+    std::vector<int> parentEdge;     /**< The index of that edge in the `MST`, -1 at a root. */
+    std::vector<int> depth;          /**< The number of edges from the root. */
+    std::vector<long long> distance; /**< The total weight of the path from the root. */
+    std::vector<int> childStart;     /**< Where the children of every vertex start in `children`, `vertices + 1` entries. */
+    std::vector<int> children;       /**< The children of every vertex, in preorder. */
+    std::vector<int> order;          /**< The vertices in preorder, tree after tree. */
+    std::vector<int> preorder;       /**< The position of every vertex in `order`. */
+    std::vector<int> postorder;      /**< The position of every vertex in a postorder of the same walk. */
+    std::vector<int> subtreeSize;    /**< The number of vertices in the subtree of every vertex. */
+    std::vector<int> euler;          /**< The Euler tour of every tree, one after another. */
+    std::vector<int> firstVisit;     /**< The first position of every vertex in `euler`. */
+
+    /**
+     * @return True if `u` is `v` or one of its ancestors.
+     */
+    bool isAncestor(int u, int v) const
+    {
+        return preorder[u] <= preorder[v] && preorder[v] < preorder[u] + subtreeSize[u];
+    }
+};
+
+/**
+ * @brief A longest path of a tree.
+ */
+struct TreePath
+{
+    int from = -1;        /**< One end, -1 for a forest with no vertex. */
+    int to = -1;          /**< The other end. */
+    long long length = 0; /**< The total weight of the path. */
+};
+
+RootedTree rootTree(int verts, const MST &tree, int root = 0, bool orders = true);
+
+/**
+ * Finds the longest path of the forest, by total weight, in O(V). With negative weights the longest path can be a
+ * single vertex.
+ *
+ * @param rooted The rooted forest
+ * @return The ends of the path and its length
+ */
+TreePath treeDiameter(const RootedTree &rooted);
+
+/**
+ * Computes the eccentricity of every vertex, its largest distance to a vertex of its tree, in O(V) by rerooting.
+ *
+ * @param rooted The rooted forest
+ * @return The eccentricity of every vertex
+ */
+std::vector<long long> eccentricities(const RootedTree &rooted);
+
+/**
+ * Finds the center of every tree, the vertex with the smallest eccentricity, the lowest vertex on a tie.
+ *
+ * @param rooted The rooted forest
+ * @return The center of every tree, in the order of `roots`
+ */
+std::vector<int> treeCenters(const RootedTree &rooted);
+
+/**
+ * Sums a value over every subtree in one pass over the postorder.
+ *
+ * @param rooted The rooted forest
+ * @param values The value of every vertex
+ * @return The sum of the values of the subtree of every vertex
+ */
+std::vector<long long> subtreeSums(const RootedTree &rooted, const std::vector<long long> &values);
+
+#endif
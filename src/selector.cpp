@@ -0,0 +1,296 @@
+#include "graph.hpp"
+#include "selector.hpp"
+#include "heap.hpp"
+#include <cmath>
+#include <limits>
+#include <random>
+#include <chrono>
+#include <climits>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+using namespace std;
+
+// The weight matrix of dense Prim takes V^2 ints, this caps it at 1GB
+static const int MAX_DENSE_VERTICES = 1 << 14;
+
+GraphStats graphStats(const Graph &graph, unsigned threads)
+{
+    GraphStats stats;
+    stats.vertices = graph.vertNumber();
+    stats.threads = max(1u, threads);
+    stats.minWeight = INT_MAX;
+    stats.maxWeight = INT_MIN;
+
+    long long directed = 0;
+    for (const auto &neighbors : graph.adjList)
+    {
+        directed += neighbors.size();
+        for (const auto &[dest, weight] : neighbors)
+        {
+            stats.minWeight = min(stats.minWeight, weight);
+            stats.maxWeight = max(stats.maxWeight, weight);
+        }
+    }
+    if (directed == 0)
+    {
+        stats.minWeight = stats.maxWeight = 0;
+    }
+    stats.edges = directed / 2;
+    double possible = 0.5 * stats.vertices * (stats.vertices - 1.0);
+    stats.density = possible > 0 ? stats.edges / possible : 0;
+    return stats;
+}
+
+double engineWork(const string &engine, const GraphStats &stats)
+{
+    double v = stats.vertices;
+    double e = stats.edges;
+    // Once the per-vertex arrays fall out of cache every vertex costs a few misses, which is what makes the
+    // engines slower per edge on big sparse graphs than on small dense ones
+    double vertexMisses = v * log2(v + 2);
+    if (engine == "kruskal")
+    {
+        return e * log2(e + 2) + 4 * vertexMisses;
+    }
+    if (engine == "prim")
+    {
+        return e + 5 * vertexMisses;
+    }
+    if (engine == "prim-bucket")
+    {
+        // Decrease-key is O(1), but the cursor sweeps the empty buckets between two extracted keys, about
+        // W / degree of them, and a bucket check is about fifty times cheaper than an edge relaxation
+        if (!BucketQueue::acceptsKeys(stats.minWeight, stats.maxWeight))
+        {
+            return -1;
+        }
+        double degree = v > 0 ? 2 * e / v : 0;
+        return e + 3 * vertexMisses + v * stats.maxWeight / (degree + 1) / 48;
+    }
+    if (engine == "prim-dense")
+    {
+        if (stats.vertices > MAX_DENSE_VERTICES)
+        {
+            return -1;
+        }
+        return v * v;
+    }
+    if (engine == "boruvka")
+    {
+        return e * log2(v + 2) + 4 * vertexMisses;
+    }
+    if (engine == "boruvka-parallel")
+    {
+        return (e * log2(v + 2) + 4 * vertexMisses) / stats.threads;
+    }
+    return -1;
+}
+
+const vector<string> &CostProfile::engines()
+{
+    static const vector<string> names{"kruskal", "prim", "prim-bucket", "prim-dense", "boruvka", "boruvka-parallel"};
+    return names;
+}
+
+CostProfile CostProfile::defaults()
+{
+    // Fitted on a single core desktop, `calibrate` replaces these with the numbers of the machine it runs on
+    CostProfile profile;
+    profile.models["kruskal"] = {0, 0.0028};
+    profile.models["prim"] = {0, 0.0030};
+    profile.models["prim-bucket"] = {0, 0.0034};
+    profile.models["prim-dense"] = {0, 0.0027};
+    profile.models["boruvka"] = {0, 0.0032};
+    profile.models["boruvka-parallel"] = {0, 0.0030};
+    return profile;
+}
+
+CostProfile CostProfile::load(const string &path, bool *found)
+{
+    CostProfile profile = defaults();
+    ifstream input(path);
+    if (found)
+    {
+        *found = static_cast<bool>(input);
+    }
+    string line;
+    while (getline(input, line))
+    {
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        istringstream fields(line);
+        string engine;
+        CostModel model;
+        if (fields >> engine >> model.fixed >> model.perWork)
+        {
+            profile.models[engine] = model;
+        }
+    }
+    return profile;
+}
+
+bool CostProfile::save(const string &path) const
+{
+    ofstream output(path);
+    if (!output)
+    {
+        cerr << "Error writing profile file." << endl;
+        return false;
+    }
+    output << "# MST cost profile, one line per engine: name, fixed microseconds, microseconds per unit of work\n";
+    output.precision(8);
+    for (const auto &[engine, model] : models)
+    {
+        output << engine << " " << model.fixed << " " << model.perWork << "\n";
+    }
+    return static_cast<bool>(output);
+}
+
+double CostProfile::predict(const string &engine, const GraphStats &stats) const
+{
+    auto model = models.find(engine);
+    double work = engineWork(engine, stats);
+    if (model == models.end() || work < 0)
+    {
+        return numeric_limits<double>::infinity();
+    }
+    return model->second.fixed + model->second.perWork * work;
+}
+
+/**
+ * Picks the engine the profile predicts to be the fastest, ties go to the first engine in the list.
+ */
+string selectAlgorithm(const GraphStats &stats, const CostProfile &profile)
+{
+    string best = "kruskal";
+    double bestTime = numeric_limits<double>::infinity();
+    for (const string &engine : CostProfile::engines())
+    {
+        double time = profile.predict(engine, stats);
+        if (time < bestTime)
+        {
+            bestTime = time;
+            best = engine;
+        }
+    }
+    return best;
+}
+
+/**
+ * A random graph with `edges` edges between uniform random vertices, or every edge if it asks for more than that.
+ */
+static Graph calibrationGraph(int verts, long long edges, int maxWeight, mt19937 &random)
+{
+    Graph graph(verts);
+    uniform_int_distribution<int> weight(1, maxWeight);
+    if (edges >= 1LL * verts * (verts - 1) / 2)
+    {
+        for (int u = 0; u < verts; u++)
+        {
+            for (int v = u + 1; v < verts; v++)
+            {
+                graph.addEdge(u, v, weight(random));
+            }
+        }
+        return graph;
+    }
+    uniform_int_distribution<int> vertex(0, verts - 1);
+    for (long long i = 0; i < edges; i++)
+    {
+        int u = vertex(random), v = vertex(random);
+        if (u != v)
+        {
+            graph.addEdge(u, v, weight(random));
+        }
+    }
+    return graph;
+}
+
+/**
+ * Least squares fit of `time = fixed + perWork * work`, with both coefficients kept non-negative.
+ *
+ * The squared errors are weighted by `1 / time^2`, so the fit minimizes the relative error and the small graphs
+ * count as much as the big ones.
+ */
+static CostModel fitModel(const vector<pair<double, double>> &samples)
+{
+    double sumW = 0, sumX = 0, sumY = 0, sumXX = 0, sumXY = 0;
+    for (const auto &[x, y] : samples)
+    {
+        double w = 1.0 / max(1.0, y * y);
+        sumW += w;
+        sumX += w * x;
+        sumY += w * y;
+        sumXX += w * x * x;
+        sumXY += w * x * y;
+    }
+    CostModel model;
+    double denominator = sumW * sumXX - sumX * sumX;
+    if (denominator > 0)
+    {
+        model.perWork = (sumW * sumXY - sumX * sumY) / denominator;
+        model.fixed = (sumY - model.perWork * sumX) / sumW;
+    }
+    if (model.fixed < 0 || model.perWork <= 0)
+    {
+        // Fall back to a line through the origin
+        model.fixed = 0;
+        model.perWork = sumXX > 0 ? sumXY / sumXX : 0;
+    }
+    return model;
+}
+
+CostProfile calibrateProfile(const function<MST(const string &, Graph &)> &run, unsigned threads, unsigned seed, double scale)
+{
+    // Sparse and dense shapes with small and large weight ranges, so every term of the model gets exercised
+    struct Shape
+    {
+        int verts;
+        double degree;
+        int maxWeight;
+    };
+    const vector<Shape> shapes{
+        {4000, 4, 100}, {4000, 32, 1000000}, {40000, 4, 1000}, {40000, 16, 1000000},
+        {150000, 4, 1000000}, {800, 1000, 100}, {1500, 1500, 100000}};
+
+    mt19937 random(seed);
+    CostProfile profile = CostProfile::defaults();
+    map<string, vector<pair<double, double>>> samples;
+    for (const Shape &shape : shapes)
+    {
+        int verts = max(16, static_cast<int>(shape.verts * scale));
+        long long edges = static_cast<long long>(verts * min(shape.degree, verts - 1.0) / 2);
+        Graph graph = calibrationGraph(verts, edges, shape.maxWeight, random);
+        GraphStats stats = graphStats(graph, threads);
+
+        for (const string &engine : CostProfile::engines())
+        {
+            double work = engineWork(engine, stats);
+            // Dense Prim on the big sparse shapes would take longer than everything else put together
+            if (work < 0 || (engine == "prim-dense" && verts > 5000))
+            {
+                continue;
+            }
+            // The best of three runs, the first one also warms the caches
+            double best = numeric_limits<double>::infinity();
+            for (int repeat = 0; repeat < 3; repeat++)
+            {
+                auto start = chrono::steady_clock::now();
+                MST mst = run(engine, graph);
+                auto end = chrono::steady_clock::now();
+                best = min(best, chrono::duration<double, micro>(end - start).count());
+            }
+            samples[engine].emplace_back(work, best);
+        }
+    }
+
+    for (const auto &[engine, points] : samples)
+    {
+        profile.models[engine] = fitModel(points);
+    }
+    return profile;
+}
@@ -0,0 +1,102 @@
+#ifndef SELECTOR_HPP
+#define SELECTOR_HPP
+
+#include "graph.hpp"
+#include <map>
+#include <string>
+#include <vector>
+#include <functional>
+
+/**
+ * @brief The cheap statistics the cost model looks at.
+ */
+struct GraphStats
+{
+    int vertices = 0;     /**< The number of vertices. */
+    long long edges = 0;  /**< The number of undirected edges. */
+    double density = 0;   /**< The fraction of the possible edges that are there. */
+    int minWeight = 0;    /**< The smallest edge weight. */
+    int maxWeight = 0;    /**< The largest edge weight. */
+    unsigned threads = 1; /**< The number of threads the parallel engines get. */
+};
+
+/**
+ * Collects the statistics of a graph in one pass over the adjacency list.
+ *
+ * @param graph The graph to look at
+ * @param threads The number of threads the parallel engines would run on
+ */
+GraphStats graphStats(const Graph &graph, unsigned threads);
+
+/**
+ * The work an engine does on a graph with these statistics, in the engine's own unit, like E log E for Kruskal.
+ *
+ * @return The work, or a negative number if the engine can not run on this graph
+ */
+double engineWork(const std::string &engine, const GraphStats &stats);
+
+/**
+ * @brief The predicted time of one engine, `fixed + perWork * engineWork(...)` microseconds.
+ */
+struct CostModel
+{
+    double fixed = 0;
+    double perWork = 0;
+};
+
+/**
+ * @brief The cost model of every engine on one machine, fitted by `calibrateProfile`.
+ *
+ * The profile is stored as a text file, with one `engine fixed perWork` line per engine.
+ */
+class CostProfile
+{
+public:
+    std::map<std::string, CostModel> models;
+
+    /**
+     * @return The engines the selector picks from.
+     */
+    static const std::vector<std::string> &engines();
+
+    /**
+     * @return A rough profile for when the machine has not been calibrated.
+     */
+    static CostProfile defaults();
+
+    /**
+     * Loads a profile file, engines it does not mention keep their default model.
+     *
+     * @param path The profile file
+     * @param found Set to whether the file could be read
+     */
+    static CostProfile load(const std::string &path, bool *found = nullptr);
+
+    /**
+     * @return True if the file was written.
+     */
+    bool save(const std::string &path) const;
+
+    /**
+     * @return The predicted microseconds of `engine` on the graph, or infinity if it can not run on it.
+     */
+    double predict(const std::string &engine, const GraphStats &stats) const;
+};
+
+/**
+ * Picks the engine the profile predicts to be the fastest.
+ */
+std::string selectAlgorithm(const GraphStats &stats, const CostProfile &profile);
+
+/**
+ * Times every engine on a set of random graphs and fits each engine's cost model with least squares.
+ *
+ * @param run Runs an engine by name, the same names `-a/--algo` takes
+ * @param threads The number of threads the parallel engines run on
+ * @param seed The seed of the random graphs
+ * @param scale Multiplies the size of the graphs, smaller is faster but noisier
+ * @return The fitted profile
+ */
+CostProfile calibrateProfile(const std::function<MST(const std::string &, Graph &)> &run, unsigned threads, unsigned seed = 1, double scale = 1.0);
+
+#endif
@@ -0,0 +1,148 @@
+#include "graph.hpp"
+#include "sensitivity.hpp"
+#include "boruvka_tree.hpp"
+#include "kruskal.hpp"
+#include "rooted_tree.hpp"
+#include <vector>
+#include <cstdint>
+#include <numeric>
+#include <iostream>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * Computes the sensitivity of every edge of a graph to its minimum spanning forest, in O(E log E).
+ *
+ * A non-tree edge joins the forest once it is lighter than the heaviest tree edge on the path between its ends,
+ * which the `BoruvkaTree` of the forest answers. A tree edge is replaced by the lightest non-tree edge whose path
+ * covers it, so the non-tree edges go through the forest lightest first, and each one takes every tree edge on its
+ * path that has no replacement yet. A union find by rank over the forest, rooted once, skips the edges already
+ * taken, so each tree edge is visited once and the walk is O(E α(V)) after the sort.
+ *
+ * @param graph The graph
+ * @param tree A minimum spanning forest of the graph, its edges should be edges of the graph
+ * @param pool The pool the path maxima are computed on
+ * @return The replacement of every tree edge and the path maximum of every other edge
+ */
+EdgeSensitivity edge_sensitivity(const Graph &graph, const MST &tree, ThreadPool &pool)
+{
+    EdgeSensitivity result;
+    int verts = graph.vertNumber();
+    for (const auto &edge : tree.edges)
+    {
+        result.treeEdges.push_back({edge, -1});
+    }
+
+    // An edge to a vertex the graph lacks, or one that closes a cycle, is left out of the rooted forest, and stays
+    // in the report as a bridge
+    RootedTree rooted = rootTree(verts, tree, 0, false);
+    vector<Graph::Edge> forest;
+    forest.reserve(verts);
+    for (int v = 0; v < verts; v++)
+    {
+        if (rooted.parentEdge[v] != -1)
+        {
+            forest.push_back(tree.edges[rooted.parentEdge[v]]);
+        }
+    }
+
+    // Each graph edge that matches a tree edge from the smaller end, once, is that tree edge
+    vector<int> stamp(verts, -1), wanted(verts, 0);
+    int unmatched = forest.size();
+    for (int u = 0; u < verts; u++)
+    {
+        // The tree neighbors of `u` are its children and its parent
+        for (int k = rooted.childStart[u]; k < rooted.childStart[u + 1]; k++)
+        {
+            int v = rooted.children[k];
+            if (v > u)
+            {
+                stamp[v] = u;
+                wanted[v] = rooted.parentWeight[v];
+            }
+        }
+        if (rooted.parent[u] > u)
+        {
+            stamp[rooted.parent[u]] = u;
+            wanted[rooted.parent[u]] = rooted.parentWeight[u];
+        }
+        for (const auto &[v, w] : graph.adjList[u])
+        {
+            if (v <= u)
+            {
+                continue;
+            }
+            if (stamp[v] == u && wanted[v] == w)
+            {
+                stamp[v] = -1;
+                unmatched--;
+                continue;
+            }
+            result.nonTreeEdges.push_back({Graph::Edge(u, v, w), 0});
+        }
+    }
+    if (unmatched > 0)
+    {
+        cerr << unmatched << " tree edges are not in the graph." << endl;
+    }
+
+    // Sorted by packed keys with the position as the tie break, which is cheaper than sorting the records
+    {
+        vector<uint64_t> keys(result.nonTreeEdges.size());
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            keys[i] = edgeRank(result.nonTreeEdges[i].edge.weight, i);
+        }
+        sort(keys.begin(), keys.end());
+        vector<EdgeSensitivity::NonTreeEdge> sorted;
+        sorted.reserve(keys.size());
+        for (uint64_t key : keys)
+        {
+            sorted.push_back(result.nonTreeEdges[static_cast<uint32_t>(key)]);
+        }
+        result.nonTreeEdges.swap(sorted);
+    }
+
+    BoruvkaTree boruvka(verts, forest);
+    pool.parallelFor(0, result.nonTreeEdges.size(), [&](int i)
+                     {
+                         auto &nonTree = result.nonTreeEdges[i];
+                         nonTree.pathMax = boruvka.pathMax(nonTree.edge.src, nonTree.edge.dest);
+                     },
+                     4096);
+
+    // A vertex whose parent edge has a replacement joins its parent's set, and every set keeps its top vertex, the
+    // lowest ancestor whose parent edge is still open. The sets are joined by rank, so the finds stay near constant
+    UnionFind covered(verts);
+    vector<int> top(verts);
+    iota(top.begin(), top.end(), 0);
+    auto lowestOpen = [&](int x)
+    {
+        return top[covered.find(x)];
+    };
+    for (int i = 0; i < static_cast<int>(result.nonTreeEdges.size()); i++)
+    {
+        const auto &nonTree = result.nonTreeEdges[i];
+        // An edge between two trees has no path, which only happens when the forest does not span the graph
+        if (nonTree.pathMax == BoruvkaTree::NO_PATH)
+        {
+            continue;
+        }
+        int x = lowestOpen(nonTree.edge.src);
+        int y = lowestOpen(nonTree.edge.dest);
+        while (x != y)
+        {
+            if (rooted.depth[x] < rooted.depth[y])
+            {
+                swap(x, y);
+            }
+            result.treeEdges[rooted.parentEdge[x]].replacement = i;
+            int above = lowestOpen(rooted.parent[x]);
+            covered.merge(x, rooted.parent[x]);
+            top[covered.find(x)] = above;
+            x = above;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,50 @@
+#ifndef SENSITIVITY_HPP
+#define SENSITIVITY_HPP
+
+#include "graph.hpp"
+#include "thread_pool.hpp"
+#include <vector>
+
+/**
+ * @brief How much every edge's weight can change before the minimum spanning forest does.
+ */
+struct EdgeSensitivity
+{
+    /**
+     * @brief A tree edge and the edge that takes its place if it fails.
+     */
+    struct TreeEdge
+    {
+        Graph::Edge edge;     /**< The tree edge. */
+        int replacement = -1; /**< The cheapest non-tree edge across its cut, an index into `nonTreeEdges`, or -1 for a bridge. */
+    };
+
+    /**
+     * @brief A non-tree edge and the weight it has to get under to join the forest.
+     */
+    struct NonTreeEdge
+    {
+        Graph::Edge edge; /**< The non-tree edge. */
+        int pathMax;      /**< The heaviest tree edge on the path between its ends, `BoruvkaTree::NO_PATH` across trees. */
+    };
+
+    std::vector<TreeEdge> treeEdges;       /**< In the order of the tree. */
+    std::vector<NonTreeEdge> nonTreeEdges; /**< Lightest first. */
+
+    /**
+     * @return The number of tree edges with no replacement, whose failure splits a component.
+     */
+    int bridges() const
+    {
+        int count = 0;
+        for (const auto &tree : treeEdges)
+        {
+            count += tree.replacement == -1 ? 1 : 0;
+        }
+        return count;
+    }
+};
+
+EdgeSensitivity edge_sensitivity(const Graph &graph, const MST &tree, ThreadPool &pool = sharedPool());
+
+#endif
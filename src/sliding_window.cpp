@@ -0,0 +1,67 @@
+#include "graph.hpp"
+#include "sliding_window.hpp"
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+using namespace std;
+
+SlidingWindowMSF::SlidingWindowMSF(int vertices, long long window, unsigned seed)
+    : forest(vertices, seed), window(window), now(0)
+{
+}
+
+void SlidingWindowMSF::advance(long long time)
+{
+    if (started && time < now)
+    {
+        return;
+    }
+    started = true;
+    now = time;
+    while (!live.empty() && live.front().first <= now - window)
+    {
+        forest.deleteEdge(live.front().second);
+        live.pop_front();
+    }
+}
+
+bool SlidingWindowMSF::addEdge(long long time, int u, int v, int w)
+{
+    if (started && time < now)
+    {
+        return false;
+    }
+    advance(time);
+    int id = forest.insertEdge(u, v, w);
+    if (id == -1)
+    {
+        return false;
+    }
+    live.emplace_back(time, id);
+    return true;
+}
+
+vector<EdgeUpdate> loadEdgeStream(const string &file)
+{
+    vector<EdgeUpdate> edges;
+    ifstream inputFile(file);
+    if (!inputFile)
+    {
+        cerr << "Error loading edge stream.";
+        return edges;
+    }
+    string line;
+    while (getline(inputFile, line))
+    {
+        istringstream fields(line);
+        EdgeUpdate edge{true, 0, 0, 0};
+        if (fields >> edge.time >> edge.u >> edge.v >> edge.weight)
+        {
+            edges.push_back(edge);
+        }
+    }
+    return edges;
+}
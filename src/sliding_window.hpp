@@ -0,0 +1,97 @@
+#ifndef SLIDING_WINDOW_HPP
+#define SLIDING_WINDOW_HPP
+
+#include "graph.hpp"
+#include "dynamic_msf.hpp"
+#include <deque>
+#include <string>
+#include <vector>
+#include <utility>
+
+/**
+ * @brief The minimum spanning forest of the edges of a timestamped stream that arrived within a time window.
+ *
+ * At time `now` the edges with a timestamp in (now - window, now] are live. Edges leave in the order they came,
+ * so a queue of the live edges tells which ones expire, and a `DynamicMSF` keeps the forest valid after every
+ * arrival and expiry. The cost per edge is that of two `DynamicMSF` updates, polylogarithmic amortized.
+ */
+class SlidingWindowMSF
+{
+private:
+    DynamicMSF forest;
+    long long window;
+    long long now;
+    bool started = false;
+    // The live edges as (timestamp, id), oldest first
+    std::deque<std::pair<long long, int>> live;
+
+public:
+    /**
+     * @param vertices The number of vertices
+     * @param window The length of the window, in the units of the timestamps
+     * @param seed The seed of the treap priorities
+     */
+    SlidingWindowMSF(int vertices, long long window, unsigned seed = 1);
+
+    /**
+     * Moves the clock to `time` and adds an edge, after expiring the edges that fell out of the window.
+     *
+     * @return False if the time is earlier than the clock, or the edge is a self loop or out of range
+     */
+    bool addEdge(long long time, int u, int v, int w);
+
+    /**
+     * Moves the clock to `time` and expires the edges that fell out of the window. An earlier time is ignored.
+     */
+    void advance(long long time);
+
+    /**
+     * @return The total weight of the forest.
+     */
+    long long totalWeight() const
+    {
+        return forest.totalWeight();
+    }
+
+    /**
+     * @return The number of edges in the forest.
+     */
+    int edgeCount() const
+    {
+        return forest.edgeCount();
+    }
+
+    /**
+     * @return The number of edges in the window.
+     */
+    int windowEdges() const
+    {
+        return live.size();
+    }
+
+    /**
+     * @return The time of the clock.
+     */
+    long long time() const
+    {
+        return now;
+    }
+
+    /**
+     * @return The forest as a `MST` object, in O(E).
+     */
+    MST mst() const
+    {
+        return forest.mst();
+    }
+};
+
+/**
+ * Loads a timestamped edge stream, one `time u v w` line per edge.
+ *
+ * @param file The path to the stream
+ * @return The edges as insertions, in order, the lines that can not be read are skipped
+ */
+std::vector<EdgeUpdate> loadEdgeStream(const std::string &file);
+
+#endif
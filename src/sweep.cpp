@@ -0,0 +1,71 @@
+#include "graph.hpp"
+#include "sweep.hpp"
+#include "kruskal.hpp"
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+ConnectivityCurve::Point ConnectivityCurve::at(int threshold) const
+{
+    auto after = upper_bound(points.begin(), points.end(), threshold, [](int t, const Point &point)
+                             { return t < point.weight; });
+    if (after == points.begin())
+    {
+        // No edge is light enough, every vertex is on its own
+        return {threshold, vertices, vertices > 0 ? 1 : 0};
+    }
+    return *(after - 1);
+}
+
+/**
+ * Records the connectivity curve of a graph in one Kruskal pass
+ *
+ * The edges are sorted once and joined in order with a `UnionFind`, keeping the size of every set. The state
+ * after the last edge of each weight that joined something is a point of the curve, so the whole curve costs
+ * one sort, and any threshold is then answered with a binary search instead of recomputing the components.
+ *
+ * @param graph The graph to sweep
+ * @return The curve, with at most one point per distinct weight
+ */
+ConnectivityCurve threshold_sweep(Graph &graph)
+{
+    ConnectivityCurve curve;
+    curve.vertices = graph.vertNumber();
+    EdgeList edges(graph);
+    UnionFind unionFind(graph.vertNumber());
+    vector<int> sizeOf(graph.vertNumber(), 1);
+    sort(edges.list.begin(), edges.list.end(), [](const Graph::Edge &a, const Graph::Edge &b)
+         { return a.weight < b.weight; });
+
+    int components = graph.vertNumber();
+    int largest = components > 0 ? 1 : 0;
+    for (const auto &edge : edges.list)
+    {
+        int srcRoot = unionFind.find(edge.src), destRoot = unionFind.find(edge.dest);
+        if (srcRoot == destRoot)
+        {
+            continue;
+        }
+        int size = sizeOf[srcRoot] + sizeOf[destRoot];
+        unionFind.merge(srcRoot, destRoot);
+        sizeOf[unionFind.find(srcRoot)] = size;
+        components--;
+        largest = max(largest, size);
+
+        // Later joins at the same weight replace the point, only the state after the whole weight is visible
+        if (!curve.points.empty() && curve.points.back().weight == edge.weight)
+        {
+            curve.points.back() = {edge.weight, components, largest};
+        }
+        else
+        {
+            curve.points.push_back({edge.weight, components, largest});
+        }
+        if (components == 1)
+        {
+            break;
+        }
+    }
+    return curve;
+}
@@ -0,0 +1,39 @@
+#ifndef SWEEP_HPP
+#define SWEEP_HPP
+
+#include "graph.hpp"
+#include <vector>
+
+/**
+ * @brief How the connectivity of a graph changes as the weight threshold rises.
+ *
+ * Keeping only the edges of weight at most `t`, the graph has some number of components and a largest one. Both
+ * only change at the weights where an edge joins two components, which are the points of the curve.
+ */
+struct ConnectivityCurve
+{
+    /**
+     * @brief The connectivity from a weight up to the next point.
+     */
+    struct Point
+    {
+        int weight;     /**< The weight this state starts at. */
+        int components; /**< The number of connected components. */
+        int largest;    /**< The number of vertices in the largest component. */
+    };
+
+    int vertices = 0;          /**< The number of vertices. */
+    std::vector<Point> points; /**< One point per weight that joins components, lowest first. */
+
+    /**
+     * Finds the connectivity at a threshold by binary search.
+     *
+     * @param threshold The largest edge weight kept
+     * @return The state at the threshold, its `weight` is where that state starts, or `threshold` if no edge is kept
+     */
+    Point at(int threshold) const;
+};
+
+ConnectivityCurve threshold_sweep(Graph &graph);
+
+#endif
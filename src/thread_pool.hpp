@@ -0,0 +1,377 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <algorithm>
+
+/**
+ * @brief A work-stealing pool of worker threads.
+ *
+ * Every worker has its own deque of tasks. A worker pushes and pops its own tasks at the back, so it keeps working
+ * on the freshest (and most cache friendly) piece of a split range, and idle workers steal from the front of the
+ * other deques, where the biggest unsplit pieces are. That keeps every thread busy even when the iterations of a
+ * loop have very different costs, like the vertices of a skewed degree distribution.
+ *
+ * A thread that waits on the pool, including the caller of `parallelFor`, runs queued tasks while it waits.
+ */
+class ThreadPool
+{
+private:
+    /**
+     * @brief A worker's task deque, guarded by its own lock.
+     */
+    struct Queue
+    {
+        std::deque<std::function<void()>> tasks;
+        std::mutex lock;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    // The number of tasks sitting in a deque, and the number that are queued or running
+    std::atomic<int> queued{0};
+    std::atomic<int> pending{0};
+    std::atomic<unsigned> nextQueue{0};
+    std::atomic<bool> stopping{false};
+    // Idle workers sleep here until a task is queued
+    std::mutex sleepLock;
+    std::condition_variable wake;
+
+    /**
+     * @return The index of the calling thread in this pool, or -1 if it is not one of its workers.
+     */
+    int currentWorker() const
+    {
+        return owner() == this ? index() : -1;
+    }
+
+    static const ThreadPool *&owner()
+    {
+        static thread_local const ThreadPool *pool = nullptr;
+        return pool;
+    }
+
+    static int &index()
+    {
+        static thread_local int worker = -1;
+        return worker;
+    }
+
+    /**
+     * Takes a task from the back of our own deque, or steals one from the front of another worker's deque.
+     */
+    bool takeTask(int self, std::function<void()> &task)
+    {
+        int count = queues.size();
+        if (self >= 0)
+        {
+            Queue &own = *queues[self];
+            std::lock_guard<std::mutex> guard(own.lock);
+            if (!own.tasks.empty())
+            {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                queued--;
+                return true;
+            }
+        }
+        // Start stealing after ourselves, so the thieves spread out over the victims
+        int start = self >= 0 ? self + 1 : nextQueue.load(std::memory_order_relaxed);
+        for (int i = 0; i < count; i++)
+        {
+            Queue &victim = *queues[(start + i) % count];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (!victim.tasks.empty())
+            {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                queued--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Runs one queued task if there is one.
+     */
+    bool runOne()
+    {
+        std::function<void()> task;
+        if (!takeTask(currentWorker(), task))
+        {
+            return false;
+        }
+        task();
+        pending--;
+        return true;
+    }
+
+    void workerLoop(int self)
+    {
+        owner() = this;
+        index() = self;
+        while (true)
+        {
+            if (runOne())
+            {
+                continue;
+            }
+            std::unique_lock<std::mutex> guard(sleepLock);
+            wake.wait(guard, [this]
+                      { return stopping || queued > 0; });
+            if (stopping && queued == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    /**
+     * Runs `body` over `[begin, end)`, splitting off the upper half as a new task until the range fits in a grain.
+     */
+    template <typename F>
+    void splitRange(int begin, int end, int grain, F &body, std::atomic<int> &remaining)
+    {
+        while (end - begin > grain)
+        {
+            int middle = begin + (end - begin) / 2;
+            submit([this, middle, end, grain, &body, &remaining]
+                   { splitRange(middle, end, grain, body, remaining); });
+            end = middle;
+        }
+        for (int i = begin; i < end; i++)
+        {
+            body(i);
+        }
+        // The last thing we touch, once it reaches zero the caller's frame can go away
+        remaining.fetch_sub(end - begin);
+    }
+
+public:
+    /**
+     * @brief Starts the worker threads.
+     *
+     * @param threads The number of workers, 0 means one per hardware thread.
+     */
+    explicit ThreadPool(unsigned threads = 0)
+    {
+        if (threads == 0)
+        {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for (unsigned i = 0; i < threads; i++)
+        {
+            queues.push_back(std::make_unique<Queue>());
+        }
+        for (unsigned i = 0; i < threads; i++)
+        {
+            workers.emplace_back([this, i]
+                                 { workerLoop(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * @brief Finishes the queued tasks and joins the workers.
+     */
+    ~ThreadPool()
+    {
+        wait();
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    /**
+     * @return The number of worker threads.
+     */
+    unsigned size() const
+    {
+        return workers.size();
+    }
+
+    /**
+     * @brief Queues a task, on the calling worker's own deque or spread round robin from other threads.
+     */
+    void submit(std::function<void()> task)
+    {
+        int self = currentWorker();
+        int target = self >= 0 ? self : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        pending++;
+        {
+            Queue &queue = *queues[target];
+            std::lock_guard<std::mutex> guard(queue.lock);
+            queue.tasks.push_back(std::move(task));
+            queued++;
+        }
+        {
+            // Taking the sleep lock means a worker can not miss the wake up between its check and its wait
+            std::lock_guard<std::mutex> guard(sleepLock);
+        }
+        wake.notify_one();
+    }
+
+    /**
+     * @brief Blocks until every submitted task has finished, running queued tasks in the meantime.
+     */
+    void wait()
+    {
+        while (pending > 0)
+        {
+            if (!runOne())
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /**
+     * @brief Runs `body(i)` for every `i` in `[begin, end)` on the pool and waits for all of them.
+     *
+     * The range is split in halves down to `grain` indices, and the halves are stolen by idle workers.
+     * It can be called from inside a task, the waiting thread keeps running tasks.
+     *
+     * @param begin The first index
+     * @param end One past the last index
+     * @param body The loop body
+     * @param grain The number of indices that are run as a single task
+     */
+    template <typename F>
+    void parallelFor(int begin, int end, F body, int grain = 1)
+    {
+        if (begin >= end)
+        {
+            return;
+        }
+        grain = std::max(1, grain);
+        std::atomic<int> remaining(end - begin);
+        splitRange(begin, end, grain, body, remaining);
+        while (remaining > 0)
+        {
+            if (!runOne())
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+};
+
+/**
+ * Reduces `map(i)` over `[begin, end)` with `combine`, in parallel.
+ *
+ * The range is cut into chunks of at least `grain` indices, each chunk is reduced on the pool starting from
+ * `identity`, and the chunk results are combined in order, so `combine` only has to be associative.
+ *
+ * @param pool The pool to run on
+ * @param begin The first index
+ * @param end One past the last index
+ * @param identity The identity of `combine`
+ * @param map Gives the value of index `i`
+ * @param combine Combines two partial results
+ * @param grain The smallest number of indices reduced as a single task
+ * @return The reduced value
+ */
+template <typename T, typename Map, typename Combine>
+T parallelReduce(ThreadPool &pool, int begin, int end, T identity, Map map, Combine combine, int grain = 1)
+{
+    if (begin >= end)
+    {
+        return identity;
+    }
+    // Enough chunks to balance the load, but not one partial result per index
+    int n = end - begin;
+    int chunkSize = std::max({1, grain, n / static_cast<int>(pool.size() * 16)});
+    int chunks = (n + chunkSize - 1) / chunkSize;
+    std::vector<T> partial(chunks, identity);
+    pool.parallelFor(0, chunks, [&](int c)
+                     {
+                         T value = identity;
+                         for (int i = begin + c * chunkSize; i < std::min(end, begin + (c + 1) * chunkSize); i++)
+                         {
+                             value = combine(value, map(i));
+                         }
+                         partial[c] = value; });
+
+    T result = identity;
+    for (const T &value : partial)
+    {
+        result = combine(result, value);
+    }
+    return result;
+}
+
+/**
+ * Replaces `values` with its exclusive prefix sum, in parallel, and returns the total.
+ *
+ * The values are cut into blocks, each block is summed on the pool, the block sums are scanned, and then every
+ * block is scanned again starting from its offset.
+ */
+template <typename T>
+T exclusiveScan(ThreadPool &pool, std::vector<T> &values)
+{
+    int n = values.size();
+    int blocks = std::max(1, std::min(n / 4096, static_cast<int>(pool.size()) * 4));
+    int blockSize = (n + blocks - 1) / std::max(1, blocks);
+    std::vector<T> sums(blocks + 1, T());
+
+    pool.parallelFor(0, blocks, [&](int b)
+                     {
+                         T sum = T();
+                         for (int i = b * blockSize; i < std::min(n, (b + 1) * blockSize); i++)
+                         {
+                             sum += values[i];
+                         }
+                         sums[b + 1] = sum; });
+    for (int b = 0; b < blocks; b++)
+    {
+        sums[b + 1] += sums[b];
+    }
+    pool.parallelFor(0, blocks, [&](int b)
+                     {
+                         T running = sums[b];
+                         for (int i = b * blockSize; i < std::min(n, (b + 1) * blockSize); i++)
+                         {
+                             T value = values[i];
+                             values[i] = running;
+                             running += value;
+                         } });
+    return sums[blocks];
+}
+
+/**
+ * @return The thread count the shared pool is created with, 0 means one per hardware thread.
+ */
+inline unsigned &sharedPoolThreads()
+{
+    static unsigned threads = 0;
+    return threads;
+}
+
+/**
+ * The one pool every parallel stage runs on, so they never oversubscribe the machine.
+ *
+ * It is created on first use with `sharedPoolThreads()` workers, so the thread count has to be set before that.
+ */
+inline ThreadPool &sharedPool()
+{
+    static ThreadPool pool(sharedPoolThreads());
+    return pool;
+}
+
+#endif
@@ -0,0 +1,188 @@
+#include "graph.hpp"
+#include "topk.hpp"
+#include "kruskal.hpp"
+#include "boruvka_tree.hpp"
+#include "rooted_tree.hpp"
+#include <vector>
+#include <climits>
+#include <cstdint>
+#include <algorithm>
+
+using namespace std;
+
+SpanningTreeEnumerator::SpanningTreeEnumerator(const Graph &graph) : verts(graph.vertNumber())
+{
+    for (int u = 0; u < verts; u++)
+    {
+        for (const auto &[v, w] : graph.adjList[u])
+        {
+            // Self loops are in no spanning tree
+            if (u < v)
+            {
+                edges.emplace_back(u, v, w);
+            }
+        }
+    }
+
+    vector<uint64_t> order(edges.size());
+    for (size_t i = 0; i < edges.size(); i++)
+    {
+        order[i] = edgeRank(edges[i].weight, i);
+    }
+    sort(order.begin(), order.end());
+    minimum.assign(edges.size(), 0);
+    UnionFind unionFind(verts);
+    long long weight = 0;
+    for (uint64_t key : order)
+    {
+        int i = static_cast<uint32_t>(key);
+        if (unionFind.find(edges[i].src) != unionFind.find(edges[i].dest))
+        {
+            unionFind.merge(edges[i].src, edges[i].dest);
+            minimum[i] = 1;
+            weight += edges[i].weight;
+        }
+    }
+    found.push_back({-1, -1, -1, weight});
+}
+
+/**
+ * @return Which edges are in a tree found so far, by replaying its swaps from the MST.
+ */
+vector<char> SpanningTreeEnumerator::treeEdges(int tree) const
+{
+    vector<int> chain;
+    for (int t = tree; t > 0; t = found[t].parent)
+    {
+        chain.push_back(t);
+    }
+    vector<char> inTree = minimum;
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+    {
+        inTree[found[*it].removed] = 0;
+        inTree[found[*it].added] = 1;
+    }
+    return inTree;
+}
+
+/**
+ * Finds the second best tree of the subproblem with the constraints `constraint` and the minimum tree `tree`, and
+ * queues it. A subproblem with only one tree queues nothing.
+ */
+void SpanningTreeEnumerator::pushSecondBest(int tree, int constraint)
+{
+    vector<char> inTree = treeEdges(tree);
+    // 1 for a forced edge, -1 for a forbidden one
+    vector<signed char> forced(edges.size(), 0);
+    for (int c = constraint; c != -1; c = constraints[c].previous)
+    {
+        forced[constraints[c].edge] = constraints[c].include ? 1 : -1;
+    }
+
+    // The forced edges can't leave, so they get the lowest weight and are never the heaviest on a cycle
+    MST forest;
+    vector<int> forestEdge;
+    for (size_t i = 0; i < edges.size(); i++)
+    {
+        if (inTree[i])
+        {
+            forest.edges.emplace_back(edges[i].src, edges[i].dest, forced[i] == 1 ? INT_MIN : edges[i].weight);
+            forestEdge.push_back(i);
+        }
+    }
+    BoruvkaTree paths(verts, forest.edges);
+
+    long long bestDelta = 0;
+    int added = -1;
+    for (size_t i = 0; i < edges.size(); i++)
+    {
+        if (inTree[i] || forced[i] == -1)
+        {
+            continue;
+        }
+        int heaviest = paths.pathMax(edges[i].src, edges[i].dest);
+        if (heaviest == BoruvkaTree::NO_PATH || heaviest == INT_MIN)
+        {
+            continue;
+        }
+        long long delta = static_cast<long long>(edges[i].weight) - heaviest;
+        if (added == -1 || delta < bestDelta)
+        {
+            bestDelta = delta;
+            added = i;
+        }
+    }
+    if (added == -1)
+    {
+        return;
+    }
+
+    // The Borůvka tree only knows the weight of the heaviest edge, so the edge itself comes from climbing the path
+    RootedTree rooted = rootTree(verts, forest, 0, false);
+    int removed = -1;
+    for (int x = edges[added].src, y = edges[added].dest; x != y; x = rooted.parent[x])
+    {
+        if (rooted.depth[x] < rooted.depth[y])
+        {
+            swap(x, y);
+        }
+        int k = rooted.parentEdge[x];
+        if (removed == -1 || forest.edges[k].weight > forest.edges[removed].weight)
+        {
+            removed = k;
+        }
+    }
+    candidates.push({found[tree].weight + bestDelta, tree, constraint, forestEdge[removed], added});
+}
+
+RankedTree SpanningTreeEnumerator::describe(int tree) const
+{
+    RankedTree result;
+    vector<char> inTree = treeEdges(tree);
+    for (size_t i = 0; i < edges.size(); i++)
+    {
+        if (inTree[i])
+        {
+            result.tree.edges.push_back(edges[i]);
+        }
+    }
+    result.weight = found[tree].weight;
+    result.rank = tree;
+    result.parent = found[tree].parent;
+    if (tree > 0)
+    {
+        result.removed = edges[found[tree].removed];
+        result.added = edges[found[tree].added];
+    }
+    return result;
+}
+
+bool SpanningTreeEnumerator::next(RankedTree &result)
+{
+    // The MST is found by the constructor, and its subproblem, with no constraints, is searched on the first call
+    if (!started)
+    {
+        started = true;
+        pushSecondBest(0, -1);
+        result = describe(0);
+        return true;
+    }
+    if (candidates.empty())
+    {
+        return false;
+    }
+    Candidate best = candidates.top();
+    candidates.pop();
+    int tree = found.size();
+    found.push_back({best.tree, best.removed, best.added, best.weight});
+
+    // The trees that keep the removed edge still have the parent's tree as their minimum
+    constraints.push_back({best.removed, true, best.constraints});
+    pushSecondBest(best.tree, constraints.size() - 1);
+    // The trees without it have the new one
+    constraints.push_back({best.removed, false, best.constraints});
+    pushSecondBest(tree, constraints.size() - 1);
+
+    result = describe(tree);
+    return true;
+}
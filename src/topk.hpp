@@ -0,0 +1,114 @@
+#ifndef TOPK_HPP
+#define TOPK_HPP
+
+#include "graph.hpp"
+#include <queue>
+#include <vector>
+#include <functional>
+
+/**
+ * @brief A spanning tree found by `SpanningTreeEnumerator`, and how it differs from an earlier one.
+ */
+struct RankedTree
+{
+    MST tree;                     /**< The edges of the tree, `totalWeight` is not set since it can overflow. */
+    long long weight = 0;         /**< The total weight of the tree. */
+    int rank = 0;                 /**< The position of the tree, 0 for the MST. */
+    int parent = -1;              /**< The rank of the tree this one is one swap away from, -1 for the MST. */
+    Graph::Edge removed{0, 0, 0}; /**< The edge of the parent that this tree does not have. */
+    Graph::Edge added{0, 0, 0};   /**< The edge this tree has instead. */
+};
+
+/**
+ * @brief Enumerates the spanning trees of a graph in increasing weight, after Katoh, Ibaraki and Mine.
+ *
+ * The trees left to find are split into subproblems, each with edges it must include, edges it must exclude and
+ * its own minimum tree. The next tree overall is the cheapest second best tree of any subproblem, which is its
+ * minimum tree with one edge swapped: a non-tree edge in, and the heaviest edge that is not forced in on the cycle
+ * it closes out. A `BoruvkaTree` of the minimum tree, with the forced edges made lightest, answers that for every
+ * non-tree edge. Once the swap of `e` for `f` is taken, its subproblem splits into the trees that keep `e`, whose
+ * minimum is still the same tree, and the trees without it, whose minimum is the one just found.
+ *
+ * Every subproblem keeps only its constraint and tree as one step from its parent's, so the subproblems share the
+ * edge list and everything before them, and each tree costs two second best searches, O(V + E log V) each. A
+ * disconnected graph gives spanning forests.
+ */
+class SpanningTreeEnumerator
+{
+private:
+    /**
+     * @brief A tree found so far, as one swap from its parent.
+     */
+    struct Found
+    {
+        int parent;
+        int removed;
+        int added;
+        long long weight;
+    };
+
+    /**
+     * @brief A constraint of a subproblem, on top of the constraints of the subproblem it split from.
+     */
+    struct Constraint
+    {
+        int edge;
+        bool include;
+        int previous;
+    };
+
+    /**
+     * @brief The second best tree of a subproblem, as a swap from its minimum tree.
+     */
+    struct Candidate
+    {
+        long long weight;
+        int tree;
+        int constraints;
+        int removed;
+        int added;
+
+        bool operator>(const Candidate &other) const
+        {
+            return weight != other.weight ? weight > other.weight : tree > other.tree;
+        }
+    };
+
+    int verts;
+    std::vector<Graph::Edge> edges;
+    std::vector<char> minimum;
+    std::vector<Found> found;
+    std::vector<Constraint> constraints;
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> candidates;
+    bool started = false;
+
+    std::vector<char> treeEdges(int tree) const;
+    void pushSecondBest(int tree, int constraint);
+    RankedTree describe(int tree) const;
+
+public:
+    /**
+     * Computes the minimum spanning forest with Kruskal's algorithm, the other trees are found on demand.
+     *
+     * @param graph The graph
+     */
+    explicit SpanningTreeEnumerator(const Graph &graph);
+
+    /**
+     * Finds the next tree, every tree is found once and none is lighter than one found before it.
+     *
+     * @param result The tree
+     * @return False once every spanning tree has been found
+     */
+    bool next(RankedTree &result);
+
+    /**
+     * @return The number of trees found so far.
+     */
+    int foundCount() const
+    {
+        return found.size();
+    }
+};
+
+#endif
@@ -0,0 +1,109 @@
+#include "graph.hpp"
+#include "verify.hpp"
+#include "kruskal.hpp"
+#include "boruvka_tree.hpp"
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * Checks a candidate minimum spanning forest against a graph in O(V + E log V), after King's verification algorithm.
+ *
+ * The candidate must be a forest of edges of the graph that spans every component of it, and no non-tree edge may
+ * be lighter than the heaviest tree edge on the path between its ends, which is the cycle property. Ties are
+ * allowed, since they only pick between minimum trees. The path maxima come from King's Borůvka tree of the
+ * candidate, at most O(log V) each and usually a few memory reads, which in practice beats Komlós' linear descent
+ * with an offline LCA.
+ *
+ * @param graph The graph the candidate should be a minimum spanning forest of
+ * @param tree The candidate
+ * @return What is wrong with the candidate, if anything
+ */
+VerifyReport verify_mst(const Graph &graph, const MST &tree)
+{
+    VerifyReport report;
+    int verts = graph.vertNumber();
+    report.treeEdges = tree.edges.size();
+
+    // The edges that close a cycle are left out of everything else
+    UnionFind trees(verts);
+    vector<Graph::Edge> forest;
+    forest.reserve(tree.edges.size());
+    for (const auto &edge : tree.edges)
+    {
+        if (edge.src < 0 || edge.dest < 0 || edge.src >= verts || edge.dest >= verts)
+        {
+            report.missingEdges++;
+            continue;
+        }
+        if (trees.find(edge.src) == trees.find(edge.dest))
+        {
+            report.cycleEdges++;
+            continue;
+        }
+        trees.merge(edge.src, edge.dest);
+        forest.push_back(edge);
+    }
+
+    // The forest edges by their smaller end, to match them against the adjacency lists
+    vector<int> start(verts + 1, 0);
+    for (const auto &edge : forest)
+    {
+        start[min(edge.src, edge.dest) + 1]++;
+    }
+    for (int v = 0; v < verts; v++)
+    {
+        start[v + 1] += start[v];
+    }
+    vector<int> byEnd(forest.size());
+    {
+        vector<int> next(start.begin(), start.end() - 1);
+        for (int i = 0; i < static_cast<int>(forest.size()); i++)
+        {
+            byEnd[next[min(forest[i].src, forest[i].dest)]++] = i;
+        }
+    }
+
+    BoruvkaTree boruvka(verts, forest);
+
+    // In a forest there is at most one edge between two vertices, so a stamp per vertex is enough to match them
+    vector<int> stamp(verts, -1), wanted(verts, 0);
+    for (int u = 0; u < verts; u++)
+    {
+        for (int k = start[u]; k < start[u + 1]; k++)
+        {
+            const auto &edge = forest[byEnd[k]];
+            int v = max(edge.src, edge.dest);
+            stamp[v] = u;
+            wanted[v] = edge.weight;
+        }
+        int matched = 0;
+        for (const auto &[v, w] : graph.adjList[u])
+        {
+            if (v <= u)
+            {
+                continue;
+            }
+            if (stamp[v] == u && wanted[v] == w)
+            {
+                stamp[v] = -1;
+                matched++;
+                continue;
+            }
+            if (!boruvka.connected(u, v))
+            {
+                report.unspannedEdges++;
+                continue;
+            }
+            report.checkedEdges++;
+            int heaviest = boruvka.pathMax(u, v);
+            if (w < heaviest)
+            {
+                report.violations.push_back({Graph::Edge(u, v, w), heaviest});
+            }
+        }
+        report.missingEdges += start[u + 1] - start[u] - matched;
+    }
+    return report;
+}
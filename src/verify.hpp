@@ -0,0 +1,39 @@
+#ifndef VERIFY_HPP
+#define VERIFY_HPP
+
+#include "graph.hpp"
+#include <vector>
+
+/**
+ * @brief The outcome of checking a candidate tree against a graph.
+ */
+struct VerifyReport
+{
+    /**
+     * @brief A non-tree edge lighter than the heaviest tree edge on the path between its ends.
+     */
+    struct Violation
+    {
+        Graph::Edge edge; /**< The non-tree edge. */
+        int pathMax;      /**< The heaviest edge weight on the tree path between its ends. */
+    };
+
+    int treeEdges = 0;                /**< The edges of the candidate. */
+    int checkedEdges = 0;             /**< The non-tree edges compared against their tree path. */
+    int missingEdges = 0;             /**< Candidate edges the graph does not have with that weight. */
+    int cycleEdges = 0;               /**< Candidate edges that close a cycle with earlier ones. */
+    int unspannedEdges = 0;           /**< Graph edges between two trees of the candidate, so it does not span. */
+    std::vector<Violation> violations; /**< Every non-tree edge that proves the candidate is not minimal. */
+
+    /**
+     * @return True if the candidate is a minimum spanning forest of the graph.
+     */
+    bool valid() const
+    {
+        return missingEdges == 0 && cycleEdges == 0 && unspannedEdges == 0 && violations.empty();
+    }
+};
+
+VerifyReport verify_mst(const Graph &graph, const MST &tree);
+
+#endif
@@ -0,0 +1,64 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <cmath>
+#include "../src/approx.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/graph.hpp"
+#include "test_graphs.hpp"
+
+using namespace std;
+
+TEST_CASE("MST Weight Estimate: Exact When Every Vertex Fits", "[estimate_mst_weight]")
+{
+    // Fewer vertices than samples and than the size cap, so nothing is sampled or truncated
+    for (int seed = 0; seed < 5; seed++)
+    {
+        Graph graph = randomGraph(40, 60 + seed * 20, 20, seed);
+        MST exact = kruskal_mst(graph);
+        MSTEstimate estimate = estimate_mst_weight(graph, 0.05);
+        REQUIRE(estimate.samples == 40);
+        REQUIRE(estimate.weight == Catch::Approx(exact.totalWeight));
+        REQUIRE(estimate.components == Catch::Approx(40.0 - exact.edges.size()));
+    }
+
+    SECTION("A graph with no edges weighs nothing")
+    {
+        MSTEstimate estimate = estimate_mst_weight(Graph(10), 0.1);
+        REQUIRE(estimate.weight == 0);
+        REQUIRE(estimate.components == 10);
+    }
+}
+
+TEST_CASE("MST Weight Estimate: Close on Large Graphs", "[estimate_mst_weight]")
+{
+    Graph graph = randomGraph(100000, 400000, 100, 17);
+    double exact = kruskal_mst(graph).totalWeight;
+
+    MSTEstimate estimate = estimate_mst_weight(graph, 0.05, 3);
+    REQUIRE(fabs(estimate.weight - exact) / exact < 0.05);
+    // Sublinear, it looks at a small part of the 800000 adjacency entries
+    REQUIRE(estimate.edgesScanned < 800000 * 2);
+    REQUIRE(estimate_mst_weight(graph, 0.05, 3).weight == estimate.weight);
+}
+
+TEST_CASE("Bucketed Kruskal: Within One Plus Epsilon", "[approx_mst_buckets]")
+{
+    for (double epsilon : {0.01, 0.1, 0.5})
+    {
+        Graph graph = randomGraph(3000, 20000, 100000, 5);
+        graph.addEdge(0, 1, 0);
+        graph.addEdge(2, 3, -7);
+        MST exact = kruskal_mst(graph);
+        MST approx = approx_mst_buckets(graph, epsilon);
+
+        REQUIRE(approx.edges.size() == exact.edges.size());
+        REQUIRE(approx.totalWeight >= exact.totalWeight);
+        REQUIRE(approx.totalWeight <= (1 + epsilon) * exact.totalWeight);
+        UnionFind unionFind(3000);
+        for (const auto &edge : approx.edges)
+        {
+            REQUIRE(unionFind.find(edge.src) != unionFind.find(edge.dest));
+            unionFind.merge(edge.src, edge.dest);
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <random>
+#include <vector>
+#include "../src/boruvka_tree.hpp"
+#include "../src/bottleneck.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/graph.hpp"
+
+using namespace std;
+
+TEST_CASE("Boruvka Tree: Matches the Heavy-Light Index", "[boruvka_tree]")
+{
+    int verts = 2000;
+    mt19937 random(23);
+    uniform_int_distribution<int> vertex(0, verts - 1), weight(-1000, 1000);
+    Graph graph(verts);
+    // Sparse, so there are several trees and lone vertices
+    for (int i = 0; i < 1900; i++)
+    {
+        int u = vertex(random), v = vertex(random);
+        if (u != v)
+        {
+            graph.addEdge(u, v, weight(random));
+        }
+    }
+    MST forest = kruskal_mst(graph);
+    BoruvkaTree boruvka(verts, forest.edges);
+    PathMaxIndex index(verts, forest);
+    for (int i = 0; i < 20000; i++)
+    {
+        int u = vertex(random), v = vertex(random);
+        int expected = index.query(u, v);
+        REQUIRE(boruvka.pathMax(u, v) == expected);
+        REQUIRE(boruvka.connected(u, v) == (expected != PathMaxIndex::NO_PATH));
+    }
+    REQUIRE(boruvka.pathMax(-1, 0) == BoruvkaTree::NO_PATH);
+    REQUIRE(boruvka.pathMax(0, verts) == BoruvkaTree::NO_PATH);
+}
+
+TEST_CASE("Boruvka Tree: Ties and Stars", "[boruvka_tree]")
+{
+    // A star with equal weights, where every leaf picks the same center
+    int verts = 1000;
+    vector<Graph::Edge> star;
+    for (int v = 1; v < verts; v++)
+    {
+        star.emplace_back(0, v, 5);
+    }
+    star.back().weight = 9;
+    BoruvkaTree boruvka(verts, star);
+    REQUIRE(boruvka.pathMax(1, 2) == 5);
+    REQUIRE(boruvka.pathMax(0, 1) == 5);
+    REQUIRE(boruvka.pathMax(1, verts - 1) == 9);
+    REQUIRE(boruvka.pathMax(3, 3) == BoruvkaTree::NO_EDGE);
+}
@@ -0,0 +1,85 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <random>
+#include <vector>
+#include "../src/bottleneck.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/graph.hpp"
+
+using namespace std;
+
+/**
+ * The bottleneck distance the slow way: the weight of the edge that first joins `u` and `v` in Kruskal's order
+ */
+static int minimax(int verts, vector<Graph::Edge> edges, int u, int v)
+{
+    sort(edges.begin(), edges.end(), [](const Graph::Edge &a, const Graph::Edge &b)
+         { return a.weight < b.weight; });
+    UnionFind unionFind(verts);
+    for (const auto &edge : edges)
+    {
+        unionFind.merge(edge.src, edge.dest);
+        if (unionFind.find(u) == unionFind.find(v))
+        {
+            return edge.weight;
+        }
+    }
+    return PathMaxIndex::NO_PATH;
+}
+
+TEST_CASE("Bottleneck Index: Matches the Minimax Distance", "[bottleneck]")
+{
+    int verts = 300;
+    mt19937 random(17);
+    uniform_int_distribution<int> vertex(0, verts - 1), weight(-100, 1000);
+    Graph graph(verts);
+    vector<Graph::Edge> edges;
+    // Sparse, so there are several trees
+    for (int i = 0; i < 330; i++)
+    {
+        int u = vertex(random), v = vertex(random), w = weight(random);
+        if (u != v)
+        {
+            graph.addEdge(u, v, w);
+            edges.emplace_back(u, v, w);
+        }
+    }
+    PathMaxIndex index(verts, kruskal_mst(graph));
+
+    vector<pair<int, int>> queries;
+    for (int i = 0; i < 2000; i++)
+    {
+        int u = vertex(random), v = vertex(random);
+        queries.emplace_back(u, v);
+        int expected = u == v ? PathMaxIndex::NO_EDGE : minimax(verts, edges, u, v);
+        REQUIRE(index.query(u, v) == expected);
+        REQUIRE(index.query(v, u) == expected);
+    }
+
+    // The batch gives the same answers, on any number of threads
+    ThreadPool pool(4);
+    vector<int> answers = index.queryBatch(queries, pool);
+    for (size_t i = 0; i < queries.size(); i++)
+    {
+        REQUIRE(answers[i] == index.query(queries[i].first, queries[i].second));
+    }
+}
+
+TEST_CASE("Bottleneck Index: Long Path", "[bottleneck]")
+{
+    int verts = 5000;
+    MST path;
+    for (int v = 1; v < verts; v++)
+    {
+        // The heaviest edge sits in the middle
+        int w = v == verts / 2 ? 1000000 : v % 97;
+        path.edges.emplace_back(v - 1, v, w);
+    }
+    PathMaxIndex index(verts, path);
+    REQUIRE(index.query(0, verts - 1) == 1000000);
+    REQUIRE(index.query(0, verts / 2 - 1) == 96);
+    REQUIRE(index.query(verts - 1, verts / 2 + 3) == 96);
+    REQUIRE(index.query(10, 11) == 11);
+    REQUIRE(index.query(7, 7) == PathMaxIndex::NO_EDGE);
+    REQUIRE(index.query(-1, 7) == PathMaxIndex::NO_PATH);
+}
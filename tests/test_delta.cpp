@@ -0,0 +1,88 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <random>
+#include <vector>
+#include "../src/delta.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/graph.hpp"
+
+using namespace std;
+
+/**
+ * A random change set against a graph, a third of it insertions, deletions of existing edges and reweights
+ */
+static vector<EdgeUpdate> randomDelta(const Graph &graph, int count, mt19937 &random)
+{
+    uniform_int_distribution<int> vertex(0, graph.vertNumber() - 1), weight(-20, 200);
+    vector<EdgeUpdate> delta;
+    for (int i = 0; i < count; i++)
+    {
+        int u = vertex(random);
+        int kind = random() % 3;
+        if (kind == 0 || graph.adjList[u].empty())
+        {
+            delta.push_back({true, u, vertex(random), weight(random)});
+            continue;
+        }
+        int v = graph.adjList[u][random() % graph.adjList[u].size()].first;
+        delta.push_back({false, u, v, 0});
+        if (kind == 2)
+        {
+            delta.push_back({true, u, v, weight(random)});
+        }
+    }
+    return delta;
+}
+
+TEST_CASE("MST Update: Matches the Forest of the Changed Graph", "[delta_mst]")
+{
+    int verts = 400;
+    mt19937 random(8);
+    uniform_int_distribution<int> vertex(0, verts - 1), weight(-20, 200);
+    for (int round = 0; round < 20; round++)
+    {
+        Graph graph(verts);
+        // Sparse enough that some rounds leave the graph in pieces
+        int edges = round % 2 == 0 ? 1600 : 380;
+        for (int i = 0; i < edges; i++)
+        {
+            int u = vertex(random), v = vertex(random);
+            if (u != v)
+            {
+                graph.addEdge(u, v, weight(random));
+            }
+        }
+        MST tree = kruskal_mst(graph);
+        vector<EdgeUpdate> delta = randomDelta(graph, 1 + round * 5, random);
+
+        DeltaStats stats;
+        MST updated = apply_delta(graph, tree, delta, &stats);
+        MST expected = kruskal_mst(graph);
+        REQUIRE(updated.totalWeight == expected.totalWeight);
+        REQUIRE(updated.edges.size() == expected.edges.size());
+        REQUIRE(stats.inserted + stats.deleted + stats.ignored == static_cast<int>(delta.size()));
+    }
+}
+
+TEST_CASE("MST Update: Deleted Tree Edges Are Replaced", "[delta_mst]")
+{
+    Graph graph(4);
+    graph.addEdge(0, 1, 1);
+    graph.addEdge(1, 2, 2);
+    graph.addEdge(2, 3, 3);
+    graph.addEdge(0, 3, 10);
+    graph.addEdge(0, 2, 7);
+    MST tree = kruskal_mst(graph);
+
+    DeltaStats stats;
+    MST updated = apply_delta(graph, tree, {{false, 2, 1, 0}, {false, 3, 1, 0}, {true, 1, 1, 4}}, &stats);
+    REQUIRE(updated.totalWeight == 11);
+    REQUIRE(stats.cutEdges == 1);
+    REQUIRE(stats.deleted == 1);
+    REQUIRE(stats.ignored == 2);
+
+    // A cheaper weight for an edge outside the tree swaps it in
+    updated = apply_delta(graph, updated, {{false, 0, 3, 0}, {true, 0, 3, 2}});
+    REQUIRE(updated.totalWeight == 6);
+    REQUIRE(updated.totalWeight == kruskal_mst(graph).totalWeight);
+}
@@ -0,0 +1,152 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <set>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include "../src/dendrogram.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/prim.hpp"
+#include "../src/graph.hpp"
+#include "test_graphs.hpp"
+
+using namespace std;
+
+/**
+ * Checks that the labels group the vertices like the components of the edges of weight at most `threshold`.
+ */
+static bool sameClusters(const Graph &graph, int threshold, const vector<int> &labels)
+{
+    UnionFind components(graph.vertNumber());
+    for (int u = 0; u < graph.vertNumber(); u++)
+    {
+        for (const auto &[v, weight] : graph.adjList[u])
+        {
+            if (weight <= threshold)
+            {
+                components.merge(u, v);
+            }
+        }
+    }
+    for (int u = 0; u < graph.vertNumber(); u++)
+    {
+        for (int v = u + 1; v < graph.vertNumber(); v++)
+        {
+            if ((components.find(u) == components.find(v)) != (labels[u] == labels[v]))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+TEST_CASE("Single Linkage: Merges Follow Kruskal's Order", "[dendrogram]")
+{
+    Graph graph(4);
+    graph.addEdge(0, 1, 1);
+    graph.addEdge(2, 3, 2);
+    graph.addEdge(1, 2, 5);
+    graph.addEdge(0, 3, 9);
+    MST tree;
+    Dendrogram dendrogram = single_linkage(graph, &tree);
+
+    REQUIRE(tree.totalWeight == 8);
+    REQUIRE(dendrogram.merges.size() == 3);
+    REQUIRE(dendrogram.merges[0].left == 0);
+    REQUIRE(dendrogram.merges[0].right == 1);
+    REQUIRE(dendrogram.merges[1].left == 2);
+    REQUIRE(dendrogram.merges[1].right == 3);
+    REQUIRE(dendrogram.merges[2].left == 4);
+    REQUIRE(dendrogram.merges[2].right == 5);
+    REQUIRE(dendrogram.merges[2].height == 5);
+    REQUIRE(dendrogram.merges[2].size == 4);
+    REQUIRE(cutClusters(dendrogram, 2) == vector<int>{0, 0, 1, 1});
+    REQUIRE(cutClusters(dendrogram, 1) == vector<int>{0, 0, 0, 0});
+    REQUIRE(cutThreshold(dendrogram, 1) == vector<int>{0, 0, 1, 2});
+}
+
+TEST_CASE("Single Linkage: Cuts Match the Components Under a Threshold", "[dendrogram]")
+{
+    Graph graph = randomGraph(300, 500, 50, 4);
+    Dendrogram dendrogram = single_linkage(graph);
+    REQUIRE(dendrogram.merges.size() == kruskal_mst(graph).edges.size());
+
+    for (int threshold : {0, 5, 12, 25, 50})
+    {
+        REQUIRE(sameClusters(graph, threshold, cutThreshold(dendrogram, threshold)));
+    }
+    for (int k : {1, 10, 100, 300})
+    {
+        vector<int> labels = cutClusters(dendrogram, k);
+        int clusters = *max_element(labels.begin(), labels.end()) + 1;
+        REQUIRE(clusters == max(k, dendrogram.components()));
+    }
+}
+
+TEST_CASE("Single Linkage: Any Engine Gives the Same Hierarchy", "[dendrogram]")
+{
+    Graph graph = randomGraph(500, 4000, 1000000, 8);
+    // A heavy path keeps it connected, Prim only spans the component of its start
+    for (int v = 1; v < graph.vertNumber(); v++)
+    {
+        graph.addEdge(v - 1, v, 2000000 + v);
+    }
+    Dendrogram fromKruskal = single_linkage(graph);
+    Dendrogram fromPrim = dendrogramFromTree(graph.vertNumber(), prim_mst(graph));
+    REQUIRE(fromKruskal.merges.size() == fromPrim.merges.size());
+    for (size_t i = 0; i < fromKruskal.merges.size(); i++)
+    {
+        REQUIRE(fromKruskal.merges[i].height == fromPrim.merges[i].height);
+    }
+    for (int k : {2, 7, 50})
+    {
+        REQUIRE(cutClusters(fromKruskal, k) == cutClusters(fromPrim, k));
+    }
+}
+
+TEST_CASE("Single Linkage: Binary File Layout", "[dendrogram]")
+{
+    Graph graph = randomGraph(50, 200, 20, 2);
+    Dendrogram dendrogram = single_linkage(graph);
+    string linkagePath = "test_dendrogram_linkage.bin", labelsPath = "test_dendrogram_labels.bin";
+    REQUIRE(writeLinkage(dendrogram, linkagePath));
+    vector<int> cut = cutClusters(dendrogram, 5);
+    REQUIRE(writeLabels(cut, labelsPath));
+
+    ifstream linkage(linkagePath, ios::binary);
+    char magic[8];
+    int32_t counts[2];
+    linkage.read(magic, 8);
+    linkage.read(reinterpret_cast<char *>(counts), sizeof(counts));
+    REQUIRE(memcmp(magic, "MSTLINK", 8) == 0);
+    REQUIRE(counts[0] == 50);
+    REQUIRE(counts[1] == static_cast<int32_t>(dendrogram.merges.size()));
+    for (const auto &merge : dendrogram.merges)
+    {
+        double row[4];
+        linkage.read(reinterpret_cast<char *>(row), sizeof(row));
+        REQUIRE(row[0] == merge.left);
+        REQUIRE(row[1] == merge.right);
+        REQUIRE(row[2] == merge.height);
+        REQUIRE(row[3] == merge.size);
+    }
+    REQUIRE(linkage.peek() == EOF);
+
+    ifstream labels(labelsPath, ios::binary);
+    labels.read(magic, 8);
+    labels.read(reinterpret_cast<char *>(counts), sizeof(counts));
+    REQUIRE(memcmp(magic, "MSTLABEL", 8) == 0);
+    REQUIRE(counts[0] == 50);
+    REQUIRE(counts[1] == 5);
+    vector<int32_t> values(50);
+    labels.read(reinterpret_cast<char *>(values.data()), values.size() * sizeof(int32_t));
+    REQUIRE(values == vector<int32_t>(cut.begin(), cut.end()));
+
+    linkage.close();
+    labels.close();
+    remove(linkagePath.c_str());
+    remove(labelsPath.c_str());
+}
@@ -0,0 +1,80 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <climits>
+#include <cstdlib>
+#include <vector>
+#include "../src/dense_prim.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/graph.hpp"
+
+using namespace std;
+
+TEST_CASE("Dense Prim: Vectorized Argmin", "[prim_mst_dense]")
+{
+    INFO("Kernels: " << denseKernelName());
+    // Sizes that are not multiples of the vector width exercise the scalar tails
+    for (int n : {1, 3, 4, 7, 8, 13, 64, 101})
+    {
+        vector<int> key(n, INT_MAX);
+        REQUIRE(denseArgmin(key.data(), n) == -1);
+
+        for (int j = 0; j < n; j++)
+        {
+            key[j] = 1000 - (j * 37) % 500;
+        }
+        int expected = 0;
+        for (int j = 1; j < n; j++)
+        {
+            if (key[j] < key[expected])
+            {
+                expected = j;
+            }
+        }
+        REQUIRE(denseArgmin(key.data(), n) == expected);
+
+        // The first of several equal minimums is picked
+        key[n - 1] = -5;
+        key[n / 2] = -5;
+        REQUIRE(denseArgmin(key.data(), n) == n / 2);
+    }
+}
+
+TEST_CASE("Dense Prim: Matches Kruskal on a Complete Graph", "[prim_mst_dense]")
+{
+    srand(11);
+    Graph graph(73);
+    for (int u = 0; u < 73; u++)
+    {
+        for (int v = u + 1; v < 73; v++)
+        {
+            graph.addEdge(u, v, 1 + rand() % 500);
+        }
+    }
+
+    MST expected = kruskal_mst(graph);
+    MST mst = prim_mst_dense(graph);
+
+    SECTION("Check Total Weight for Complete Graph")
+    {
+        REQUIRE(mst.totalWeight == expected.totalWeight);
+        REQUIRE(mst.edges.size() == 72);
+    }
+
+    SECTION("Implicit Weights Give the Same Tree")
+    {
+        WeightMatrix matrix = WeightMatrix::fromGraph(graph);
+        MST implicitMst = prim_mst_implicit(73, [&](int u, int v)
+                                            { return matrix.row(u)[v]; });
+        REQUIRE(implicitMst.totalWeight == expected.totalWeight);
+    }
+}
+
+TEST_CASE("Dense Prim: Implicit Complete Graph", "[prim_mst_dense]")
+{
+    // Points on a line, the MST is the path between neighbours
+    vector<int> points{5, 40, 12, 33, 0, 27, 19};
+    MST mst = prim_mst_implicit(points.size(), [&](int u, int v)
+                                { return abs(points[u] - points[v]); });
+    REQUIRE(mst.totalWeight == 40);
+    REQUIRE(mst.edges.size() == 6);
+}
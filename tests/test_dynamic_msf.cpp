@@ -0,0 +1,400 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <random>
+#include <vector>
+#include <tuple>
+#include <algorithm>
+#include <numeric>
+#include "../src/dynamic_msf.hpp"
+#include "../src/euler_tour.hpp"
+#include "../src/link_cut_tree.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/graph.hpp"
+
+using namespace std;
+
+TEST_CASE("Dynamic MSF: Euler Tour Forest Link, Cut and Search", "[dynamic_msf]")
+{
+    EulerTourForest forest(5);
+    auto a = forest.link(0, 1, 10);
+    auto b = forest.link(1, 2, 11);
+    forest.link(3, 4, 12);
+    REQUIRE(forest.connected(0, 2));
+    REQUIRE_FALSE(forest.connected(0, 3));
+    REQUIRE(forest.treeSize(2) == 3);
+    REQUIRE(forest.treeSize(4) == 2);
+
+    forest.setValue(2, 7);
+    forest.setValue(0, 9);
+    forest.setValue(4, 1);
+    REQUIRE(forest.minValueVertex(1) == 2);
+    REQUIRE(forest.minValueVertex(3) == 4);
+
+    forest.setMark(a.second, true);
+    forest.setMark(b.first, true);
+    vector<int> marked = forest.markedEdges(0);
+    sort(marked.begin(), marked.end());
+    REQUIRE(marked == vector<int>{10, 11});
+
+    forest.cut(b);
+    REQUIRE_FALSE(forest.connected(0, 2));
+    REQUIRE(forest.treeSize(0) == 2);
+    REQUIRE(forest.minValueVertex(0) == 0);
+    REQUIRE(forest.markedEdges(1) == vector<int>{10});
+    forest.setValue(0, EulerTourForest::NONE);
+    REQUIRE(forest.minValueVertex(1) == -1);
+}
+
+TEST_CASE("Dynamic MSF: Link-Cut Tree Ancestors and Path Labels", "[dynamic_msf]")
+{
+    // The tree 0 - 1 - 2 with 3 below 1, edge nodes 4 to 6 in between
+    LinkCutTree tree(4);
+    int a = tree.addNode(true, 1), b = tree.addNode(true, 2), c = tree.addNode(true, 3);
+    tree.link(0, a);
+    tree.link(a, 1);
+    tree.link(1, b);
+    tree.link(b, 2);
+    tree.link(1, c);
+    tree.link(c, 3);
+
+    tree.makeRoot(0);
+    REQUIRE(tree.lca(2, 3) == 1);
+    REQUIRE(tree.lca(3, 0) == 0);
+    REQUIRE(tree.parent(3) == c);
+    REQUIRE(tree.parent(c) == 1);
+    REQUIRE(tree.parent(0) == -1);
+
+    tree.reserveLabels(2);
+    REQUIRE(tree.label(a, 0) == -1);
+    tree.labelPath(0, 2, 0, 7);
+    tree.labelPath(3, 1, 1, 8);
+    tree.makeRoot(3);
+    REQUIRE(tree.label(a, 0) == 7);
+    REQUIRE(tree.label(b, 0) == 7);
+    REQUIRE(tree.label(c, 0) == -1);
+    REQUIRE(tree.label(c, 1) == 8);
+    REQUIRE(tree.label(b, 1) == -1);
+
+    // A reused edge node starts without labels
+    tree.cut(1, b);
+    tree.cut(b, 2);
+    tree.resetNode(b, true, 5);
+    REQUIRE(tree.label(b, 0) == -1);
+}
+
+TEST_CASE("Dynamic MSF: Decremental Structure Replaces With the Lightest Crossing Edge", "[dynamic_msf]")
+{
+    // The path 0 - 1 - 2 - 3 - 4 and three non-tree edges over it
+    DecrementalMSF small(5);
+    small.addEdge(0, 1, 1, true);
+    int middle = small.addEdge(1, 2, 2, true);
+    small.addEdge(2, 3, 3, true);
+    small.addEdge(3, 4, 4, true);
+    int far = small.addEdge(0, 4, 9, false);
+    int near = small.addEdge(1, 3, 7, false);
+    int inside = small.addEdge(0, 2, 8, false);
+
+    REQUIRE(small.deleteEdge(middle) == near);
+    REQUIRE(small.isTreeEdge(near));
+    REQUIRE(small.deleteEdge(near) == inside);
+    REQUIRE(small.deleteEdge(far) == -1);
+    REQUIRE(small.nonTreeEdges().empty());
+
+    SECTION("Random graphs, deleted in random order")
+    {
+        mt19937 random(5);
+        for (int run = 0; run < 50; run++)
+        {
+            int verts = 30 + run;
+            uniform_int_distribution<int> vertex(0, verts - 1), weight(1, 20);
+            // The edges as (key, u, v, weight) in Kruskal's order, so the forest is picked as they are added
+            vector<tuple<uint64_t, int, int, int>> graph;
+            for (int i = 0; i < verts * 3; i++)
+            {
+                int u = vertex(random), v = vertex(random), w = weight(random);
+                if (u != v)
+                {
+                    graph.emplace_back(edgeRank(w, i), u, v, w);
+                }
+            }
+            sort(graph.begin(), graph.end());
+            DecrementalMSF msf(verts, run);
+            UnionFind components(verts);
+            long long total = 0;
+            for (const auto &[key, u, v, w] : graph)
+            {
+                bool tree = components.find(u) != components.find(v);
+                if (tree)
+                {
+                    components.merge(u, v);
+                    total += w;
+                }
+                msf.addEdge(u, v, key, tree);
+            }
+
+            vector<int> order(graph.size());
+            iota(order.begin(), order.end(), 0);
+            shuffle(order.begin(), order.end(), random);
+            vector<bool> live(graph.size(), true);
+            for (int gone : order)
+            {
+                if (msf.isTreeEdge(gone))
+                {
+                    total -= get<3>(graph[gone]);
+                }
+                int replacement = msf.deleteEdge(gone);
+                live[gone] = false;
+                if (replacement != -1)
+                {
+                    total += get<3>(graph[replacement]);
+                }
+
+                Graph rest(verts);
+                for (size_t i = 0; i < graph.size(); i++)
+                {
+                    if (live[i])
+                    {
+                        rest.addEdge(get<1>(graph[i]), get<2>(graph[i]), get<3>(graph[i]));
+                    }
+                }
+                REQUIRE(kruskal_mst(rest).totalWeight == total);
+            }
+            // Every edge moves up at most once per level, and there are fewer than 7 levels above 0
+            REQUIRE(msf.promotionCount() <= static_cast<long long>(graph.size()) * 6);
+        }
+    }
+}
+
+TEST_CASE("Dynamic MSF: Mixed Updates Keep the Forest Minimal", "[dynamic_msf]")
+{
+    int verts = 120;
+    mt19937 random(7);
+    uniform_int_distribution<int> vertex(0, verts - 1), weight(-20, 60);
+    DynamicMSF dynamic(verts);
+    // The live edges, as (u, v, weight, id)
+    vector<tuple<int, int, int, int>> live;
+
+    for (int i = 1; i <= 6000; i++)
+    {
+        if (live.size() < 300 || random() % 100 < 45)
+        {
+            int u = vertex(random), v = vertex(random), w = weight(random);
+            int id = dynamic.insertEdge(u, v, w);
+            if (u == v)
+            {
+                REQUIRE(id == -1);
+                continue;
+            }
+            live.emplace_back(u, v, w, id);
+        }
+        else
+        {
+            size_t pick = random() % live.size();
+            REQUIRE(dynamic.deleteEdge(get<3>(live[pick])));
+            live[pick] = live.back();
+            live.pop_back();
+        }
+
+        if (i % 200 == 0)
+        {
+            Graph graph(verts);
+            UnionFind components(verts);
+            for (const auto &[u, v, w, id] : live)
+            {
+                graph.addEdge(u, v, w);
+                components.merge(u, v);
+            }
+            MST expected = kruskal_mst(graph);
+            REQUIRE(dynamic.totalWeight() == expected.totalWeight);
+            REQUIRE(dynamic.edgeCount() == static_cast<int>(expected.edges.size()));
+            for (int j = 0; j < 50; j++)
+            {
+                int u = vertex(random), v = vertex(random);
+                REQUIRE(dynamic.connected(u, v) == (components.find(u) == components.find(v)));
+            }
+        }
+    }
+
+    // The edge set is a spanning forest with the reported weight
+    MST forest = dynamic.mst();
+    REQUIRE(forest.totalWeight == dynamic.totalWeight());
+    UnionFind unionFind(verts);
+    for (const auto &edge : forest.edges)
+    {
+        REQUIRE(unionFind.find(edge.src) != unionFind.find(edge.dest));
+        unionFind.merge(edge.src, edge.dest);
+    }
+}
+
+TEST_CASE("Dynamic MSF: Deleting Every Edge", "[dynamic_msf]")
+{
+    int verts = 64;
+    mt19937 random(3);
+    uniform_int_distribution<int> vertex(0, verts - 1), weight(1, 10);
+    DynamicMSF dynamic(verts);
+    vector<int> ids;
+    for (int i = 0; i < 400; i++)
+    {
+        int id = dynamic.insertEdge(vertex(random), vertex(random), weight(random));
+        if (id != -1)
+        {
+            ids.push_back(id);
+        }
+    }
+    shuffle(ids.begin(), ids.end(), random);
+    for (int id : ids)
+    {
+        REQUIRE(dynamic.deleteEdge(id));
+    }
+    REQUIRE(dynamic.totalWeight() == 0);
+    REQUIRE(dynamic.componentCount() == verts);
+    REQUIRE_FALSE(dynamic.connected(0, 1));
+}
+
+TEST_CASE("Dynamic MSF: Deleting by Endpoints", "[dynamic_msf]")
+{
+    DynamicMSF dynamic(4);
+    dynamic.insertEdge(0, 1, 5);
+    dynamic.insertEdge(1, 2, 5);
+    dynamic.insertEdge(2, 3, 5);
+    int shortcut = dynamic.insertEdge(0, 3, 1);
+    REQUIRE(dynamic.isTreeEdge(shortcut));
+    REQUIRE(dynamic.totalWeight() == 11);
+
+    REQUIRE(dynamic.deleteEdge(3, 0));
+    REQUIRE(dynamic.totalWeight() == 15);
+    REQUIRE_FALSE(dynamic.deleteEdge(0, 3));
+    REQUIRE(dynamic.deleteEdge(1, 2));
+    REQUIRE_FALSE(dynamic.connected(0, 3));
+    REQUIRE_FALSE(dynamic.deleteEdge(shortcut));
+    REQUIRE(dynamic.insertEdge(0, 9, 1) == -1);
+}
+
+TEST_CASE("Dynamic MSF: Replacement From Above the Winner's Level", "[dynamic_msf]")
+{
+    DynamicMSF dynamic(4, 0);
+    int first = -1;
+    for (const auto &[u, v, w] : vector<tuple<int, int, int>>{{2, 0, 4}, {1, 3, 4}, {0, 1, 8}, {0, 2, 7}, {3, 0, 7},
+                                                              {2, 3, 1}, {3, 2, 1}, {0, 1, 1}, {2, 0, 2}})
+    {
+        int id = dynamic.insertEdge(u, v, w);
+        if (first == -1 && w == 1)
+        {
+            first = id;
+        }
+    }
+    REQUIRE(dynamic.totalWeight() == 4);
+
+    // The parallel 3-2/1 replaces the deleted one, whichever bucket holds it
+    REQUIRE(dynamic.deleteEdge(first));
+    REQUIRE(dynamic.totalWeight() == 4);
+    REQUIRE(dynamic.edgeCount() == 3);
+}
+
+TEST_CASE("Dynamic MSF: Few Vertices, Few Weights and Parallel Edges", "[dynamic_msf]")
+{
+    mt19937 random(1);
+    for (int run = 0; run < 2000; run++)
+    {
+        int verts = 4 + run % 4;
+        uniform_int_distribution<int> vertex(0, verts - 1), weight(1, 3);
+        DynamicMSF dynamic(verts, run);
+        vector<tuple<int, int, int, int>> live;
+
+        for (int i = 0; i < 200; i++)
+        {
+            if (live.size() < 4 || random() % 100 < 60)
+            {
+                int u = vertex(random), v = vertex(random), w = weight(random);
+                int id = dynamic.insertEdge(u, v, w);
+                if (id == -1)
+                {
+                    continue;
+                }
+                live.emplace_back(u, v, w, id);
+            }
+            else
+            {
+                size_t pick = random() % live.size();
+                REQUIRE(dynamic.deleteEdge(get<3>(live[pick])));
+                live[pick] = live.back();
+                live.pop_back();
+            }
+
+            Graph graph(verts);
+            for (const auto &[u, v, w, id] : live)
+            {
+                graph.addEdge(u, v, w);
+            }
+            MST expected = kruskal_mst(graph);
+            REQUIRE(dynamic.totalWeight() == expected.totalWeight);
+            REQUIRE(dynamic.edgeCount() == static_cast<int>(expected.edges.size()));
+        }
+    }
+}
+
+TEST_CASE("Dynamic MSF: Building From a Whole Graph", "[dynamic_msf]")
+{
+    mt19937 random(9);
+    int verts = 300;
+    uniform_int_distribution<int> vertex(0, verts - 1), weight(-50, 50);
+    vector<Graph::Edge> initial;
+    for (int i = 0; i < 2000; i++)
+    {
+        initial.push_back({vertex(random), vertex(random), weight(random)});
+    }
+    // A self loop and an edge out of range leave their ids free
+    initial.push_back({7, 7, 1});
+    initial.push_back({0, verts, 1});
+
+    DynamicMSF dynamic(verts, initial);
+    vector<tuple<int, int, int, int>> live;
+    Graph whole(verts);
+    for (int i = 0; i < static_cast<int>(initial.size()); i++)
+    {
+        const auto &edge = initial[i];
+        bool valid = edge.src != edge.dest && edge.dest < verts;
+        REQUIRE((dynamic.findEdge(edge.src, edge.dest) != -1) == valid);
+        if (valid)
+        {
+            live.emplace_back(edge.src, edge.dest, edge.weight, i);
+            whole.addEdge(edge.src, edge.dest, edge.weight);
+        }
+    }
+    REQUIRE_FALSE(dynamic.deleteEdge(static_cast<int>(initial.size()) - 1));
+    MST expected = kruskal_mst(whole);
+    REQUIRE(dynamic.totalWeight() == expected.totalWeight);
+    REQUIRE(dynamic.edgeCount() == static_cast<int>(expected.edges.size()));
+
+    for (int i = 0; i < 3000; i++)
+    {
+        if (random() % 100 < 50)
+        {
+            int u = vertex(random), v = vertex(random), w = weight(random);
+            int id = dynamic.insertEdge(u, v, w);
+            if (id != -1)
+            {
+                live.emplace_back(u, v, w, id);
+            }
+        }
+        else
+        {
+            size_t pick = random() % live.size();
+            REQUIRE(dynamic.deleteEdge(get<3>(live[pick])));
+            live[pick] = live.back();
+            live.pop_back();
+        }
+
+        if (i % 300 == 0)
+        {
+            Graph graph(verts);
+            for (const auto &[u, v, w, id] : live)
+            {
+                graph.addEdge(u, v, w);
+            }
+            MST rest = kruskal_mst(graph);
+            REQUIRE(dynamic.totalWeight() == rest.totalWeight);
+            REQUIRE(dynamic.edgeCount() == static_cast<int>(rest.edges.size()));
+        }
+    }
+}
@@ -0,0 +1,134 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <cmath>
+#include <random>
+#include <vector>
+#include <climits>
+#include "../src/emst.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/graph.hpp"
+
+using namespace std;
+
+/**
+ * The exact length of the Euclidean MST with the O(n^2) array based Prim.
+ */
+static double bruteForceLength(const PointCloud &points)
+{
+    int n = points.size();
+    vector<double> key(n, INFINITY);
+    vector<char> inTree(n, 0);
+    double length = 0;
+    if (n == 0)
+    {
+        return 0;
+    }
+    key[0] = 0;
+    for (int iteration = 0; iteration < n; iteration++)
+    {
+        int u = -1;
+        for (int v = 0; v < n; v++)
+        {
+            if (!inTree[v] && (u == -1 || key[v] < key[u]))
+            {
+                u = v;
+            }
+        }
+        inTree[u] = 1;
+        length += key[u];
+        for (int v = 0; v < n; v++)
+        {
+            if (!inTree[v])
+            {
+                key[v] = min(key[v], points.distance(u, v));
+            }
+        }
+    }
+    return length;
+}
+
+/**
+ * Checks that the edges connect every point without a cycle.
+ */
+static bool isSpanningTree(int n, const MST &mst)
+{
+    if (static_cast<int>(mst.edges.size()) != max(0, n - 1))
+    {
+        return false;
+    }
+    UnionFind unionFind(n);
+    for (const auto &edge : mst.edges)
+    {
+        if (unionFind.find(edge.src) == unionFind.find(edge.dest))
+        {
+            return false;
+        }
+        unionFind.merge(edge.src, edge.dest);
+    }
+    return true;
+}
+
+TEST_CASE("Euclidean MST: Matches Brute Force on Random Points", "[euclidean_mst]")
+{
+    mt19937 random(3);
+    for (int dims : {1, 2, 3, 5})
+    {
+        for (int n : {2, 17, 300, 2000})
+        {
+            uniform_real_distribution<double> coordinate(-100, 100);
+            PointCloud points(dims);
+            for (int i = 0; i < n; i++)
+            {
+                vector<double> p(dims);
+                for (double &c : p)
+                {
+                    c = coordinate(random);
+                }
+                points.addPoint(p);
+            }
+
+            MST mst = euclidean_mst(points);
+            REQUIRE(isSpanningTree(n, mst));
+            REQUIRE(treeLength(points, mst) == Catch::Approx(bruteForceLength(points)).epsilon(1e-9));
+        }
+    }
+}
+
+TEST_CASE("Euclidean MST: Ties and Duplicates", "[euclidean_mst]")
+{
+    SECTION("A grid has many equal distances")
+    {
+        PointCloud grid(2);
+        for (int x = 0; x < 40; x++)
+        {
+            for (int y = 0; y < 30; y++)
+            {
+                grid.addPoint({static_cast<double>(x), static_cast<double>(y)});
+            }
+        }
+        MST mst = euclidean_mst(grid);
+        REQUIRE(isSpanningTree(1200, mst));
+        REQUIRE(mst.totalWeight == 1199);
+        REQUIRE(treeLength(grid, mst) == Catch::Approx(1199.0));
+    }
+
+    SECTION("Repeated points are joined with zero length edges")
+    {
+        PointCloud points(3);
+        for (int i = 0; i < 100; i++)
+        {
+            points.addPoint({1.0 * (i % 4), 0, 0});
+        }
+        MST mst = euclidean_mst(points);
+        REQUIRE(isSpanningTree(100, mst));
+        REQUIRE(treeLength(points, mst) == Catch::Approx(3.0));
+    }
+
+    SECTION("Empty and single point clouds have no edges")
+    {
+        REQUIRE(euclidean_mst(PointCloud(2)).edges.empty());
+        PointCloud single(2);
+        single.addPoint({4, 2});
+        REQUIRE(euclidean_mst(single).edges.empty());
+    }
+}
@@ -0,0 +1,89 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include "../src/forest.hpp"
+#include "../src/prim.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/graph.hpp"
+
+using namespace std;
+
+TEST_CASE("Spanning Forest: Disconnected Graph", "[msf]")
+{
+    // Three components, {0, 1, 2, 3}, {4, 5, 6} and the lone vertex 7
+    Graph graph(8);
+    graph.addEdge(0, 1, 4);
+    graph.addEdge(1, 2, 1);
+    graph.addEdge(2, 3, 3);
+    graph.addEdge(0, 3, 2);
+    graph.addEdge(0, 2, 5);
+    graph.addEdge(4, 5, 7);
+    graph.addEdge(5, 6, 6);
+    graph.addEdge(4, 6, 8);
+
+    int expectedWeight = 19;
+
+    SECTION("Components are found")
+    {
+        Components components = connectedComponents(graph);
+        REQUIRE(components.count == 3);
+        REQUIRE(components.label[0] == components.label[3]);
+        REQUIRE(components.label[4] != components.label[0]);
+        REQUIRE(components.size(components.label[7]) == 1);
+    }
+
+    SECTION("Kruskal reports every component")
+    {
+        MSF msf = kruskal_msf(graph);
+        REQUIRE(msf.componentCount() == 3);
+        REQUIRE(msf.totalWeight == expectedWeight);
+        REQUIRE(msf.trees[msf.component[0]].totalWeight == 6);
+        REQUIRE(msf.trees[msf.component[4]].totalWeight == 13);
+        REQUIRE(msf.trees[msf.component[7]].edges.empty());
+    }
+
+    SECTION("Prim reports every component")
+    {
+        ThreadPool pool(3);
+        MSF msf = prim_msf(graph, pool);
+        REQUIRE(msf.componentCount() == 3);
+        REQUIRE(msf.totalWeight == expectedWeight);
+        REQUIRE(msf.trees[msf.component[0]].edges.size() == 3);
+        REQUIRE(msf.trees[msf.component[4]].edges.size() == 2);
+        REQUIRE(msf.merged().edges.size() == 5);
+    }
+
+    SECTION("Prim no longer stops at the start vertex's component")
+    {
+        REQUIRE(prim_mst(graph).totalWeight == expectedWeight);
+    }
+}
+
+TEST_CASE("Spanning Forest: Many Components", "[msf]")
+{
+    // Lots of small random components, the case the parallel pass is meant for
+    srand(5);
+    Graph graph(3000);
+    for (int block = 0; block < 3000; block += 30)
+    {
+        for (int i = 0; i < 90; i++)
+        {
+            int u = block + rand() % 30, v = block + rand() % 30;
+            if (u != v)
+            {
+                graph.addEdge(u, v, 1 + rand() % 100);
+            }
+        }
+    }
+
+    ThreadPool pool(4);
+    MSF expected = kruskal_msf(graph);
+    MSF msf = prim_msf(graph, pool);
+    REQUIRE(msf.componentCount() == expected.componentCount());
+    REQUIRE(msf.totalWeight == expected.totalWeight);
+    for (int c = 0; c < msf.componentCount(); c++)
+    {
+        REQUIRE(msf.trees[c].totalWeight == expected.trees[c].totalWeight);
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef TEST_GRAPHS_HPP
+#define TEST_GRAPHS_HPP
+
+#include <random>
+#include "../src/graph.hpp"
+
+/**
+ * A random graph with `edges` tries at an edge and weights in `[1, maxWeight]`, the same graph for the same seed.
+ * Loops are dropped, so a small `maxWeight` gives a few components and many repeated weights, and the trees tie.
+ */
+inline Graph randomGraph(int verts, int edges, int maxWeight, unsigned seed)
+{
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> vertex(0, verts - 1), weight(1, maxWeight);
+    Graph graph(verts);
+    for (int i = 0; i < edges; i++)
+    {
+        int u = vertex(random), v = vertex(random);
+        if (u != v)
+        {
+            graph.addEdge(u, v, weight(random));
+        }
+    }
+    return graph;
+}
+
+#endif
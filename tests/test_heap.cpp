@@ -0,0 +1,153 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <climits>
+#include <algorithm>
+#include <vector>
+#include "../src/heap.hpp"
+#include "../src/prim.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/graph.hpp"
+
+using namespace std;
+
+template <int Arity>
+vector<int> drainHeap(IndexedDaryHeap<Arity> &heap)
+{
+    vector<int> order;
+    while (!heap.empty())
+    {
+        order.push_back(heap.popMin());
+    }
+    return order;
+}
+
+TEMPLATE_TEST_CASE_SIG("Indexed D-ary Heap: Ordering and Decrease Key", "[heap]", ((int Arity), Arity), 2, 4, 8)
+{
+    IndexedDaryHeap<Arity> heap(10);
+    vector<int> keys{9, 3, 7, 1, 8, 2, 6, 0, 5, 4};
+    for (int v = 0; v < 10; v++)
+    {
+        heap.push(v, keys[v]);
+    }
+    REQUIRE(heap.size() == 10);
+
+    SECTION("Vertices come out in key order")
+    {
+        vector<int> expected{7, 3, 5, 1, 9, 8, 6, 2, 4, 0};
+        REQUIRE(drainHeap(heap) == expected);
+    }
+
+    SECTION("Decrease key moves a vertex to the front")
+    {
+        heap.decreaseKey(0, -1);
+        REQUIRE(heap.key(0) == -1);
+        REQUIRE(heap.popMin() == 0);
+        REQUIRE_FALSE(heap.contains(0));
+        REQUIRE(heap.popMin() == 7);
+    }
+
+    SECTION("Clear empties the heap and allows reinsertion")
+    {
+        heap.clear();
+        REQUIRE(heap.empty());
+        REQUIRE_FALSE(heap.contains(3));
+        heap.push(3, 5);
+        REQUIRE(heap.popMin() == 3);
+    }
+}
+
+TEMPLATE_TEST_CASE("Priority Queue Policies: Ordering and Decrease Key", "[heap]", BinaryHeap, PairingHeap,
+                   FibonacciHeap, BucketQueue, RadixHeap)
+{
+    // Every policy has to cope with Prim's pattern of pushes, decreases below the last popped key, and pops
+    TestType queue = makeQueue<TestType>(8, 100);
+    queue.push(0, 50);
+    queue.push(1, 20);
+    queue.push(2, 70);
+    queue.push(3, 20);
+    REQUIRE(queue.popMin() != 0);
+    queue.push(4, 90);
+    queue.decreaseKey(2, 10);
+    queue.push(5, 5);
+    REQUIRE(queue.popMin() == 5);
+    REQUIRE(queue.popMin() == 2);
+    REQUIRE(queue.contains(0));
+    queue.decreaseKey(4, 30);
+    queue.push(6, 60);
+    queue.decreaseKey(0, 25);
+
+    vector<int> rest;
+    while (!queue.empty())
+    {
+        rest.push_back(queue.popMin());
+    }
+    REQUIRE(rest.size() == 4);
+    REQUIRE((rest[0] == 1 || rest[0] == 3));
+    REQUIRE(rest[1] == 0);
+    REQUIRE(rest[2] == 4);
+    REQUIRE(rest[3] == 6);
+}
+
+TEMPLATE_TEST_CASE("Prim's Algorithm: Every Policy Matches Kruskal", "[prim_mst]", BinaryHeap, IndexedDaryHeap<4>,
+                   PairingHeap, FibonacciHeap, BucketQueue, RadixHeap)
+{
+    // A connected random graph, a path through every vertex plus random edges
+    srand(7);
+    Graph graph(200);
+    for (int v = 1; v < 200; v++)
+    {
+        graph.addEdge(v - 1, v, 1 + rand() % 1000);
+    }
+    for (int i = 0; i < 3000; i++)
+    {
+        int u = rand() % 200, v = rand() % 200;
+        if (u != v)
+        {
+            graph.addEdge(u, v, 1 + rand() % 1000);
+        }
+    }
+
+    MST expected = kruskal_mst(graph);
+    MST mst = prim_mst_queue<TestType>(graph);
+    REQUIRE(mst.totalWeight == expected.totalWeight);
+    REQUIRE(mst.edges.size() == 199);
+}
+
+TEMPLATE_TEST_CASE("Prim's Algorithm: Bucket Policies Fall Back On Unfit Weights", "[prim_mst]", BucketQueue, RadixHeap)
+{
+    REQUIRE(TestType::acceptsKeys(0, 1000));
+    REQUIRE_FALSE(TestType::acceptsKeys(-5, 1000));
+
+    // A negative weight, and one far past the bucket range
+    Graph graph(5);
+    graph.addEdge(0, 1, -5);
+    graph.addEdge(1, 2, 3);
+    graph.addEdge(2, 3, INT_MAX - 1);
+    graph.addEdge(3, 4, 7);
+    graph.addEdge(0, 4, 2);
+    graph.addEdge(0, 2, 1);
+
+    MST mst = prim_mst_queue<TestType>(graph);
+    REQUIRE(mst.totalWeight == kruskal_mst(graph).totalWeight);
+    REQUIRE(mst.edges.size() == 4);
+}
+
+TEST_CASE("Prim's Algorithm: Heap Arities Agree", "[prim_mst]")
+{
+    Graph graph(6);
+    graph.addEdge(0, 1, 4);
+    graph.addEdge(0, 2, 4);
+    graph.addEdge(1, 2, 2);
+    graph.addEdge(2, 3, 3);
+    graph.addEdge(2, 5, 2);
+    graph.addEdge(2, 4, 4);
+    graph.addEdge(3, 4, 3);
+    graph.addEdge(5, 4, 3);
+
+    int expectedWeight = 14;
+
+    REQUIRE(prim_mst_dary<2>(graph).totalWeight == expectedWeight);
+    REQUIRE(prim_mst_dary<4>(graph).totalWeight == expectedWeight);
+    REQUIRE(prim_mst_dary<8>(graph).totalWeight == expectedWeight);
+    REQUIRE(prim_mst(graph).edges.size() == 5);
+}
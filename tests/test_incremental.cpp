@@ -0,0 +1,114 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <random>
+#include <vector>
+#include "../src/incremental.hpp"
+#include "../src/link_cut_tree.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/graph.hpp"
+
+using namespace std;
+
+TEST_CASE("Incremental MST: Link-Cut Tree Path Maximum", "[incremental_mst]")
+{
+    // A path 0 - 1 - 2 - 3 with edge nodes 4, 5 and 6 in between
+    LinkCutTree tree(4);
+    int a = tree.addNode(true, edgeRank(5, 0));
+    int b = tree.addNode(true, edgeRank(9, 1));
+    int c = tree.addNode(true, edgeRank(2, 2));
+    tree.link(0, a);
+    tree.link(a, 1);
+    tree.link(1, b);
+    tree.link(b, 2);
+    tree.link(2, c);
+    tree.link(c, 3);
+
+    REQUIRE(tree.connected(0, 3));
+    REQUIRE(tree.pathMax(0, 3) == b);
+    REQUIRE(tree.pathMax(2, 3) == c);
+    REQUIRE(tree.pathMax(1, 0) == a);
+    REQUIRE(tree.pathMax(1, 1) == -1);
+
+    tree.cut(1, b);
+    REQUIRE_FALSE(tree.connected(0, 3));
+    REQUIRE(tree.connected(2, 3));
+    REQUIRE(tree.findRoot(0) == tree.findRoot(a));
+}
+
+TEST_CASE("Incremental MST: Insertions Keep the Forest Minimal", "[incremental_mst]")
+{
+    int verts = 300;
+    mt19937 random(12);
+    uniform_int_distribution<int> vertex(0, verts - 1), weight(-50, 1000);
+    Graph graph(verts);
+    IncrementalMST incremental(verts);
+
+    for (int i = 1; i <= 3000; i++)
+    {
+        int u = vertex(random), v = vertex(random), w = weight(random);
+        incremental.insertEdge(u, v, w);
+        if (u != v)
+        {
+            graph.addEdge(u, v, w);
+        }
+        if (i % 100 == 0)
+        {
+            MST expected = kruskal_mst(graph);
+            REQUIRE(incremental.totalWeight() == expected.totalWeight);
+            REQUIRE(incremental.edgeCount() == static_cast<int>(expected.edges.size()));
+        }
+    }
+
+    // The edge set is a spanning forest with the reported weight
+    MST forest = incremental.mst();
+    REQUIRE(forest.totalWeight == incremental.totalWeight());
+    UnionFind unionFind(verts);
+    for (const auto &edge : forest.edges)
+    {
+        REQUIRE(unionFind.find(edge.src) != unionFind.find(edge.dest));
+        unionFind.merge(edge.src, edge.dest);
+    }
+}
+
+TEST_CASE("Incremental MST: Seeding From a Computed Tree", "[incremental_mst]")
+{
+    int verts = 200;
+    mt19937 random(4);
+    uniform_int_distribution<int> vertex(0, verts - 1), weight(1, 100);
+    Graph graph(verts);
+    for (int i = 0; i < 600; i++)
+    {
+        int u = vertex(random), v = vertex(random);
+        if (u != v)
+        {
+            graph.addEdge(u, v, weight(random));
+        }
+    }
+    IncrementalMST incremental(verts, kruskal_mst(graph));
+    REQUIRE(incremental.totalWeight() == kruskal_mst(graph).totalWeight);
+
+    for (int i = 0; i < 400; i++)
+    {
+        int u = vertex(random), v = vertex(random), w = weight(random);
+        if (u != v)
+        {
+            graph.addEdge(u, v, w);
+            incremental.insertEdge(u, v, w);
+        }
+    }
+    REQUIRE(incremental.totalWeight() == kruskal_mst(graph).totalWeight);
+    REQUIRE(incremental.componentCount() == verts - static_cast<int>(kruskal_mst(graph).edges.size()));
+}
+
+TEST_CASE("Incremental MST: Ignored Edges", "[incremental_mst]")
+{
+    IncrementalMST incremental(3);
+    REQUIRE(incremental.insertEdge(0, 1, 4));
+    REQUIRE(incremental.insertEdge(1, 2, 4));
+    REQUIRE_FALSE(incremental.insertEdge(0, 2, 4));
+    REQUIRE_FALSE(incremental.insertEdge(1, 1, -3));
+    REQUIRE_FALSE(incremental.insertEdge(0, 7, 1));
+    REQUIRE(incremental.insertEdge(0, 2, 3));
+    REQUIRE(incremental.totalWeight() == 7);
+    REQUIRE(incremental.edgeCount() == 2);
+}
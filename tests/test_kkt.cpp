@@ -0,0 +1,94 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include "../src/kkt.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/graph.hpp"
+
+using namespace std;
+
+/**
+ * Checks that the tree edges never close a cycle.
+ */
+static bool isForest(int verts, const MST &mst)
+{
+    UnionFind unionFind(verts);
+    for (const auto &edge : mst.edges)
+    {
+        if (unionFind.find(edge.src) == unionFind.find(edge.dest))
+        {
+            return false;
+        }
+        unionFind.merge(edge.src, edge.dest);
+    }
+    return true;
+}
+
+TEST_CASE("KKT Algorithm: Sparse Graph", "[kkt_mst]")
+{
+    Graph graph(10);
+    graph.addEdge(0, 9, 9);
+    graph.addEdge(0, 8, 8);
+    graph.addEdge(0, 2, 8);
+    graph.addEdge(1, 7, 6);
+    graph.addEdge(1, 5, 4);
+    graph.addEdge(2, 6, 10);
+    graph.addEdge(2, 3, 2);
+    graph.addEdge(2, 5, 5);
+    graph.addEdge(2, 7, 6);
+    graph.addEdge(3, 5, 10);
+    graph.addEdge(3, 7, 10);
+    graph.addEdge(4, 8, 9);
+    graph.addEdge(5, 9, 4);
+    graph.addEdge(6, 7, 4);
+
+    auto mst = kkt_mst(graph);
+    REQUIRE(mst.totalWeight == 50);
+    REQUIRE(mst.edges.size() == 9);
+}
+
+TEST_CASE("KKT Algorithm: Matches Kruskal on Random Graphs", "[kkt_mst]")
+{
+    // Big enough that the sampling and filtering levels run before the Kruskal base case
+    for (int seed = 0; seed < 5; seed++)
+    {
+        // Narrow weights give lots of ties, parallel edges are allowed, and some vertices stay disconnected
+        srand(seed);
+        int verts = 2000 + seed * 1000;
+        Graph graph(verts);
+        for (int i = 0; i < verts * (2 + seed * 2); i++)
+        {
+            int u = rand() % verts, v = rand() % verts;
+            if (u != v)
+            {
+                graph.addEdge(u, v, 1 + rand() % (seed % 2 ? 10 : 100000));
+            }
+        }
+
+        MST expected = kruskal_mst(graph);
+        MST mst = kkt_mst(graph, seed);
+        REQUIRE(mst.totalWeight == expected.totalWeight);
+        REQUIRE(mst.edges.size() == expected.edges.size());
+        REQUIRE(isForest(verts, mst));
+    }
+}
+
+TEST_CASE("KKT Algorithm: The Seed Makes Runs Reproducible", "[kkt_mst]")
+{
+    srand(7);
+    Graph graph(3000);
+    for (int i = 0; i < 30000; i++)
+    {
+        int u = rand() % 3000, v = rand() % 3000;
+        if (u != v)
+        {
+            graph.addEdge(u, v, 1 + rand() % 5);
+        }
+    }
+
+    MST first = kkt_mst(graph, 42);
+    MST second = kkt_mst(graph, 42);
+    REQUIRE(first.edges == second.edges);
+    REQUIRE(kkt_mst(graph, 43).totalWeight == first.totalWeight);
+}
@@ -0,0 +1,142 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <random>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include "../src/knn.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/graph.hpp"
+
+using namespace std;
+
+/**
+ * Points around a few random centres, so the neighbourhoods have some structure.
+ */
+static PointCloud clusteredPoints(int n, int dims, int clusters, unsigned seed)
+{
+    mt19937 random(seed);
+    uniform_real_distribution<double> centre(0, 100);
+    normal_distribution<double> spread(0, 4);
+    vector<vector<double>> centres(clusters, vector<double>(dims));
+    for (auto &c : centres)
+    {
+        for (double &x : c)
+        {
+            x = centre(random);
+        }
+    }
+    PointCloud points(dims);
+    vector<double> p(dims);
+    for (int i = 0; i < n; i++)
+    {
+        const auto &c = centres[i % clusters];
+        for (int d = 0; d < dims; d++)
+        {
+            p[d] = c[d] + spread(random);
+        }
+        points.addPoint(p);
+    }
+    return points;
+}
+
+TEST_CASE("K-NN Graph: Distance Kernel Matches the Plain Loop", "[knn]")
+{
+    INFO("Kernel: " << knnKernelName());
+    mt19937 random(3);
+    uniform_real_distribution<double> value(-10, 10);
+    for (int dims = 0; dims <= 21; dims++)
+    {
+        vector<double> a(dims), b(dims);
+        double expected = 0;
+        for (int d = 0; d < dims; d++)
+        {
+            a[d] = value(random);
+            b[d] = value(random);
+            expected += (a[d] - b[d]) * (a[d] - b[d]);
+        }
+        REQUIRE(squaredDistance(a.data(), b.data(), dims) == Catch::Approx(expected).margin(1e-9));
+    }
+}
+
+TEST_CASE("K-NN Graph: Brute Force Finds the Exact Neighbours", "[knn]")
+{
+    PointCloud points = clusteredPoints(600, 7, 5, 11);
+    int k = 6;
+    KnnLists lists = knn_brute_force(points, k);
+    REQUIRE(lists.size() == points.size());
+
+    for (int p = 0; p < points.size(); p++)
+    {
+        vector<int> others(points.size());
+        iota(others.begin(), others.end(), 0);
+        others.erase(others.begin() + p);
+        stable_sort(others.begin(), others.end(), [&](int a, int b)
+                    { return points.distance(p, a) < points.distance(p, b); });
+        for (int i = 0; i < k; i++)
+        {
+            REQUIRE(lists.distances[p * k + i] == Catch::Approx(points.distance(p, others[i])));
+        }
+    }
+}
+
+TEST_CASE("K-NN Graph: Missing Neighbours Are Left Empty", "[knn]")
+{
+    PointCloud points(2);
+    points.addPoint({0, 0});
+    points.addPoint({1, 0});
+    points.addPoint({3, 0});
+    KnnLists lists = knn_brute_force(points, 4);
+    REQUIRE(lists.ids[0] == 1);
+    REQUIRE(lists.ids[1] == 2);
+    REQUIRE(lists.ids[2] == -1);
+
+    Graph graph = knnGraph(lists);
+    REQUIRE(graph.edgeCount() == 3);
+}
+
+TEST_CASE("K-NN Graph: NN-Descent Recall and Thread Independence", "[knn]")
+{
+    PointCloud points = clusteredPoints(3000, 12, 20, 5);
+    int k = 10;
+    KnnLists exact = knn_brute_force(points, k);
+    ThreadPool single(1), several(4);
+    KnnLists approximate = knn_descent(points, k, 7, 12, single);
+    REQUIRE(knnRecall(approximate, exact) > 0.9);
+    REQUIRE(knnRecall(exact, exact) == 1.0);
+
+    KnnLists again = knn_descent(points, k, 7, 12, several);
+    REQUIRE(again.ids == approximate.ids);
+}
+
+TEST_CASE("K-NN Graph: One Edge per Neighbour Pair", "[knn]")
+{
+    PointCloud points = clusteredPoints(400, 3, 4, 9);
+    KnnLists lists = knn_brute_force(points, 5);
+    Graph graph = knnGraph(lists, 100);
+
+    // Every listed pair is an edge, and no pair is there twice
+    set<pair<int, int>> pairs;
+    for (int u = 0; u < graph.vertNumber(); u++)
+    {
+        for (const auto &[v, weight] : graph.adjList[u])
+        {
+            REQUIRE(pairs.insert({u, v}).second);
+        }
+    }
+    for (int p = 0; p < lists.size(); p++)
+    {
+        for (int i = 0; i < lists.k; i++)
+        {
+            REQUIRE(pairs.count({p, lists.ids[p * lists.k + i]}) == 1);
+        }
+    }
+
+    MST mst = kruskal_mst(graph);
+    UnionFind unionFind(graph.vertNumber());
+    for (const auto &edge : mst.edges)
+    {
+        REQUIRE(unionFind.find(edge.src) != unionFind.find(edge.dest));
+        unionFind.merge(edge.src, edge.dest);
+    }
+}
@@ -0,0 +1,111 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <random>
+#include <vector>
+#include <tuple>
+#include "../src/offline_msf.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/graph.hpp"
+
+using namespace std;
+
+TEST_CASE("Offline MSF: Rollback Union Find", "[offline_msf]")
+{
+    RollbackUnionFind unionFind(5);
+    unionFind.merge(0, 1);
+    size_t point = unionFind.checkpoint();
+    REQUIRE(unionFind.merge(2, 3));
+    REQUIRE(unionFind.merge(1, 3));
+    REQUIRE_FALSE(unionFind.merge(0, 2));
+    REQUIRE(unionFind.find(0) == unionFind.find(3));
+
+    unionFind.rollback(point);
+    REQUIRE(unionFind.find(0) == unionFind.find(1));
+    REQUIRE(unionFind.find(2) != unionFind.find(3));
+    REQUIRE(unionFind.find(1) != unionFind.find(2));
+    REQUIRE(unionFind.checkpoint() == point);
+}
+
+TEST_CASE("Offline MSF: Matches Recomputation After Every Step", "[offline_msf]")
+{
+    int verts = 60;
+    mt19937 random(21);
+    uniform_int_distribution<int> vertex(0, verts - 1), weight(-10, 40);
+    vector<Graph::Edge> initial;
+    for (int i = 0; i < 80; i++)
+    {
+        initial.emplace_back(vertex(random), vertex(random), weight(random));
+    }
+
+    // Several updates share a time, and deletions of missing edges happen too
+    vector<EdgeUpdate> updates;
+    long long time = 0;
+    for (int i = 0; i < 1500; i++)
+    {
+        if (random() % 3 == 0)
+        {
+            time += 1 + random() % 5;
+        }
+        bool insert = random() % 100 < 55;
+        updates.push_back({insert, vertex(random), vertex(random), weight(random), time});
+    }
+    ForestTimeline timeline = offline_msf(verts, initial, updates);
+
+    // Replay with the same rules, the last inserted edge between two endpoints is the one deleted
+    vector<tuple<int, int, int>> live;
+    for (const auto &edge : initial)
+    {
+        if (edge.src != edge.dest)
+        {
+            live.emplace_back(edge.src, edge.dest, edge.weight);
+        }
+    }
+    size_t step = 0;
+    for (size_t i = 0; i < updates.size(); i++)
+    {
+        const EdgeUpdate &update = updates[i];
+        if (update.u != update.v && update.insert)
+        {
+            live.emplace_back(update.u, update.v, update.weight);
+        }
+        else if (update.u != update.v)
+        {
+            for (size_t j = live.size(); j-- > 0;)
+            {
+                auto [u, v, w] = live[j];
+                if ((u == update.u && v == update.v) || (u == update.v && v == update.u))
+                {
+                    live.erase(live.begin() + j);
+                    break;
+                }
+            }
+        }
+        if (i + 1 == updates.size() || updates[i + 1].time != update.time)
+        {
+            Graph graph(verts);
+            for (const auto &[u, v, w] : live)
+            {
+                graph.addEdge(u, v, w);
+            }
+            MST expected = kruskal_mst(graph);
+            REQUIRE(step < timeline.steps.size());
+            REQUIRE(timeline.steps[step].time == update.time);
+            REQUIRE(timeline.steps[step].weight == expected.totalWeight);
+            REQUIRE(timeline.steps[step].edges == static_cast<int>(expected.edges.size()));
+            step++;
+        }
+    }
+    REQUIRE(step == timeline.steps.size());
+}
+
+TEST_CASE("Offline MSF: Edges Inserted and Deleted in One Step", "[offline_msf]")
+{
+    vector<EdgeUpdate> updates{{true, 0, 1, 5, 0}, {true, 1, 2, 1, 1}, {false, 1, 2, 0, 1}, {true, 0, 2, 3, 2}};
+    ForestTimeline timeline = offline_msf(3, {}, updates);
+    REQUIRE(timeline.steps.size() == 3);
+    REQUIRE(timeline.steps[0].weight == 5);
+    REQUIRE(timeline.steps[1].weight == 5);
+    REQUIRE(timeline.steps[1].edges == 1);
+    REQUIRE(timeline.steps[2].weight == 8);
+    REQUIRE(offline_msf(3, {}, {}).steps.empty());
+}
@@ -0,0 +1,81 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <cstdlib>
+#include "../src/parallel_boruvka.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/graph.hpp"
+
+using namespace std;
+
+TEST_CASE("Parallel Boruvka: Dense Graph", "[parallel_boruvka_mst]")
+{
+    Graph graph(10);
+    graph.addEdge(0, 1, 3);
+    graph.addEdge(0, 2, 2);
+    graph.addEdge(0, 3, 1);
+    graph.addEdge(0, 4, 8);
+    graph.addEdge(0, 6, 2);
+    graph.addEdge(0, 7, 7);
+    graph.addEdge(0, 8, 4);
+    graph.addEdge(1, 2, 5);
+    graph.addEdge(1, 3, 2);
+    graph.addEdge(1, 4, 4);
+    graph.addEdge(1, 5, 1);
+    graph.addEdge(1, 6, 3);
+    graph.addEdge(1, 7, 8);
+    graph.addEdge(1, 8, 9);
+    graph.addEdge(1, 9, 3);
+    graph.addEdge(2, 4, 5);
+    graph.addEdge(2, 5, 10);
+    graph.addEdge(2, 7, 7);
+    graph.addEdge(2, 8, 9);
+    graph.addEdge(2, 9, 1);
+    graph.addEdge(3, 4, 9);
+    graph.addEdge(3, 5, 1);
+    graph.addEdge(3, 7, 10);
+    graph.addEdge(3, 8, 7);
+    graph.addEdge(3, 9, 5);
+    graph.addEdge(4, 5, 7);
+    graph.addEdge(4, 6, 4);
+    graph.addEdge(4, 7, 9);
+    graph.addEdge(4, 8, 10);
+    graph.addEdge(4, 9, 3);
+    graph.addEdge(5, 6, 3);
+    graph.addEdge(5, 8, 8);
+    graph.addEdge(5, 9, 2);
+    graph.addEdge(6, 7, 10);
+
+    ThreadPool pool(4);
+    auto mst = parallel_boruvka_mst(graph, pool);
+    REQUIRE(mst.totalWeight == 22);
+    REQUIRE(mst.edges.size() == 9);
+}
+
+TEST_CASE("Parallel Boruvka: Matches Kruskal on Skewed Graphs", "[parallel_boruvka_mst]")
+{
+    for (int threads : {1, 3, 8})
+    {
+        ThreadPool pool(threads);
+        for (int seed = 0; seed < 4; seed++)
+        {
+            // A few hub vertices take most of the edges, and the narrow weights give lots of ties
+            srand(seed);
+            Graph graph(5000);
+            for (int i = 0; i < 20000; i++)
+            {
+                int u = rand() % 4 == 0 ? rand() % 5000 : rand() % 10;
+                int v = rand() % 5000;
+                if (u != v)
+                {
+                    graph.addEdge(u, v, 1 + rand() % 16);
+                }
+            }
+
+            MST expected = kruskal_mst(graph);
+            MST mst = parallel_boruvka_mst(graph, pool);
+            INFO("threads " << threads << ", seed " << seed);
+            REQUIRE(mst.totalWeight == expected.totalWeight);
+            REQUIRE(mst.edges.size() == expected.edges.size());
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <cstdlib>
+#include "../src/parallel_prim.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/graph.hpp"
+
+using namespace std;
+
+TEST_CASE("Parallel Prim: Sparse Graph", "[parallel_prim_mst]")
+{
+    Graph graph(10);
+    graph.addEdge(0, 9, 9);
+    graph.addEdge(0, 8, 8);
+    graph.addEdge(0, 2, 8);
+    graph.addEdge(1, 7, 6);
+    graph.addEdge(1, 5, 4);
+    graph.addEdge(2, 6, 10);
+    graph.addEdge(2, 3, 2);
+    graph.addEdge(2, 5, 5);
+    graph.addEdge(2, 7, 6);
+    graph.addEdge(3, 5, 10);
+    graph.addEdge(3, 7, 10);
+    graph.addEdge(4, 8, 9);
+    graph.addEdge(5, 9, 4);
+    graph.addEdge(6, 7, 4);
+
+    ThreadPool pool(4);
+    auto mst = parallel_prim_mst(graph, pool);
+    REQUIRE(mst.totalWeight == 50);
+    REQUIRE(mst.edges.size() == 9);
+}
+
+TEST_CASE("Parallel Prim: Matches Kruskal on Random Graphs", "[parallel_prim_mst]")
+{
+    for (int threads : {1, 2, 8})
+    {
+        ThreadPool pool(threads);
+        for (int seed = 0; seed < 5; seed++)
+        {
+            // Narrow weights give lots of ties, and some vertices stay disconnected
+            srand(seed);
+            Graph graph(2000);
+            for (int i = 0; i < 6000; i++)
+            {
+                int u = rand() % 2000, v = rand() % 2000;
+                if (u != v)
+                {
+                    graph.addEdge(u, v, 1 + rand() % 20);
+                }
+            }
+
+            MST expected = kruskal_mst(graph);
+            MST mst = parallel_prim_mst(graph, pool);
+            INFO("threads " << threads << ", seed " << seed);
+            REQUIRE(mst.totalWeight == expected.totalWeight);
+            REQUIRE(mst.edges.size() == expected.edges.size());
+        }
+    }
+}
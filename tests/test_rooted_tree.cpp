@@ -0,0 +1,218 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <random>
+#include <vector>
+#include "../src/rooted_tree.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/graph.hpp"
+
+using namespace std;
+
+/**
+ * A random spanning forest with a few trees and lone vertices, and negative weights
+ */
+static MST randomForest(int verts, int edges, unsigned seed)
+{
+    mt19937 random(seed);
+    uniform_int_distribution<int> vertex(0, verts - 1), weight(-20, 100);
+    Graph graph(verts);
+    for (int i = 0; i < edges; i++)
+    {
+        int u = vertex(random), v = vertex(random);
+        if (u != v)
+        {
+            graph.addEdge(u, v, weight(random));
+        }
+    }
+    return kruskal_mst(graph);
+}
+
+/**
+ * The distance from `from` to every vertex of its tree the slow way, by walking the edge list, or INT64_MIN
+ */
+static vector<long long> distancesFrom(int verts, const MST &forest, int from)
+{
+    vector<long long> distance(verts, INT64_MIN);
+    distance[from] = 0;
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (const auto &edge : forest.edges)
+        {
+            for (auto [a, b] : {pair<int, int>{edge.src, edge.dest}, {edge.dest, edge.src}})
+            {
+                if (distance[a] != INT64_MIN && distance[b] == INT64_MIN)
+                {
+                    distance[b] = distance[a] + edge.weight;
+                    changed = true;
+                }
+            }
+        }
+    }
+    return distance;
+}
+
+TEST_CASE("Rooted Tree: Arrays Describe the Same Forest", "[rooted_tree]")
+{
+    int verts = 400;
+    MST forest = randomForest(verts, 380, 3);
+    RootedTree rooted = rootTree(verts, forest, 17);
+    REQUIRE(rooted.roots[0] == 17);
+    REQUIRE(static_cast<int>(rooted.roots.size()) == verts - static_cast<int>(forest.edges.size()));
+
+    for (int v = 0; v < verts; v++)
+    {
+        REQUIRE(rooted.order[rooted.preorder[v]] == v);
+        REQUIRE(rooted.euler[rooted.firstVisit[v]] == v);
+        int p = rooted.parent[v];
+        if (p == -1)
+        {
+            REQUIRE(rooted.treeRoot[v] == v);
+            REQUIRE(rooted.depth[v] == 0);
+            continue;
+        }
+        const Graph::Edge &edge = forest.edges[rooted.parentEdge[v]];
+        REQUIRE(((edge.src == v && edge.dest == p) || (edge.src == p && edge.dest == v)));
+        REQUIRE(rooted.parentWeight[v] == edge.weight);
+        REQUIRE(rooted.depth[v] == rooted.depth[p] + 1);
+        REQUIRE(rooted.distance[v] == rooted.distance[p] + edge.weight);
+        REQUIRE(rooted.treeRoot[v] == rooted.treeRoot[p]);
+        REQUIRE(rooted.postorder[v] < rooted.postorder[p]);
+        REQUIRE(rooted.preorder[v] > rooted.preorder[p]);
+    }
+
+    // Every child is listed under its parent, and a subtree is its run of the preorder
+    int listed = 0;
+    for (int v = 0; v < verts; v++)
+    {
+        for (int k = rooted.childStart[v]; k < rooted.childStart[v + 1]; k++)
+        {
+            REQUIRE(rooted.parent[rooted.children[k]] == v);
+            listed++;
+        }
+        int size = 0;
+        for (int u = 0; u < verts; u++)
+        {
+            int x = u;
+            while (x != -1 && x != v)
+            {
+                x = rooted.parent[x];
+            }
+            REQUIRE(rooted.isAncestor(v, u) == (x == v));
+            size += x == v ? 1 : 0;
+        }
+        REQUIRE(rooted.subtreeSize[v] == size);
+    }
+    REQUIRE(listed == static_cast<int>(forest.edges.size()));
+
+    // The tour steps along an edge, except where one tree ends and the next begins
+    REQUIRE(rooted.euler.size() == 2 * forest.edges.size() + rooted.roots.size());
+    for (size_t i = 1; i < rooted.euler.size(); i++)
+    {
+        int a = rooted.euler[i - 1], b = rooted.euler[i];
+        REQUIRE((rooted.parent[a] == b || rooted.parent[b] == a || rooted.treeRoot[a] != rooted.treeRoot[b]));
+    }
+}
+
+TEST_CASE("Rooted Tree: Skipping the Orders Keeps the Rest", "[rooted_tree]")
+{
+    int verts = 500;
+    MST forest = randomForest(verts, 470, 8);
+    RootedTree full = rootTree(verts, forest, 5);
+    RootedTree lean = rootTree(verts, forest, 5, false);
+
+    REQUIRE(lean.roots == full.roots);
+    REQUIRE(lean.treeRoot == full.treeRoot);
+    REQUIRE(lean.parent == full.parent);
+    REQUIRE(lean.parentWeight == full.parentWeight);
+    REQUIRE(lean.parentEdge == full.parentEdge);
+    REQUIRE(lean.depth == full.depth);
+    REQUIRE(lean.subtreeSize == full.subtreeSize);
+    REQUIRE(lean.childStart == full.childStart);
+    REQUIRE(lean.children == full.children);
+    REQUIRE(lean.order.empty());
+    REQUIRE(lean.euler.empty());
+
+    // The children of a vertex are in preorder
+    for (int v = 0; v < verts; v++)
+    {
+        for (int k = full.childStart[v] + 1; k < full.childStart[v + 1]; k++)
+        {
+            REQUIRE(full.preorder[full.children[k - 1]] < full.preorder[full.children[k]]);
+        }
+    }
+}
+
+TEST_CASE("Rooted Tree: Queries Match Brute Force", "[rooted_tree]")
+{
+    for (unsigned seed = 1; seed <= 5; seed++)
+    {
+        int verts = 150;
+        MST forest = randomForest(verts, 140, seed);
+        RootedTree rooted = rootTree(verts, forest);
+
+        vector<long long> eccentricity = eccentricities(rooted);
+        long long longest = INT64_MIN;
+        for (int v = 0; v < verts; v++)
+        {
+            vector<long long> distance = distancesFrom(verts, forest, v);
+            long long farthest = *max_element(distance.begin(), distance.end());
+            REQUIRE(eccentricity[v] == farthest);
+            longest = max(longest, farthest);
+        }
+        TreePath diameter = treeDiameter(rooted);
+        REQUIRE(diameter.length == longest);
+        REQUIRE(distancesFrom(verts, forest, diameter.from)[diameter.to] == longest);
+
+        vector<int> centers = treeCenters(rooted);
+        REQUIRE(centers.size() == rooted.roots.size());
+        for (size_t t = 0; t < centers.size(); t++)
+        {
+            REQUIRE(rooted.treeRoot[centers[t]] == rooted.roots[t]);
+            for (int v = 0; v < verts; v++)
+            {
+                if (rooted.treeRoot[v] == rooted.roots[t])
+                {
+                    REQUIRE(eccentricity[centers[t]] <= eccentricity[v]);
+                }
+            }
+        }
+
+        vector<long long> values(verts);
+        for (int v = 0; v < verts; v++)
+        {
+            values[v] = v * 7 - 300;
+        }
+        vector<long long> sums = subtreeSums(rooted, values);
+        for (int v = 0; v < verts; v++)
+        {
+            long long expected = 0;
+            for (int u = 0; u < verts; u++)
+            {
+                expected += rooted.isAncestor(v, u) ? values[u] : 0;
+            }
+            REQUIRE(sums[v] == expected);
+        }
+    }
+}
+
+TEST_CASE("Rooted Tree: Long Path", "[rooted_tree]")
+{
+    int verts = 1000000;
+    MST path;
+    for (int v = 1; v < verts; v++)
+    {
+        path.edges.emplace_back(v - 1, v, 2);
+    }
+    RootedTree rooted = rootTree(verts, path);
+    REQUIRE(rooted.depth[verts - 1] == verts - 1);
+    REQUIRE(rooted.subtreeSize[0] == verts);
+    REQUIRE(rooted.postorder[0] == verts - 1);
+
+    TreePath diameter = treeDiameter(rooted);
+    REQUIRE(diameter.length == 2LL * (verts - 1));
+    REQUIRE(min(diameter.from, diameter.to) == 0);
+    REQUIRE(max(diameter.from, diameter.to) == verts - 1);
+    REQUIRE(treeCenters(rooted) == vector<int>{verts / 2 - 1});
+}
@@ -0,0 +1,134 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <cmath>
+#include <cstdio>
+#include "../src/selector.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/prim.hpp"
+#include "../src/boruvka.hpp"
+#include "../src/graph.hpp"
+#include "test_graphs.hpp"
+
+using namespace std;
+
+TEST_CASE("Selector: Graph Statistics", "[selector]")
+{
+    Graph graph(5);
+    graph.addEdge(0, 1, 7);
+    graph.addEdge(1, 2, -3);
+    graph.addEdge(3, 4, 12);
+
+    GraphStats stats = graphStats(graph, 4);
+    REQUIRE(stats.vertices == 5);
+    REQUIRE(stats.edges == 3);
+    REQUIRE(stats.density == Catch::Approx(0.3));
+    REQUIRE(stats.minWeight == -3);
+    REQUIRE(stats.maxWeight == 12);
+    REQUIRE(stats.threads == 4);
+
+    SECTION("An empty graph has no weight range")
+    {
+        GraphStats empty = graphStats(Graph(3), 0);
+        REQUIRE(empty.edges == 0);
+        REQUIRE(empty.minWeight == 0);
+        REQUIRE(empty.maxWeight == 0);
+        REQUIRE(empty.threads == 1);
+    }
+}
+
+TEST_CASE("Selector: Engines That Can Not Run Are Never Picked", "[selector]")
+{
+    GraphStats stats;
+    stats.vertices = 1000;
+    stats.edges = 5000;
+    stats.maxWeight = 10;
+
+    CostProfile profile;
+    for (const string &engine : CostProfile::engines())
+    {
+        profile.models[engine] = {0, 1.0};
+    }
+    // Make the bucket queue look free
+    profile.models["prim-bucket"] = {0, 1e-9};
+    REQUIRE(selectAlgorithm(stats, profile) == "prim-bucket");
+
+    stats.minWeight = -1;
+    REQUIRE(engineWork("prim-bucket", stats) < 0);
+    REQUIRE(isinf(profile.predict("prim-bucket", stats)));
+    REQUIRE(selectAlgorithm(stats, profile) != "prim-bucket");
+
+    stats.vertices = 1 << 20;
+    REQUIRE(engineWork("prim-dense", stats) < 0);
+}
+
+TEST_CASE("Selector: The Default Profile Follows Density", "[selector]")
+{
+    CostProfile profile = CostProfile::defaults();
+
+    GraphStats dense;
+    dense.vertices = 2000;
+    dense.edges = 2000LL * 1999 / 2;
+    dense.maxWeight = 1000000;
+    string denseChoice = selectAlgorithm(dense, profile);
+    REQUIRE((denseChoice == "prim" || denseChoice == "prim-dense"));
+
+    // Small integer weights make the bucket queue the cheapest Prim
+    GraphStats smallWeights = dense;
+    smallWeights.vertices = 100000;
+    smallWeights.edges = 400000;
+    smallWeights.maxWeight = 16;
+    REQUIRE(selectAlgorithm(smallWeights, profile) == "prim-bucket");
+}
+
+TEST_CASE("Selector: Profiles Round Trip Through a File", "[selector]")
+{
+    const string path = "selector_test_profile.txt";
+    CostProfile profile = CostProfile::defaults();
+    profile.models["kruskal"] = {12.5, 0.25};
+    REQUIRE(profile.save(path));
+
+    bool found = false;
+    CostProfile loaded = CostProfile::load(path, &found);
+    REQUIRE(found);
+    REQUIRE(loaded.models["kruskal"].fixed == Catch::Approx(12.5));
+    REQUIRE(loaded.models["kruskal"].perWork == Catch::Approx(0.25));
+    REQUIRE(loaded.models.size() == profile.models.size());
+    remove(path.c_str());
+
+    SECTION("A missing file gives the defaults")
+    {
+        CostProfile missing = CostProfile::load("does_not_exist.profile", &found);
+        REQUIRE_FALSE(found);
+        REQUIRE(missing.models["prim"].perWork == CostProfile::defaults().models["prim"].perWork);
+    }
+}
+
+TEST_CASE("Selector: Calibration Fits Every Engine", "[selector]")
+{
+    int runs = 0;
+    auto run = [&](const string &engine, Graph &graph)
+    {
+        runs++;
+        if (engine == "kruskal")
+            return kruskal_mst(graph);
+        if (engine == "boruvka" || engine == "boruvka-parallel")
+            return boruvka_mst(graph);
+        if (engine == "prim-bucket")
+            return prim_mst_queue<BucketQueue>(graph);
+        return prim_mst(graph);
+    };
+    CostProfile profile = calibrateProfile(run, 1, 3, 0.02);
+    REQUIRE(runs > 0);
+    for (const string &engine : CostProfile::engines())
+    {
+        REQUIRE(profile.models[engine].perWork > 0);
+        REQUIRE(profile.models[engine].fixed >= 0);
+    }
+
+    SECTION("The picked engine gives a minimum spanning tree")
+    {
+        Graph graph = randomGraph(500, 3000, 50, 11);
+        string engine = selectAlgorithm(graphStats(graph, 1), profile);
+        REQUIRE(run(engine, graph).totalWeight == kruskal_mst(graph).totalWeight);
+    }
+}
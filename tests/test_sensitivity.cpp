@@ -0,0 +1,166 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <random>
+#include <vector>
+#include <climits>
+#include "../src/sensitivity.hpp"
+#include "../src/bottleneck.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/graph.hpp"
+
+using namespace std;
+
+/**
+ * The MST weight of the graph without one of its edges, the slow way, or INT_MIN if that splits a component
+ */
+static long long weightWithout(int verts, const vector<Graph::Edge> &edges, const Graph::Edge &removed, int components)
+{
+    Graph graph(verts);
+    bool skipped = false;
+    for (const auto &edge : edges)
+    {
+        if (!skipped && edge == removed)
+        {
+            skipped = true;
+            continue;
+        }
+        graph.addEdge(edge.src, edge.dest, edge.weight);
+    }
+    MST mst = kruskal_mst(graph);
+    if (verts - static_cast<int>(mst.edges.size()) != components)
+    {
+        return INT_MIN;
+    }
+    long long total = 0;
+    for (const auto &edge : mst.edges)
+    {
+        total += edge.weight;
+    }
+    return total;
+}
+
+TEST_CASE("Sensitivity: Matches Kruskal Without Each Tree Edge", "[sensitivity]")
+{
+    int verts = 80;
+    mt19937 random(5);
+    uniform_int_distribution<int> vertex(0, verts - 1), weight(-50, 50);
+    Graph graph(verts);
+    vector<Graph::Edge> edges;
+    // Sparse, so there are bridges and several components
+    for (int i = 0; i < 110; i++)
+    {
+        int u = vertex(random), v = vertex(random), w = weight(random);
+        if (u != v)
+        {
+            graph.addEdge(u, v, w);
+            edges.emplace_back(u, v, w);
+        }
+    }
+    MST mst = kruskal_mst(graph);
+    long long total = 0;
+    for (const auto &edge : mst.edges)
+    {
+        total += edge.weight;
+    }
+    int components = verts - mst.edges.size();
+
+    EdgeSensitivity sensitivity = edge_sensitivity(graph, mst);
+    REQUIRE(sensitivity.treeEdges.size() == mst.edges.size());
+    REQUIRE(sensitivity.treeEdges.size() + sensitivity.nonTreeEdges.size() == edges.size());
+    REQUIRE(sensitivity.bridges() > 0);
+    for (const auto &tree : sensitivity.treeEdges)
+    {
+        long long without = weightWithout(verts, edges, tree.edge, components);
+        if (tree.replacement == -1)
+        {
+            REQUIRE(without == INT_MIN);
+        }
+        else
+        {
+            REQUIRE(without == total - tree.edge.weight + sensitivity.nonTreeEdges[tree.replacement].edge.weight);
+        }
+    }
+
+    PathMaxIndex index(verts, mst);
+    for (const auto &nonTree : sensitivity.nonTreeEdges)
+    {
+        REQUIRE(nonTree.pathMax == index.query(nonTree.edge.src, nonTree.edge.dest));
+        REQUIRE(nonTree.pathMax <= nonTree.edge.weight);
+    }
+    for (size_t i = 1; i < sensitivity.nonTreeEdges.size(); i++)
+    {
+        REQUIRE(sensitivity.nonTreeEdges[i - 1].edge.weight <= sensitivity.nonTreeEdges[i].edge.weight);
+    }
+}
+
+TEST_CASE("Sensitivity: Cycle Covered by One Chord", "[sensitivity]")
+{
+    // A path 0-1-2-3-4 with a heavy chord from 0 to 4, and a pendant vertex 5
+    Graph graph(6);
+    for (int v = 1; v < 5; v++)
+    {
+        graph.addEdge(v - 1, v, v);
+    }
+    graph.addEdge(0, 4, 10);
+    graph.addEdge(4, 5, 7);
+    MST mst = kruskal_mst(graph);
+    EdgeSensitivity sensitivity = edge_sensitivity(graph, mst);
+
+    REQUIRE(sensitivity.nonTreeEdges.size() == 1);
+    REQUIRE(sensitivity.nonTreeEdges[0].edge == Graph::Edge(0, 4, 10));
+    REQUIRE(sensitivity.nonTreeEdges[0].pathMax == 4);
+    REQUIRE(sensitivity.bridges() == 1);
+    for (const auto &tree : sensitivity.treeEdges)
+    {
+        REQUIRE(tree.replacement == (tree.edge == Graph::Edge(4, 5, 7) ? -1 : 0));
+    }
+}
+
+TEST_CASE("Sensitivity: Out of Range Tree Edges", "[sensitivity]")
+{
+    Graph graph(3);
+    graph.addEdge(0, 1, 1);
+    graph.addEdge(1, 2, 2);
+    graph.addEdge(0, 2, 3);
+    MST mst = kruskal_mst(graph);
+    mst.edges.emplace_back(2, 900000, 4);
+    mst.edges.emplace_back(-3, 1, 5);
+    EdgeSensitivity sensitivity = edge_sensitivity(graph, mst);
+
+    REQUIRE(sensitivity.treeEdges.size() == 4);
+    REQUIRE(sensitivity.nonTreeEdges.size() == 1);
+    REQUIRE(sensitivity.nonTreeEdges[0].pathMax == 2);
+    REQUIRE(sensitivity.treeEdges[2].replacement == -1);
+    REQUIRE(sensitivity.treeEdges[3].replacement == -1);
+}
+
+TEST_CASE("Sensitivity: Long Path", "[sensitivity]")
+{
+    int verts = 200000;
+    Graph graph(verts);
+    for (int v = 1; v < verts; v++)
+    {
+        graph.addEdge(v - 1, v, 1);
+    }
+    // Chords from the start, heavier the further they reach, so each covers the part the lighter ones do not
+    for (int v = 1000; v < verts; v += 1000)
+    {
+        graph.addEdge(0, v, v);
+    }
+    EdgeSensitivity sensitivity = edge_sensitivity(graph, kruskal_mst(graph));
+    // The edges past the last chord have no replacement
+    REQUIRE(sensitivity.bridges() == 999);
+    for (const auto &tree : sensitivity.treeEdges)
+    {
+        int far = max(tree.edge.src, tree.edge.dest);
+        if (far <= 199000)
+        {
+            REQUIRE(tree.replacement != -1);
+            REQUIRE(sensitivity.nonTreeEdges[tree.replacement].edge.weight == (far + 999) / 1000 * 1000);
+        }
+        else
+        {
+            REQUIRE(tree.replacement == -1);
+        }
+    }
+}
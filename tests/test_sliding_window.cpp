@@ -0,0 +1,104 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <random>
+#include <vector>
+#include "../src/sliding_window.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/graph.hpp"
+
+using namespace std;
+
+TEST_CASE("Sliding Window MSF: Matches Recomputation Over the Live Edges", "[sliding_window]")
+{
+    int verts = 80;
+    long long window = 50;
+    mt19937 random(5);
+    uniform_int_distribution<int> vertex(0, verts - 1), weight(-30, 100);
+    SlidingWindowMSF sliding(verts, window);
+    vector<EdgeUpdate> stream;
+    long long time = 0;
+
+    for (int i = 1; i <= 4000; i++)
+    {
+        // Several edges share a timestamp, and some gaps empty most of the window
+        time += random() % 4 == 0 ? 1 : 0;
+        if (i % 1000 == 0)
+        {
+            time += 40;
+        }
+        EdgeUpdate edge{true, vertex(random), vertex(random), weight(random), time};
+        REQUIRE(sliding.addEdge(edge.time, edge.u, edge.v, edge.weight) == (edge.u != edge.v));
+        stream.push_back(edge);
+
+        if (i % 97 == 0)
+        {
+            Graph graph(verts);
+            int inWindow = 0;
+            for (const auto &past : stream)
+            {
+                if (past.time > time - window && past.u != past.v)
+                {
+                    graph.addEdge(past.u, past.v, past.weight);
+                    inWindow++;
+                }
+            }
+            MST expected = kruskal_mst(graph);
+            REQUIRE(sliding.totalWeight() == expected.totalWeight);
+            REQUIRE(sliding.edgeCount() == static_cast<int>(expected.edges.size()));
+            REQUIRE(sliding.windowEdges() == inWindow);
+        }
+    }
+}
+
+TEST_CASE("Sliding Window MSF: Small Dense Streams With Many Ties", "[sliding_window]")
+{
+    mt19937 random(3);
+    for (int run = 0; run < 4000; run++)
+    {
+        int verts = 3 + run % 4;
+        long long window = 2 + run % 6;
+        uniform_int_distribution<int> vertex(0, verts - 1), weight(1, 3);
+        SlidingWindowMSF sliding(verts, window, run);
+        vector<EdgeUpdate> stream;
+        long long time = 0;
+
+        for (int i = 0; i < 100; i++)
+        {
+            time += random() % 3 == 0 ? 1 : 0;
+            EdgeUpdate edge{true, vertex(random), vertex(random), weight(random), time};
+            sliding.addEdge(edge.time, edge.u, edge.v, edge.weight);
+            stream.push_back(edge);
+
+            Graph graph(verts);
+            for (const auto &past : stream)
+            {
+                if (past.time > time - window && past.u != past.v)
+                {
+                    graph.addEdge(past.u, past.v, past.weight);
+                }
+            }
+            MST expected = kruskal_mst(graph);
+            REQUIRE(sliding.totalWeight() == expected.totalWeight);
+            REQUIRE(sliding.edgeCount() == static_cast<int>(expected.edges.size()));
+        }
+    }
+}
+
+TEST_CASE("Sliding Window MSF: Moving the Clock Expires Edges", "[sliding_window]")
+{
+    SlidingWindowMSF sliding(3, 10);
+    REQUIRE(sliding.addEdge(0, 0, 1, 4));
+    REQUIRE(sliding.addEdge(5, 1, 2, 6));
+    REQUIRE(sliding.addEdge(6, 0, 2, 1));
+    REQUIRE(sliding.totalWeight() == 5);
+    REQUIRE_FALSE(sliding.addEdge(2, 0, 1, 1));
+
+    sliding.advance(10);
+    REQUIRE(sliding.totalWeight() == 7);
+    REQUIRE(sliding.windowEdges() == 2);
+    sliding.advance(3);
+    REQUIRE(sliding.time() == 10);
+    sliding.advance(16);
+    REQUIRE(sliding.edgeCount() == 0);
+    REQUIRE(sliding.mst().edges.empty());
+}
@@ -0,0 +1,94 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <random>
+#include <vector>
+#include <algorithm>
+#include "../src/sweep.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/graph.hpp"
+
+using namespace std;
+
+/**
+ * The connectivity at a threshold, recomputed from scratch.
+ */
+static ConnectivityCurve::Point bruteForce(const Graph &graph, int threshold)
+{
+    int n = graph.vertNumber();
+    UnionFind components(n);
+    for (int u = 0; u < n; u++)
+    {
+        for (const auto &[v, weight] : graph.adjList[u])
+        {
+            if (weight <= threshold && components.find(u) != components.find(v))
+            {
+                components.merge(u, v);
+            }
+        }
+    }
+    vector<int> sizes(n, 0);
+    for (int v = 0; v < n; v++)
+    {
+        sizes[components.find(v)]++;
+    }
+    int count = n - count_if(sizes.begin(), sizes.end(), [](int size)
+                             { return size == 0; });
+    return {threshold, count, n > 0 ? *max_element(sizes.begin(), sizes.end()) : 0};
+}
+
+TEST_CASE("Threshold Sweep: Matches Recomputation at Every Threshold", "[sweep]")
+{
+    mt19937 random(6);
+    uniform_int_distribution<int> vertex(0, 199), weight(-20, 60);
+    Graph graph(200);
+    for (int i = 0; i < 260; i++)
+    {
+        int u = vertex(random), v = vertex(random);
+        if (u != v)
+        {
+            graph.addEdge(u, v, weight(random));
+        }
+    }
+    ConnectivityCurve curve = threshold_sweep(graph);
+
+    for (int threshold = -25; threshold <= 65; threshold++)
+    {
+        ConnectivityCurve::Point expected = bruteForce(graph, threshold);
+        ConnectivityCurve::Point found = curve.at(threshold);
+        REQUIRE(found.components == expected.components);
+        REQUIRE(found.largest == expected.largest);
+        REQUIRE(found.weight <= threshold);
+    }
+}
+
+TEST_CASE("Threshold Sweep: One Point per Joining Weight", "[sweep]")
+{
+    Graph graph(5);
+    graph.addEdge(0, 1, 3);
+    graph.addEdge(1, 2, 3);
+    graph.addEdge(0, 2, 4);
+    graph.addEdge(3, 4, 7);
+    graph.addEdge(2, 3, 9);
+    graph.addEdge(0, 4, 12);
+    ConnectivityCurve curve = threshold_sweep(graph);
+
+    REQUIRE(curve.points.size() == 3);
+    REQUIRE(curve.points[0].weight == 3);
+    REQUIRE(curve.points[0].components == 3);
+    REQUIRE(curve.points[0].largest == 3);
+    REQUIRE(curve.points[1].weight == 7);
+    REQUIRE(curve.points[2].weight == 9);
+    REQUIRE(curve.points[2].components == 1);
+    REQUIRE(curve.at(100).largest == 5);
+    REQUIRE(curve.at(2).components == 5);
+    REQUIRE(curve.at(2).largest == 1);
+}
+
+TEST_CASE("Threshold Sweep: Empty Graph", "[sweep]")
+{
+    Graph graph(0);
+    ConnectivityCurve curve = threshold_sweep(graph);
+    REQUIRE(curve.points.empty());
+    REQUIRE(curve.at(5).components == 0);
+    REQUIRE(curve.at(5).largest == 0);
+}
@@ -0,0 +1,150 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <atomic>
+#include <vector>
+#include <numeric>
+#include <string>
+#include "../src/thread_pool.hpp"
+#include "../src/kruskal.hpp"
+
+using namespace std;
+
+TEST_CASE("Thread Pool: Parallel For", "[thread_pool]")
+{
+    ThreadPool pool(4);
+
+    SECTION("Every index runs exactly once")
+    {
+        for (int grain : {1, 7, 1000})
+        {
+            vector<atomic<int>> hits(10000);
+            pool.parallelFor(0, 10000, [&](int i)
+                             { hits[i]++; }, grain);
+            for (auto &hit : hits)
+            {
+                REQUIRE(hit == 1);
+            }
+        }
+    }
+
+    SECTION("Loops can be nested inside tasks")
+    {
+        atomic<long long> total(0);
+        pool.parallelFor(0, 50, [&](int i)
+                         { pool.parallelFor(0, 100, [&](int j)
+                                            { total += i * j; }); });
+        REQUIRE(total == 1225LL * 4950LL);
+    }
+
+    SECTION("Submitted tasks finish before wait returns")
+    {
+        atomic<int> done(0);
+        for (int i = 0; i < 100; i++)
+        {
+            pool.submit([&]
+                        { done++; });
+        }
+        pool.wait();
+        REQUIRE(done == 100);
+    }
+}
+
+TEST_CASE("Thread Pool: Exclusive Scan", "[thread_pool]")
+{
+    ThreadPool pool(3);
+    for (int n : {0, 1, 5000, 100003})
+    {
+        vector<int> values(n);
+        for (int i = 0; i < n; i++)
+        {
+            values[i] = i % 3;
+        }
+        vector<int> expected(n);
+        exclusive_scan(values.begin(), values.end(), expected.begin(), 0);
+        int total = accumulate(values.begin(), values.end(), 0);
+
+        REQUIRE(exclusiveScan(pool, values) == total);
+        REQUIRE(values == expected);
+    }
+}
+
+TEST_CASE("Thread Pool: Parallel Reduce", "[thread_pool]")
+{
+    ThreadPool pool(4);
+
+    SECTION("Sums match the sequential sum for every grain")
+    {
+        for (int n : {0, 1, 7, 1000, 100003})
+        {
+            for (int grain : {1, 64, 1 << 20})
+            {
+                long long expected = 0;
+                for (int i = 0; i < n; i++)
+                {
+                    expected += i % 7;
+                }
+                long long sum = parallelReduce(
+                    pool, 0, n, 0LL, [](int i)
+                    { return static_cast<long long>(i % 7); },
+                    [](long long a, long long b)
+                    { return a + b; },
+                    grain);
+                REQUIRE(sum == expected);
+            }
+        }
+    }
+
+    SECTION("Non commutative reductions keep the index order")
+    {
+        // Concatenating digits is associative but not commutative
+        string digits = parallelReduce(
+            pool, 0, 500, string(), [](int i)
+            { return to_string(i % 10); },
+            [](const string &a, const string &b)
+            { return a + b; });
+        string expected;
+        for (int i = 0; i < 500; i++)
+        {
+            expected += to_string(i % 10);
+        }
+        REQUIRE(digits == expected);
+    }
+}
+
+TEST_CASE("Thread Pool: Shared Pool", "[thread_pool]")
+{
+    sharedPoolThreads() = 3;
+    ThreadPool &pool = sharedPool();
+    REQUIRE(pool.size() == 3);
+    REQUIRE(&sharedPool() == &pool);
+
+    int max = parallelReduce(
+        pool, 0, 10000, 0, [](int i)
+        { return (i * 7919) % 10007; },
+        [](int a, int b)
+        { return std::max(a, b); },
+        128);
+    REQUIRE(max == 10006);
+}
+
+TEST_CASE("Concurrent Union Find: Parallel Merges", "[thread_pool]")
+{
+    ThreadPool pool(4);
+    ConcurrentUnionFind sets(10000);
+    atomic<int> successes(0);
+
+    // Every merge joins i with i + 1, from both directions at once
+    pool.parallelFor(0, 20000, [&](int i)
+                     {
+                         int v = i / 2;
+                         if (v + 1 < 10000 && (i % 2 == 0 ? sets.merge(v, v + 1) : sets.merge(v + 1, v)))
+                         {
+                             successes++;
+                         } });
+
+    REQUIRE(successes == 9999);
+    for (int v = 0; v < 10000; v++)
+    {
+        REQUIRE(sets.find(v) == 0);
+    }
+}
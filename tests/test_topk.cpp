@@ -0,0 +1,127 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <random>
+#include <vector>
+#include "../src/topk.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/graph.hpp"
+
+using namespace std;
+
+/**
+ * The weight of every spanning forest of a small graph, the slow way, by trying every subset of its edges
+ */
+static vector<long long> allForestWeights(int verts, const vector<Graph::Edge> &edges, int treeSize)
+{
+    vector<long long> weights;
+    int m = edges.size();
+    for (int mask = 0; mask < (1 << m); mask++)
+    {
+        if (__builtin_popcount(mask) != treeSize)
+        {
+            continue;
+        }
+        UnionFind unionFind(verts);
+        bool forest = true;
+        long long weight = 0;
+        for (int i = 0; i < m && forest; i++)
+        {
+            if (mask & (1 << i))
+            {
+                forest = unionFind.find(edges[i].src) != unionFind.find(edges[i].dest);
+                unionFind.merge(edges[i].src, edges[i].dest);
+                weight += edges[i].weight;
+            }
+        }
+        if (forest)
+        {
+            weights.push_back(weight);
+        }
+    }
+    sort(weights.begin(), weights.end());
+    return weights;
+}
+
+TEST_CASE("Top-K Spanning Trees: Every Tree Once in Increasing Weight", "[topk]")
+{
+    for (unsigned seed = 1; seed <= 6; seed++)
+    {
+        int verts = 7;
+        mt19937 random(seed);
+        uniform_int_distribution<int> vertex(0, verts - 1), weight(seed % 2 ? 1 : -20, seed % 2 ? 4 : 20);
+        Graph graph(verts);
+        vector<Graph::Edge> edges;
+        while (edges.size() < 13)
+        {
+            int u = vertex(random), v = vertex(random), w = weight(random);
+            // Parallel edges are kept, they make distinct trees
+            if (u != v)
+            {
+                graph.addEdge(u, v, w);
+                edges.emplace_back(min(u, v), max(u, v), w);
+            }
+        }
+        int treeSize = kruskal_mst(graph).edges.size();
+        vector<long long> expected = allForestWeights(verts, edges, treeSize);
+
+        SpanningTreeEnumerator enumerator(graph);
+        RankedTree tree;
+        vector<long long> weights;
+        while (enumerator.next(tree))
+        {
+            REQUIRE(tree.rank == static_cast<int>(weights.size()));
+            REQUIRE(static_cast<int>(tree.tree.edges.size()) == treeSize);
+            long long total = 0;
+            for (const auto &edge : tree.tree.edges)
+            {
+                total += edge.weight;
+            }
+            REQUIRE(total == tree.weight);
+            REQUIRE(tree.parent < tree.rank);
+            if (tree.rank > 0)
+            {
+                REQUIRE(tree.weight - weights[tree.parent] == tree.added.weight - tree.removed.weight);
+            }
+            weights.push_back(total);
+        }
+        REQUIRE(weights == expected);
+        REQUIRE(enumerator.foundCount() == static_cast<int>(expected.size()));
+        REQUIRE(!enumerator.next(tree));
+    }
+}
+
+TEST_CASE("Top-K Spanning Trees: Second Best Tree", "[topk]")
+{
+    // A square with a diagonal: the MST is 0-1, 1-2, 2-3
+    Graph graph(4);
+    graph.addEdge(0, 1, 1);
+    graph.addEdge(1, 2, 2);
+    graph.addEdge(2, 3, 3);
+    graph.addEdge(3, 0, 10);
+    graph.addEdge(0, 2, 4);
+    SpanningTreeEnumerator enumerator(graph);
+    RankedTree tree;
+    REQUIRE(enumerator.next(tree));
+    REQUIRE(tree.weight == 6);
+    REQUIRE(tree.parent == -1);
+    REQUIRE(enumerator.next(tree));
+    REQUIRE(tree.weight == 8);
+    REQUIRE(tree.parent == 0);
+    REQUIRE(tree.added == Graph::Edge(0, 2, 4));
+    REQUIRE(tree.removed == Graph::Edge(1, 2, 2));
+}
+
+TEST_CASE("Top-K Spanning Trees: Tree Graph", "[topk]")
+{
+    Graph graph(5);
+    for (int v = 1; v < 5; v++)
+    {
+        graph.addEdge(v - 1, v, v);
+    }
+    graph.addEdge(3, 3, 1);
+    SpanningTreeEnumerator enumerator(graph);
+    RankedTree tree;
+    REQUIRE(enumerator.next(tree));
+    REQUIRE(tree.weight == 10);
+    REQUIRE(!enumerator.next(tree));
+}
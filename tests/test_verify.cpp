@@ -0,0 +1,144 @@
+#define CATCH_CONFIG_MAIN
+#include "Catch2.hpp"
+#include <vector>
+#include "../src/verify.hpp"
+#include "../src/kruskal.hpp"
+#include "../src/prim.hpp"
+#include "../src/boruvka.hpp"
+#include "../src/kkt.hpp"
+#include "../src/graph.hpp"
+#include "test_graphs.hpp"
+
+using namespace std;
+
+TEST_CASE("MST Verification: Every Engine Passes", "[verify]")
+{
+    for (int maxWeight : {5, 1000000})
+    {
+        Graph graph = randomGraph(500, 1500, maxWeight, maxWeight);
+        for (const MST &tree : {kruskal_mst(graph), boruvka_mst(graph), kkt_mst(graph)})
+        {
+            VerifyReport report = verify_mst(graph, tree);
+            REQUIRE(report.valid());
+            REQUIRE(report.checkedEdges == graph.edgeCount() - report.treeEdges);
+        }
+    }
+    // Prim's algorithm needs a connected graph
+    Graph connected = randomGraph(200, 4000, 50, 3);
+    for (int v = 1; v < 200; v++)
+    {
+        connected.addEdge(v - 1, v, 51);
+    }
+    REQUIRE(verify_mst(connected, prim_mst(connected)).valid());
+}
+
+TEST_CASE("MST Verification: Heavier Edge Is Caught", "[verify]")
+{
+    Graph graph = randomGraph(400, 3000, 1000000, 9);
+    MST tree = kruskal_mst(graph);
+    VerifyReport clean = verify_mst(graph, tree);
+    REQUIRE(clean.valid());
+
+    // Swap a tree edge for a heavier non-tree edge on its cycle, found by brute force
+    for (size_t t = 0; t < tree.edges.size(); t++)
+    {
+        MST rest;
+        for (size_t i = 0; i < tree.edges.size(); i++)
+        {
+            if (i != t)
+            {
+                rest.edges.push_back(tree.edges[i]);
+            }
+        }
+        UnionFind sides(graph.vertNumber());
+        for (const auto &edge : rest.edges)
+        {
+            sides.merge(edge.src, edge.dest);
+        }
+        for (int u = 0; u < graph.vertNumber(); u++)
+        {
+            for (const auto &[v, w] : graph.adjList[u])
+            {
+                if (w > tree.edges[t].weight && sides.find(u) != sides.find(v))
+                {
+                    rest.edges.emplace_back(u, v, w);
+                    VerifyReport report = verify_mst(graph, rest);
+                    REQUIRE(!report.valid());
+                    REQUIRE(report.missingEdges == 0);
+                    REQUIRE(report.cycleEdges == 0);
+                    REQUIRE(report.unspannedEdges == 0);
+                    REQUIRE(!report.violations.empty());
+                    bool found = false;
+                    for (const auto &violation : report.violations)
+                    {
+                        REQUIRE(violation.pathMax == w);
+                        found = found || violation.edge == tree.edges[t];
+                    }
+                    REQUIRE(found);
+                    return;
+                }
+            }
+        }
+    }
+    FAIL("No tree edge had a heavier replacement");
+}
+
+TEST_CASE("MST Verification: Broken Candidates", "[verify]")
+{
+    Graph graph(5);
+    graph.addEdge(0, 1, 1);
+    graph.addEdge(1, 2, 2);
+    graph.addEdge(2, 0, 3);
+    graph.addEdge(3, 4, 4);
+    graph.addEdge(2, 3, 9);
+
+    MST good;
+    good.edges = {{0, 1, 1}, {2, 1, 2}, {3, 4, 4}, {3, 2, 9}};
+    REQUIRE(verify_mst(graph, good).valid());
+
+    // Wrong weight, so the edge is not in the graph
+    MST missing = good;
+    missing.edges[0].weight = 7;
+    REQUIRE(verify_mst(graph, missing).missingEdges == 1);
+
+    MST cycle = good;
+    cycle.edges.emplace_back(0, 2, 3);
+    REQUIRE(verify_mst(graph, cycle).cycleEdges == 1);
+
+    // Without the bridge, that edge joins two trees of the candidate
+    MST partial = good;
+    partial.edges.pop_back();
+    VerifyReport report = verify_mst(graph, partial);
+    REQUIRE(report.unspannedEdges == 1);
+    REQUIRE(!report.valid());
+
+    MST heavy;
+    heavy.edges = {{0, 1, 1}, {2, 0, 3}, {3, 4, 4}, {3, 2, 9}};
+    report = verify_mst(graph, heavy);
+    REQUIRE(report.violations.size() == 1);
+    REQUIRE(report.violations[0].edge == Graph::Edge(1, 2, 2));
+    REQUIRE(report.violations[0].pathMax == 3);
+}
+
+TEST_CASE("MST Verification: Shallow Boruvka Tree on a Long Path", "[verify]")
+{
+    int verts = 100000;
+    Graph graph(verts);
+    for (int v = 1; v < verts; v++)
+    {
+        graph.addEdge(v - 1, v, (v * 7919) % 1000);
+    }
+    // Chords two apart, each as heavy as the heavier of the two edges it spans, so they only tie
+    for (int v = 2; v < verts; v += 3)
+    {
+        graph.addEdge(v - 2, v, max(((v - 1) * 7919) % 1000, (v * 7919) % 1000));
+    }
+    MST path = kruskal_mst(graph);
+    VerifyReport report = verify_mst(graph, path);
+    REQUIRE(report.valid());
+
+    graph.addEdge(0, verts - 1, -1);
+    report = verify_mst(graph, path);
+    REQUIRE(report.violations.size() == 1);
+    REQUIRE(report.violations[0].pathMax == 999);
+}